@@ -223,6 +223,32 @@ typedef enum {
 	VKVG_FILL_RULE_NON_ZERO		/*!< non zero fill rule */
 } vkvg_fill_rule_t;
 
+/**
+ * @brief antialiasing method.
+ *
+ * define how edges of filled and stroked pathes are smoothed. This setting is holded in the context and may be
+ * accessed with #vkvg_set_antialias and #vkvg_get_antialias.
+ */
+typedef enum {
+	VKVG_ANTIALIAS_DEFAULT,		/*!< rely on the multisampling of the device, edges are aliased on single sampled devices. This is the default. */
+	VKVG_ANTIALIAS_FRINGE		/*!< border fills and strokes with a one pixel wide fringe fading out their coverage, smooth edges
+									 are obtained without multisampling. */
+} vkvg_antialias_t;
+
+/**
+ * @brief stroke geometry generation.
+ *
+ * define where the outline of stroked pathes is built. This setting is holded in the context and may be
+ * accessed with #vkvg_set_stroke_mode and #vkvg_get_stroke_mode.
+ */
+typedef enum {
+	VKVG_STROKE_MODE_TESSELLATED,	/*!< joins and caps are tessellated on the cpu. This is the default. */
+	VKVG_STROKE_MODE_GPU			/*!< only the path points are uploaded, segments, joins and caps are expanded in the vertex
+										 shader and antialiased in the fragment shader. Dashes are evaluated per fragment,
+										 dash patterns of more than 8 values and strokes with a pattern source are still
+										 tessellated. */
+} vkvg_stroke_mode_t;
+
 typedef struct {
 	float r;					/*!< the red component */
 	float g;					/*!< the green component */
@@ -321,6 +347,52 @@ typedef struct _vkvg_device_t*	VkvgDevice;
  * configurable parameters such as the wrap mode, the filtering, etc...
  */
 typedef struct _vkvg_pattern_t* VkvgPattern;
+/**
+ * @brief Opaque pointer on a Vkvg path structure.
+ * @ingroup path
+ *
+ * A #VkvgPath holds a copy of the flattened path of a context, created with #vkvg_copy_path().
+ * It is never modified once created, and may be appended to the path of any context with
+ * #vkvg_append_path() without flattening curves again.
+ */
+typedef struct _vkvg_path_t* VkvgPath;
+
+/**
+ * @brief Memory categories tracked by a vkvg device.
+ * @ingroup device
+ *
+ * Every vulkan allocation done by vkvg is accounted in one of those categories.
+ */
+typedef enum {
+	VKVG_MEMORY_SURFACES,			/*!< final color images of surfaces */
+	VKVG_MEMORY_ATTACHMENTS,		/*!< multisampled color and stencil attachments, saved stencils */
+	VKVG_MEMORY_CONTEXT_BUFFERS,	/*!< context vertex, index and uniform buffers */
+	VKVG_MEMORY_FONT_ATLAS,			/*!< font cache texture array */
+	VKVG_MEMORY_STAGING,			/*!< host visible upload buffers */
+	VKVG_MEMORY_CATEGORY_COUNT
+} vkvg_memory_category_t;
+/**
+ * @brief vkvg device memory usage.
+ * @ingroup device
+ */
+typedef struct {
+	uint64_t	usage[VKVG_MEMORY_CATEGORY_COUNT];	/**< current usage in bytes per category	*/
+	uint64_t	total;								/**< sum of all categories					*/
+	uint64_t	peak;								/**< highest total usage reached			*/
+	uint64_t	budget;								/**< current budget, 0 if unlimited			*/
+} vkvg_memory_stats_t;
+/**
+ * @brief Memory eviction callback.
+ * @ingroup device
+ *
+ * Called before an allocation that would exceed the device memory budget. The application may
+ * release vkvg objects (surfaces, patterns, contexts) from this callback to make room.
+ * @param userData the pointer given to @ref vkvg_device_set_memory_evict_callback.
+ * @param dev the device on which the allocation is requested.
+ * @param category the memory category of the pending allocation.
+ * @param requested the size in bytes of the pending allocation.
+ */
+typedef void (*vkvg_memory_evict_func_t) (void* userData, VkvgDevice dev, vkvg_memory_category_t category, uint64_t requested);
 
 #if VKVG_DBG_STATS
 /**
@@ -505,6 +577,17 @@ void vkvg_matrix_transform_distance (const vkvg_matrix_t *matrix, float *dx, flo
  */
 vkvg_public
 void vkvg_matrix_transform_point (const vkvg_matrix_t *matrix, float *x, float *y);
+/**
+ * @brief transform an array of points
+ *
+ * Transforms in place count points stored as consecutive x and y coordinates, the result is the same as calling
+ * #vkvg_matrix_transform_point() for each of them. Points are processed in batches with SIMD instructions when available.
+ * @param matrix a valid #vkvg_matrix_t to use to transform points
+ * @param points an array of 2 * count floats, x and y of each point. An in/out parameter
+ * @param count the number of points to transform
+ */
+vkvg_public
+void vkvg_matrix_transform_points (const vkvg_matrix_t *matrix, float *points, uint32_t count);
 /**
  * @brief invert matrix
  *
@@ -666,6 +749,96 @@ void vkvg_device_set_dpy (VkvgDevice dev, int hdpy, int vdpy);
  */
 vkvg_public
 void vkvg_device_get_dpy (VkvgDevice dev, int* hdpy, int* vdpy);
+/**
+ * @brief Set initial cache sizes of new contexts.
+ *
+ * Host arrays and vulkan buffers of contexts grow on demand, starting from those sizes. Smaller values reduce
+ * memory used by short lived contexts, larger ones prevent reallocations for heavy workloads.
+ * Contexts already created or stored in the device context cache are not affected.
+ * @param dev The vkvg device to configure.
+ * @param points initial point count of the path array.
+ * @param vertices initial vertex count of the vertex cache and vertex buffer.
+ * @param indices initial index count of the index cache and index buffer.
+ */
+vkvg_public
+void vkvg_device_set_context_cache_sizes (VkvgDevice dev, uint32_t points, uint32_t vertices, uint32_t indices);
+/**
+ * @brief Enable deferred release of contexts.
+ *
+ * By default, #vkvg_destroy waits for the context's pending drawing operations to complete. If enabled,
+ * the context is only submitted and queued for release, its target surface and source patterns
+ * are kept alive until the gpu is done with them. Queued objects are released by later calls to
+ * #vkvg_destroy, #vkvg_create or #vkvg_device_release_deferred, and at device destruction.
+ * @remark When enabled, synchronize with the target surface before using its image outside vkvg,
+ * for example with #vkvg_flush before destroying the context.
+ * @param dev The vkvg device to configure.
+ * @param deferred true to enable deferred release, false to restore blocking destruction, pending releases are then completed.
+ */
+vkvg_public
+void vkvg_device_set_deferred_release (VkvgDevice dev, bool deferred);
+/**
+ * @brief Release objects whose destruction has been deferred.
+ *
+ * Objects whose gpu work is completed are released, this call never blocks unless wait is true.
+ * @param dev The vkvg device.
+ * @param wait if true, wait for the device to be idle and release all pending objects.
+ */
+vkvg_public
+void vkvg_device_release_deferred (VkvgDevice dev, bool wait);
+/**
+ * @brief Query device memory usage.
+ *
+ * Fill the statistics structure with the current memory usage of this device per category.
+ * @param dev The vkvg device to query.
+ * @param stats a valid pointer to the structure to fill.
+ */
+vkvg_public
+void vkvg_device_get_memory_stats (VkvgDevice dev, vkvg_memory_stats_t* stats);
+/**
+ * @brief Set a memory budget for this device.
+ *
+ * When an allocation would exceed the budget, the eviction callback is called first. If the budget is still
+ * exceeded afterward, surface creation fails with VKVG_STATUS_NO_MEMORY, other allocations needed to complete
+ * a drawing operation are still performed.
+ * @param dev The vkvg device to set the budget for.
+ * @param budget Budget in bytes, 0 to disable.
+ */
+vkvg_public
+void vkvg_device_set_memory_budget (VkvgDevice dev, uint64_t budget);
+/**
+ * @brief Set the memory eviction callback.
+ *
+ * The callback is called before an allocation exceeding the budget, once objects waiting for deferred release
+ * (see #vkvg_device_set_deferred_release()) whose gpu work is done have been freed. It runs on the thread requesting
+ * the allocation, which may be in the middle of a drawing operation: surface creation and upload, #vkvg_save() when
+ * the stencil has to be saved, growth of context vertex buffers, or growth of the font atlas while text is drawn, in
+ * which case the font cache lock is held on thread aware devices. The device lock is not held.
+ *
+ * From the callback, the application may destroy surfaces, patterns and contexts that are not in use by any thread,
+ * and release its own references on other objects. It must not draw, create vkvg objects, nor destroy a context
+ * that is drawing. Released objects still used by submitted gpu work stay accounted until their deferred release.
+ * @param dev The vkvg device to set the callback for.
+ * @param evict The eviction callback, NULL to disable.
+ * @param userData pointer passed as first argument to the callback.
+ */
+vkvg_public
+void vkvg_device_set_memory_evict_callback (VkvgDevice dev, vkvg_memory_evict_func_t evict, void* userData);
+/**
+ * @brief Enable the tessellation cache of the device.
+ *
+ * When enabled, triangles computed for tessellated strokes and fills are kept in host memory, keyed by the flattened
+ * path and by the fill rule or the stroke parameters. Drawing the same path again from any context of the device reuses
+ * them instead of triangulating again. Fills are reused under any matrix, strokes as long as the matrix scale is the
+ * same. Least recently used meshes are evicted when the size is exceeded.
+ *
+ * Only pathes triangulated on the cpu are cached: concave single contour fills of moderate size and all non-zero fills
+ * when the stencil is not used for them (macOS). Convex fills, fills with several contours or many points (drawn with
+ * the stencil), rectangles, circles, rounded rectangles, hairlines and strokes expanded on the gpu are not cached.
+ * @param dev The vkvg device to configure.
+ * @param size Maximum size in bytes of the cached meshes, 0 to disable the cache and release them.
+ */
+vkvg_public
+void vkvg_device_set_tessellation_cache_size (VkvgDevice dev, uint64_t size);
 
 /**
  * @brief query required instance extensions for vkvg.
@@ -896,6 +1069,19 @@ VkvgContext vkvg_create (VkvgSurface surf);
  */
 vkvg_public
 void vkvg_destroy (VkvgContext ctx);
+/**
+ * @brief Bind an existing context to another target surface.
+ *
+ * Pending drawing operations are flushed to the current target, then the context is bound to surf and
+ * all graphics state parameters are reset to their default values as with #vkvg_create. Vulkan ressources
+ * and internal buffers grown by previous operations are kept, so a single context may be reused to render
+ * many surfaces without the cost of a destroy/create cycle.
+ * @remark This function references surf and release the reference held on the previous target.
+ * @param ctx The vkvg context to retarget.
+ * @param surf The new target surface, it must have been created on the same device as the context.
+ */
+vkvg_public
+void vkvg_set_target (VkvgContext ctx, VkvgSurface surf);
 /**
  * @brief Get context status.
  *
@@ -940,6 +1126,16 @@ uint32_t vkvg_get_reference_count (VkvgContext ctx);
  */
 vkvg_public
 void vkvg_flush (VkvgContext ctx);
+/**
+ * @brief Release unused memory held by a context.
+ *
+ * Host arrays and vulkan buffers of a context only grow while drawing, and are shrunk automatically
+ * when their usage stays far below their size for several flushes. Calling #vkvg_trim flushes the context
+ * and immediately reduces those arrays and buffers to the size needed by the current path.
+ * @param ctx The vkvg context to trim.
+ */
+vkvg_public
+void vkvg_trim (VkvgContext ctx);
 /**
  * @brief Start a new empty path.
  *
@@ -981,6 +1177,64 @@ void vkvg_new_sub_path (VkvgContext ctx);
  */
 vkvg_public
 void vkvg_path_extents (VkvgContext ctx, float *x1, float *y1, float *x2, float *y2);
+/**
+ * @brief Copy the current path.
+ *
+ * Create a new #VkvgPath holding the points of the current path of the context, curves being already
+ * flattened with the tolerance and the transformation in use when they were added. The context
+ * path is left unchanged, a subpath reduced to its current point is not copied.
+ *
+ * Once created, the path is never modified: it may be appended concurrently to contexts of several threads. Its
+ * reference count is locked when the device of the context is thread aware (see #vkvg_device_set_thread_aware()).
+ * @param ctx a valid @ref context
+ * @return a new #VkvgPath to destroy with #vkvg_path_destroy(), check its status with #vkvg_path_status().
+ */
+vkvg_public
+VkvgPath vkvg_copy_path (VkvgContext ctx);
+/**
+ * @brief Append a path to the current path.
+ *
+ * Add the subpathes of a #VkvgPath created with #vkvg_copy_path() to the current path of the context,
+ * points are copied as is without being flattened again. The current subpath is finished first, and
+ * no current point is defined after this call.
+ * @param ctx a valid @ref context
+ * @param path the #VkvgPath to append.
+ */
+vkvg_public
+void vkvg_append_path (VkvgContext ctx, VkvgPath path);
+/**
+ * @brief Get path current status.
+ *
+ * @param path A valid path handle.
+ * @return VKVG_STATUS_SUCCESS, or the status of the context it was copied from if it was in error.
+ */
+vkvg_public
+vkvg_status_t vkvg_path_status (VkvgPath path);
+/**
+ * @brief add reference
+ *
+ * increment reference count by one for the supplied #VkvgPath.
+ * @param path a valid #VkvgPath pointer
+ * @return VkvgPath
+ */
+vkvg_public
+VkvgPath vkvg_path_reference (VkvgPath path);
+/**
+ * @brief get reference count
+ *
+ * @param path a valid #VkvgPath to query for its reference count
+ * @return uint32_t the current reference count for this instance.
+ */
+vkvg_public
+uint32_t vkvg_path_get_reference_count (VkvgPath path);
+/**
+ * @brief release path
+ *
+ * Decrement the reference count of the path, its memory is freed when it reaches 0.
+ * @param path a valid #VkvgPath pointer
+ */
+vkvg_public
+void vkvg_path_destroy (VkvgPath path);
 /**
  * @brief Get the current point.
  *
@@ -1479,6 +1733,42 @@ void vkvg_set_operator (VkvgContext ctx, vkvg_operator_t op);
  */
 vkvg_public
 void vkvg_set_fill_rule (VkvgContext ctx, vkvg_fill_rule_t fr);
+/**
+ * @brief set the antialiasing method.
+ *
+ * Select how edges of further fill and stroke commands are smoothed. With #VKVG_ANTIALIAS_FRINGE, a thin fringe
+ * with a coverage fading to zero is tessellated along the path outlines, giving smooth edges on surfaces
+ * created by a single sampled device at a fraction of the memory and fill rate cost of multisampling.
+ * @param ctx a valid vkvg @ref context
+ * @param antialias the new antialiasing method as defined in #vkvg_antialias_t.
+ */
+vkvg_public
+void vkvg_set_antialias (VkvgContext ctx, vkvg_antialias_t antialias);
+/**
+ * @brief set the curves flattening tolerance.
+ *
+ * Curves, arcs and round joins are approximated with line segments whose maximum distance to the exact curve
+ * on the surface is lower than this tolerance. The segment count adapts to the current transformation, so that
+ * zoomed out shapes produce less segments. Higher values give faster rendering at the expense of smoothness.
+ * The tolerance applies to further path commands, pathes already built are not affected.
+ * @param ctx a valid vkvg @ref context
+ * @param tolerance the maximum distance in device units, default is 0.1.
+ */
+vkvg_public
+void vkvg_set_tolerance (VkvgContext ctx, float tolerance);
+/**
+ * @brief set the stroke geometry generation mode.
+ *
+ * With #VKVG_STROKE_MODE_GPU, further strokes upload a single record per path point instead of the tessellated
+ * outline, which greatly reduces the cpu time and the vertex upload of wide strokes made of many segments.
+ * Dashes are computed on the gpu from the distance along the path, so that the vertex count does not depend on
+ * the dash pattern and animating the dash offset is cheap.
+ * Edges are antialiased by the fragment shader whatever the antialiasing method is.
+ * @param ctx a valid vkvg @ref context
+ * @param mode the new stroke mode as defined in #vkvg_stroke_mode_t.
+ */
+vkvg_public
+void vkvg_set_stroke_mode (VkvgContext ctx, vkvg_stroke_mode_t mode);
 /**
  * @brief set the dash configuration for strokes
  *
@@ -1553,6 +1843,33 @@ vkvg_operator_t vkvg_get_operator (VkvgContext ctx);
  */
 vkvg_public
 vkvg_fill_rule_t vkvg_get_fill_rule (VkvgContext ctx);
+/**
+ * @brief Get current antialiasing method.
+ *
+ * Initial value is `VKVG_ANTIALIAS_DEFAULT` and may be modified by a call to #vkvg_set_antialias.
+ * @param ctx a valid vkvg @ref context
+ * @return vkvg_antialias_t The current antialiasing method of the context.
+ */
+vkvg_public
+vkvg_antialias_t vkvg_get_antialias (VkvgContext ctx);
+/**
+ * @brief Get current curves flattening tolerance.
+ *
+ * Initial value is 0.1 and may be modified by a call to #vkvg_set_tolerance.
+ * @param ctx a valid vkvg @ref context
+ * @return the current tolerance in device units.
+ */
+vkvg_public
+float vkvg_get_tolerance (VkvgContext ctx);
+/**
+ * @brief Get current stroke geometry generation mode.
+ *
+ * Initial value is `VKVG_STROKE_MODE_TESSELLATED` and may be modified by a call to #vkvg_set_stroke_mode.
+ * @param ctx a valid vkvg @ref context
+ * @return vkvg_stroke_mode_t The current stroke mode of the context.
+ */
+vkvg_public
+vkvg_stroke_mode_t vkvg_get_stroke_mode (VkvgContext ctx);
 /**
  * @brief Get the current source of the context.
  *
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2018-2022 Jean-Philippe Bruyère <jp_bruyere@hotmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+ * Software, and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#version 450
+
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+//instanced glyphs, one instance per glyph expanding a shared unit quad.
+layout (location = 0) in vec2	inCorner;		//unit quad corner
+layout (location = 1) in vec4	inColor;		//per instance
+layout (location = 3) in vec2	inGlyphPos;		//per instance, bitmap top left corner
+layout (location = 4) in ivec2	inGlyphSize;	//per instance, bitmap size in pixels
+layout (location = 5) in ivec2	inGlyphTexel;	//per instance, bitmap top left corner in font cache page
+layout (location = 6) in float	inGlyphPage;	//per instance, font cache array layer
+
+layout (location = 0) out vec3	outUV;
+layout (location = 1) out vec4	outSrc;
+layout (location = 2) out flat int outPatType;
+layout (location = 3) out flat float outOpacity;
+layout (location = 4) out mat3x2 outMat;
+
+layout(push_constant) uniform PushConsts {
+	vec4	source;
+	vec2	size;
+	int		fullScreenQuad_srcType;
+	float	opacity;
+	mat3x2	mat;
+	mat3x2	matInv;
+} pc;
+
+#define SRCTYPE_MASK	0x000000FF
+#define SOLID			0
+#define FONT_PAGE_SIZE	1024.0	//must match vkvg_fonts.h
+
+void main()
+{
+	outPatType	= pc.fullScreenQuad_srcType & SRCTYPE_MASK;
+	outMat		= pc.matInv;
+	outSrc		= outPatType == SOLID ? inColor : pc.source;
+	outOpacity	= pc.opacity;
+
+	vec2 corner = inCorner * vec2(inGlyphSize);
+
+	outUV = vec3((vec2(inGlyphTexel) + corner) / FONT_PAGE_SIZE, inGlyphPage);
+
+	vec2 pos = inGlyphPos + corner;
+
+	vec2 p = vec2(
+		pc.mat[0][0] * pos.x + pc.mat[1][0] * pos.y + pc.mat[2][0],
+		pc.mat[0][1] * pos.x + pc.mat[1][1] * pos.y + pc.mat[2][1]
+	);
+
+	gl_Position = vec4(p * vec2(2) / pc.size - vec2(1), 0.0, 1.0);
+	gl_PointSize = 1;
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2018-2022 Jean-Philippe Bruyère <jp_bruyere@hotmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+ * Software, and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#version 450
+
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+layout (location = 0) in vec3		inPos;		//position in the segment frame, arc length
+layout (location = 1) in flat vec4	inColor;
+layout (location = 2) in flat vec4	inSeg;		//segment length, half line width, start and end cap flags
+layout (location = 3) in flat vec4	inPlane0;
+layout (location = 4) in flat vec4	inLimit0;
+layout (location = 5) in flat vec4	inPlane1;
+layout (location = 6) in flat vec4	inLimit1;
+layout (location = 7) in flat float	inDashCap;
+
+#define DASH_MAX	8
+
+//dash pattern of the stroke, odd patterns are repeated twice so that even dashes are always on
+layout(push_constant) uniform PushConsts {
+	layout(offset = 80)
+	float	miterLimit;
+	float	dashOffset;
+	float	dashTotal;		//pattern length, 0 for solid strokes
+	float	dashes[DASH_MAX];
+} pc;
+
+layout (location = 0) out vec4 outFragColor;
+
+void main()
+{
+	float hw = inSeg.y;
+	vec2 q0 = vec2(-inPos.x, inPos.y);
+	vec2 q1 = vec2(inPos.x - inSeg.x, inPos.y);
+
+	//distance to the segment sides, or to the end point on the outer side of round ends
+	float d = abs (inPos.y) - hw;
+	if (inLimit0.z > 0.0 && q0.x > 0.0 && q0.y * inLimit0.w >= 0.0)
+		d = length (q0) - hw;
+	if (inLimit1.z > 0.0 && q1.x > 0.0 && q1.y * inLimit1.w >= 0.0)
+		d = length (q1) - hw;
+	d = max (d, max (dot (inLimit0.xy, q0) - inPlane0.w, dot (inLimit1.xy, q1) - inPlane1.w));
+
+	//distance along the arc to the nearest dash, negative inside, dashes are capped like the path ends
+	if (pc.dashTotal > 0.0) {
+		float s = mod (inPos.z + pc.dashOffset, pc.dashTotal);
+		float c = 0.0, start = 0.0, end = pc.dashes[0];
+		bool on = true;
+		for (int i = 0; i < DASH_MAX; i++) {
+			float next = c + pc.dashes[i];
+			if (s >= c && s < next) {
+				start = c;
+				end = next;
+				on = (i & 1) == 0;
+			}
+			c = next;
+		}
+		float t = on ? max (start - s, s - end) : min (s - start, end - s);
+		if (inDashCap == 1.0 && t > 0.0)
+			t = length (vec2(t, inPos.y)) - hw;
+		else if (inDashCap != 0.0)
+			t -= hw;
+		d = max (d, t);
+	}
+
+	//caps are antialiased, join bisectors split the coverage between adjacent segments without overlap,
+	//pixels on the bisector belong to the segment ending there
+	float p0 = dot (inPlane0.xy, q0) - inPlane0.z;
+	float p1 = dot (inPlane1.xy, q1) - inPlane1.z;
+	d = max (d, max (inSeg.z > 0.0 ? p0 : d, inSeg.w > 0.0 ? p1 : d));
+
+	float coverage = clamp (0.5 - d / max (fwidth (d), 1e-6), 0.0, 1.0);
+	if ((inSeg.z == 0.0 && p0 >= 0.0) || (inSeg.w == 0.0 && p1 > 0.0))
+		coverage = 0.0;
+#ifdef VKVG_PREMULT_ALPHA
+	outFragColor = inColor * coverage;
+#else
+	outFragColor = vec4(inColor.rgb, inColor.a * coverage);
+#endif
+}
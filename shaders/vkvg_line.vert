@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2018-2022 Jean-Philippe Bruyère <jp_bruyere@hotmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+ * Software, and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#version 450
+
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+//instanced stroke segments expanded from the centerline points. Instance i reads the consecutive points i to i+3
+//as previous point, segment start and end, and next point. Joins and caps are turned into clipping planes in the
+//segment frame, coverage is computed in the fragment shader from the distance to the stroke outline.
+layout (location = 0) in vec2	inCorner;	//unit quad corner
+layout (location = 1) in vec4	inColor;	//segment start color
+layout (location = 3) in vec2	inPrev;
+layout (location = 4) in vec2	inP0;
+layout (location = 5) in vec2	inP1;
+layout (location = 6) in vec2	inNext;
+layout (location = 7) in vec2	inParams;	//half line width, arc length of the segment start
+layout (location = 8) in uint	inFlags0;	//segment start point flags
+layout (location = 9) in uint	inFlags1;	//segment end point flags
+
+layout (location = 0) out vec3		outPos;		//position in the segment frame, x from the start along the segment, arc length
+layout (location = 1) out flat vec4	outColor;
+layout (location = 2) out flat vec4	outSeg;		//segment length, half line width, start and end cap flags
+layout (location = 3) out flat vec4	outPlane0;	//start plane normal and offset, outer limit distance
+layout (location = 4) out flat vec4	outLimit0;	//start outer limit direction, round flag, outer side
+layout (location = 5) out flat vec4	outPlane1;	//same for the end, in a frame where x points beyond it
+layout (location = 6) out flat vec4	outLimit1;
+layout (location = 7) out flat float	outDashCap;	//cap type of the dashes
+
+layout(push_constant) uniform PushConsts {
+	vec4	source;
+	vec2	size;
+	int		fullScreenQuad_srcType;
+	float	opacity;
+	mat3x2	mat;
+	mat3x2	matInv;
+	float	miterLimit;
+} pc;
+
+#define LINE_NO_SEGMENT	0x1u	//no segment starts at this point
+#define LINE_CAP		0x2u	//open path end
+#define NO_LIMIT		1e30
+
+//clipping of a segment end in a frame where x points beyond the end, e is the adjacent segment direction.
+//Caps are cut by a plane normal to the segment, joins by the bisector of the two segments and the miter or
+//bevel limit along the outer bisector, round ends use the distance to the end point on their outer side.
+void segEnd (bool cap, uint flags, vec2 e, float hw, float lhMax, out vec4 plane, out vec4 limit) {
+	uint join = (flags >> 2) & 3u;
+	uint capType = (flags >> 4) & 3u;
+	if (cap) {
+		plane = vec4(1.0, 0.0, capType == 0u ? 0.0 : hw, NO_LIMIT);
+		limit = vec4(0.0, 0.0, capType == 1u ? 1.0 : 0.0, 0.0);
+		return;
+	}
+	vec2 b = vec2(1.0, 0.0) + e;
+	float lb = length (b);
+	float side = -sign (e.y);
+	vec2 m = vec2(0.0, side) + side * vec2(-e.y, e.x);
+	float lm = length (m);
+	m = lm > 0.0 ? m / lm : vec2(0.0);
+	float cosHalf = m.y * side;
+	float l = NO_LIMIT;
+	if (side != 0.0 && join == 0u)
+		l = min (hw / cosHalf, lhMax);
+	else if (side != 0.0 && join == 2u)
+		l = hw * cosHalf;
+	plane = vec4(lb > 1e-6 ? b / lb : vec2(1.0, 0.0), 0.0, l);
+	limit = vec4(m, join == 1u ? 1.0 : 0.0, side);
+}
+
+void main()
+{
+	float hw = inParams.x;
+	float lhMax = pc.miterLimit * hw * 2.0;
+	vec2 d = inP1 - inP0;
+	float len = length (d);
+	vec2 dn = d / len;
+	vec2 nr = vec2(-dn.y, dn.x);
+
+	bool cap0 = (inFlags0 & LINE_CAP) != 0u;
+	bool cap1 = (inFlags1 & LINE_CAP) != 0u;
+	vec2 f = normalize (inPrev - inP0);
+	vec2 e = normalize (inNext - inP1);
+	segEnd (cap0, inFlags0, vec2(-dot (f, dn), dot (f, nr)), hw, lhMax, outPlane0, outLimit0);
+	segEnd (cap1, inFlags1, vec2( dot (e, dn), dot (e, nr)), hw, lhMax, outPlane1, outLimit1);
+
+#ifdef VKVG_PREMULT_ALPHA
+	outColor	= inColor * pc.opacity;
+#else
+	outColor	= vec4(inColor.rgb, inColor.a * pc.opacity);
+#endif
+	outSeg		= vec4(len, hw, cap0 ? 1.0 : 0.0, cap1 ? 1.0 : 0.0);
+	outDashCap	= float((inFlags0 >> 4) & 3u);
+
+	//one pixel margin in user space for antialiasing
+	float margin = inversesqrt (abs (pc.mat[0].x * pc.mat[1].y - pc.mat[0].y * pc.mat[1].x));
+	float ext0 = max (hw, outPlane0.w < NO_LIMIT ? outPlane0.w : 0.0) + margin;
+	float ext1 = max (hw, outPlane1.w < NO_LIMIT ? outPlane1.w : 0.0) + margin;
+
+	float u = mix (-ext0, len + ext1, inCorner.x);
+	outPos = vec3(u, mix (-hw - margin, hw + margin, inCorner.y), inParams.y + u);
+	vec2 p = pc.mat * vec3(inP0 + dn * outPos.x + nr * outPos.y, 1.0);
+
+	if (len == 0.0 || (inFlags0 & LINE_NO_SEGMENT) != 0u)
+		p = vec2(-1.0);//degenerated, nothing is drawn
+	gl_Position = vec4(p * vec2(2) / pc.size - vec2(1), 0.0, 1.0);
+	gl_PointSize = 1;
+}
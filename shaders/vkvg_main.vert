@@ -61,7 +61,8 @@ void main()
 	outPatType	= pc.fullScreenQuad_srcType & SRCTYPE_MASK;
 	outMat		= pc.matInv;
 	outSrc		= outPatType == SOLID ? inColor : pc.source;
-	outOpacity	= pc.opacity;
+	//vertex alpha of patterns holds the antialiasing fringe coverage
+	outOpacity	= outPatType == SOLID ? pc.opacity : pc.opacity * inColor.a;
 
 	if ((pc.fullScreenQuad_srcType & FULLSCREEN_BIT)==FULLSCREEN_BIT) {
 		gl_Position = vec4(inPos, 0.0f, 1.0f);
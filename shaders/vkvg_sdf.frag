@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2018-2022 Jean-Philippe Bruyère <jp_bruyere@hotmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+ * Software, and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#version 450
+
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+layout (location = 0) in vec2		inPos;
+layout (location = 1) in flat vec4	inColor;
+layout (location = 2) in flat vec2	inHalfSize;
+layout (location = 3) in flat vec2	inParams;	//corner radius (negative for ellipses), stroke half width
+
+layout (location = 0) out vec4 outFragColor;
+
+//approximated distance to an axis aligned ellipse
+float sdEllipse (vec2 p, vec2 r) {
+	float k0 = length (p / r);
+	float k1 = length (p / (r * r));
+	return k1 > 0.0 ? k0 * (k0 - 1.0) / k1 : -min (r.x, r.y);
+}
+float sdRoundBox (vec2 p, vec2 b, float r) {
+	vec2 q = abs (p) - b + vec2(r);
+	return length (max (q, vec2(0))) + min (max (q.x, q.y), 0.0) - r;
+}
+
+void main()
+{
+	float d = inParams.x < 0.0 ? sdEllipse (inPos, inHalfSize) : sdRoundBox (inPos, inHalfSize, inParams.x);
+	if (inParams.y > 0.0)
+		d = abs (d) - inParams.y;
+
+	float coverage = clamp (0.5 - d / max (fwidth (d), 1e-6), 0.0, 1.0);
+#ifdef VKVG_PREMULT_ALPHA
+	outFragColor = inColor * coverage;
+#else
+	outFragColor = vec4(inColor.rgb, inColor.a * coverage);
+#endif
+}
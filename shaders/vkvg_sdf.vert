@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2018-2022 Jean-Philippe Bruyère <jp_bruyere@hotmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+ * Software, and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#version 450
+
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+//instanced circles, ellipses and rounded rectangles, one instance per shape expanding a shared unit quad
+//to the shape bounds. Coverage is computed from the signed distance to the shape in the fragment shader.
+layout (location = 0) in vec2	inCorner;	//unit quad corner
+layout (location = 1) in vec4	inColor;	//per instance
+layout (location = 3) in vec2	inCenter;	//per instance
+layout (location = 4) in vec2	inHalfSize;	//per instance
+layout (location = 5) in vec3	inParams;	//per instance: corner radius (negative for ellipses), stroke half width, antialiasing margin
+
+layout (location = 0) out vec2		outPos;		//position relative to the shape center
+layout (location = 1) out flat vec4	outColor;
+layout (location = 2) out flat vec2	outHalfSize;
+layout (location = 3) out flat vec2	outParams;	//corner radius, stroke half width
+
+layout(push_constant) uniform PushConsts {
+	vec4	source;
+	vec2	size;
+	int		fullScreenQuad_srcType;
+	float	opacity;
+	mat3x2	mat;
+	mat3x2	matInv;
+} pc;
+
+void main()
+{
+#ifdef VKVG_PREMULT_ALPHA
+	outColor	= inColor * pc.opacity;
+#else
+	outColor	= vec4(inColor.rgb, inColor.a * pc.opacity);
+#endif
+	outHalfSize	= inHalfSize;
+	outParams	= inParams.xy;
+
+	vec2 ext = inHalfSize + vec2(inParams.y + inParams.z);
+	outPos = (inCorner * 2.0 - 1.0) * ext;
+
+	vec2 p = pc.mat * vec3(inCenter + outPos, 1.0);
+
+	gl_Position = vec4(p * vec2(2) / pc.size - vec2(1), 0.0, 1.0);
+	gl_PointSize = 1;
+}
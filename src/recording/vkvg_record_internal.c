@@ -47,6 +47,8 @@ void _destroy_recording (vkvg_recording_t* rec) {
 			vkvg_pattern_destroy((VkvgPattern)(rec->buffer + rec->commands[i].dataOffset));
 		else if (rec->commands[i].cmd == VKVG_CMD_SET_SOURCE_SURFACE)
 			vkvg_surface_destroy ((VkvgSurface)(rec->buffer + rec->commands[i].dataOffset + 2 * sizeof(float)));
+		else if (rec->commands[i].cmd == VKVG_CMD_APPEND_PATH)
+			vkvg_path_destroy (*(VkvgPath*)(rec->buffer + rec->commands[i].dataOffset));
 	}
 	free(rec->commands);
 	free(rec->buffer);
@@ -124,6 +126,7 @@ void _record (vkvg_recording_t* rec,...) {
 			switch (r->cmd) {
 			case VKVG_CMD_SET_LINE_WIDTH:
 			case VKVG_CMD_SET_MITER_LIMIT:
+			case VKVG_CMD_SET_TOLERANCE:
 				STORE_FLOATS(1);
 				break;
 			case VKVG_CMD_SET_LINE_JOIN:
@@ -138,6 +141,12 @@ void _record (vkvg_recording_t* rec,...) {
 			case VKVG_CMD_SET_FILL_RULE:
 				STORE_UINT32(1);
 				break;
+			case VKVG_CMD_SET_ANTIALIAS:
+				STORE_UINT32(1);
+				break;
+			case VKVG_CMD_SET_STROKE_MODE:
+				STORE_UINT32(1);
+				break;
 			case VKVG_CMD_SET_DASH:
 				break;
 			}
@@ -167,6 +176,14 @@ void _record (vkvg_recording_t* rec,...) {
 				STORE_FLOATS(5);
 				STORE_BOOLS(2);
 				break;
+			case VKVG_CMD_APPEND_PATH:
+				{
+					buff = _ensure_recording_buffer (rec, sizeof(VkvgPath));
+					VkvgPath path = (VkvgPath)va_arg(args, VkvgPath);
+					*(VkvgPath*)buff = vkvg_path_reference(path);
+					_advance_recording_buffer_unchecked (rec, sizeof(VkvgPath));
+				}
+				break;
 			case VKVG_CMD_NEW_PATH:
 			case VKVG_CMD_NEW_SUB_PATH:
 			case VKVG_CMD_CLOSE_PATH:
@@ -296,6 +313,15 @@ void _replay_command (VkvgContext ctx, VkvgRecording rec, uint32_t index) {
 			case VKVG_CMD_SET_FILL_RULE:
 				vkvg_set_fill_rule (ctx, (vkvg_fill_rule_t)uints[0]);
 				return;
+			case VKVG_CMD_SET_ANTIALIAS:
+				vkvg_set_antialias (ctx, (vkvg_antialias_t)uints[0]);
+				return;
+			case VKVG_CMD_SET_TOLERANCE:
+				vkvg_set_tolerance (ctx, floats[0]);
+				return;
+			case VKVG_CMD_SET_STROKE_MODE:
+				vkvg_set_stroke_mode (ctx, (vkvg_stroke_mode_t)uints[0]);
+				return;
 			case VKVG_CMD_SET_DASH:
 				vkvg_set_dash(ctx, &floats[2],  uints[0], floats[1]);
 				return;
@@ -341,6 +367,9 @@ void _replay_command (VkvgContext ctx, VkvgRecording rec, uint32_t index) {
 			case VKVG_CMD_QUADRATIC_TO:
 				vkvg_quadratic_to (ctx, floats[0], floats[1], floats[2], floats[3]);
 				return;
+			case VKVG_CMD_APPEND_PATH:
+				vkvg_append_path (ctx, *(VkvgPath*)floats);
+				return;
 			}
 		}
 	} else if (r->cmd & VKVG_CMD_DRAW_COMMANDS) {
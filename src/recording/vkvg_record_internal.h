@@ -49,6 +49,7 @@
 #define VKVG_CMD_CURVE_TO			(0x000A|VKVG_CMD_PATH_COMMANDS)
 #define VKVG_CMD_QUADRATIC_TO		(0x000B|VKVG_CMD_PATH_COMMANDS)
 #define VKVG_CMD_ELLIPTICAL_ARC_TO	(0x000C|VKVG_CMD_PATH_COMMANDS)
+#define VKVG_CMD_APPEND_PATH		(0x000D|VKVG_CMD_PATH_COMMANDS)
 
 #define VKVG_CMD_SET_LINE_WIDTH		(0x0001|VKVG_CMD_PATHPROPS_COMMANDS)
 #define VKVG_CMD_SET_MITER_LIMIT	(0x0002|VKVG_CMD_PATHPROPS_COMMANDS)
@@ -57,6 +58,9 @@
 #define VKVG_CMD_SET_OPERATOR		(0x0005|VKVG_CMD_PATHPROPS_COMMANDS)
 #define VKVG_CMD_SET_FILL_RULE		(0x0006|VKVG_CMD_PATHPROPS_COMMANDS)
 #define VKVG_CMD_SET_DASH			(0x0007|VKVG_CMD_PATHPROPS_COMMANDS)
+#define VKVG_CMD_SET_ANTIALIAS		(0x0008|VKVG_CMD_PATHPROPS_COMMANDS)
+#define VKVG_CMD_SET_TOLERANCE		(0x0009|VKVG_CMD_PATHPROPS_COMMANDS)
+#define VKVG_CMD_SET_STROKE_MODE	(0x000A|VKVG_CMD_PATHPROPS_COMMANDS)
 
 #define VKVG_CMD_TRANSLATE			(0x0001|VKVG_CMD_TRANSFORM_COMMANDS)
 #define VKVG_CMD_ROTATE				(0x0002|VKVG_CMD_TRANSFORM_COMMANDS)
@@ -30,10 +30,16 @@ void vkvg_buffer_create(VkvgDevice pDev, VkBufferUsageFlags usage, VmaMemoryUsag
 		.usage = usage, .size = size, .sharingMode = VK_SHARING_MODE_EXCLUSIVE};
 	VmaAllocationCreateInfo allocInfo = { .usage = memoryPropertyFlags, .flags = VMA_ALLOCATION_CREATE_MAPPED_BIT };
 
+	//transfer sources are upload buffers, others are context buffers (vbo, ibo, ubo)
+	buff->memCategory = (usage & VK_BUFFER_USAGE_TRANSFER_SRC_BIT) ? VKVG_MEMORY_STAGING : VKVG_MEMORY_CONTEXT_BUFFERS;
+	buff->memSize = size;
+	_device_reserve_memory (pDev, buff->memCategory, size);
+
 	VK_CHECK_RESULT(vmaCreateBuffer (pDev->allocator, &bufCreateInfo, &allocInfo, &buff->buffer, &buff->alloc, &buff->allocInfo));
 }
 
 void vkvg_buffer_destroy(vkvg_buff *buff){
+	_device_release_memory (buff->pDev, buff->memCategory, buff->memSize);
 	vmaDestroyBuffer (buff->pDev->allocator, buff->buffer, buff->alloc);
 }
 void vkvg_buffer_flush (vkvg_buff* buff){
@@ -32,6 +32,8 @@ typedef struct vkvg_buff_t {
 	VmaAllocation		alloc;
 	VmaAllocationInfo	allocInfo;
 	VkDescriptorBufferInfo descriptor;
+	vkvg_memory_category_t memCategory;	//category used for device memory accounting
+	VkDeviceSize		memSize;		//accounted size
 }vkvg_buff;
 
 void vkvg_buffer_create			(VkvgDevice pDev, VkBufferUsageFlags usage,
@@ -47,6 +47,9 @@ void _init_ctx (VkvgContext ctx) {
 	ctx->miterLimit		= 10;
 	ctx->curOperator	= VKVG_OPERATOR_OVER;
 	ctx->curFillRule	= VKVG_FILL_RULE_NON_ZERO;
+	ctx->antialias		= VKVG_ANTIALIAS_DEFAULT;
+	ctx->tolerance		= VKVG_TOLERANCE_DEFAULT;
+	ctx->strokeMode		= VKVG_STROKE_MODE_TESSELLATED;
 	ctx->bounds = (VkRect2D) {{0,0},{ctx->pSurf->width,ctx->pSurf->height}};
 	ctx->pushConsts = (push_constants) {
 			{.a = 1},
@@ -83,6 +86,9 @@ void _init_ctx (VkvgContext ctx) {
 	ctx->cmdStarted			= false;
 	ctx->curClipState		= vkvg_clip_state_none;
 	ctx->vertCount			= ctx->indCount = 0;
+	ctx->indexRunCount		= ctx->iboBytes = 0;
+	ctx->instCount			= 0;
+	ctx->sdfShape.pointCount= 0;
 }
 
 VkvgContext vkvg_create(VkvgSurface surf)
@@ -90,6 +96,9 @@ VkvgContext vkvg_create(VkvgSurface surf)
 	VkvgDevice dev = surf->dev;
 	VkvgContext ctx = NULL;
 
+	if (dev->deferRelease)//released contexts may be reused from cache
+		_device_release_deferred (dev, false);
+
 	if (_device_try_get_cached_context (dev, &ctx) ) {
 		ctx->pSurf = surf;
 
@@ -99,7 +108,8 @@ VkvgContext vkvg_create(VkvgSurface surf)
 		}
 
 		_init_ctx (ctx);
-		_update_descriptor_set (ctx, surf->dev->emptyImg, ctx->dsSrc);
+		if (ctx->dsSrc)
+			_update_descriptor_set (ctx, surf->dev->emptyImg, ctx->dsSrc);
 		_clear_path	(ctx);
 		ctx->cmd = ctx->cmdBuffers[0];//current recording buffer
 		ctx->status = VKVG_STATUS_SUCCESS;
@@ -119,9 +129,9 @@ VkvgContext vkvg_create(VkvgSurface surf)
 		return ctx;
 	}
 
-	ctx->sizePoints		= VKVG_PTS_SIZE;
-	ctx->sizeVertices	= ctx->sizeVBO = VKVG_VBO_SIZE;
-	ctx->sizeIndices	= ctx->sizeIBO = VKVG_IBO_SIZE;
+	ctx->sizePoints		= dev->ctxSizePoints;
+	ctx->sizeVertices	= ctx->sizeVBO = dev->ctxSizeVertices;
+	ctx->sizeIndices	= ctx->sizeIBO = dev->ctxSizeIndices;
 	ctx->sizePathes		= VKVG_PATHES_SIZE;
 	ctx->renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
 
@@ -129,8 +139,8 @@ VkvgContext vkvg_create(VkvgSurface surf)
 
 	_init_ctx (ctx);
 
-	ctx->points			= (vec2*)malloc (VKVG_VBO_SIZE * sizeof(vec2));
-	ctx->pathes			= (uint32_t*)malloc (VKVG_PATHES_SIZE * sizeof(uint32_t));
+	ctx->points			= (vec2*)malloc (ctx->sizePoints * sizeof(vec2));
+	ctx->pathes			= (uint32_t*)malloc (ctx->sizePathes * sizeof(uint32_t));
 	ctx->vertexCache	= (Vertex*)malloc (ctx->sizeVertices * sizeof(Vertex));
 	ctx->indexCache		= (VKVG_IBO_INDEX_TYPE*)malloc (ctx->sizeIndices * sizeof(VKVG_IBO_INDEX_TYPE));
 
@@ -147,43 +157,14 @@ VkvgContext vkvg_create(VkvgSurface surf)
 		return NULL;
 	}
 
-	//for context to be thread safe, command pool and descriptor pool have to be created in the thread of the context.
-	ctx->cmdPool	= vkh_cmd_pool_create ((VkhDevice)dev, dev->gQueue->familyIndex, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
-	ctx->flushFence	= vkh_fence_create_signaled ((VkhDevice)ctx->dev);
-
-	_create_vertices_buff	(ctx);
-	_create_gradient_buff	(ctx);
-	_create_cmd_buff		(ctx);
-	_createDescriptorPool	(ctx);
-	_init_descriptor_sets	(ctx);
-	_font_cache_update_context_descset (ctx);
-	_update_descriptor_set	(ctx, surf->dev->emptyImg, ctx->dsSrc);
-	_update_gradient_desc_set(ctx);
-
+	//vulkan ressources (cmd pool and buffers, fence, descriptor sets, vbo, ibo, gradient ubo) are created on first need.
 	_clear_path				(ctx);
 
-	ctx->cmd = ctx->cmdBuffers[0];//current recording buffer
-
 	ctx->references = 1;
 	ctx->status = VKVG_STATUS_SUCCESS;
 
 	LOG(VKVG_LOG_DBG_ARRAYS, "INIT\tctx = %p; pathes:%ju pts:%ju vch:%d vbo:%d ich:%d ibo:%d\n", ctx, (uint64_t)ctx->sizePathes, (uint64_t)ctx->sizePoints, ctx->sizeVertices, ctx->sizeVBO, ctx->sizeIndices, ctx->sizeIBO);
 
-#if defined(DEBUG) && defined (VKVG_DBG_UTILS)
-	vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_COMMAND_POOL, (uint64_t)ctx->cmdPool, "CTX Cmd Pool");
-	vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_COMMAND_BUFFER, (uint64_t)ctx->cmdBuffers[0], "CTX Cmd Buff A");
-	vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_COMMAND_BUFFER, (uint64_t)ctx->cmdBuffers[1], "CTX Cmd Buff B");
-	vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_FENCE, (uint64_t)ctx->flushFence, "CTX Flush Fence");
-
-	vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_DESCRIPTOR_POOL, (uint64_t)ctx->descriptorPool, "CTX Descriptor Pool");
-	vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_DESCRIPTOR_SET, (uint64_t)ctx->dsSrc, "CTX DescSet SOURCE");
-	vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_DESCRIPTOR_SET, (uint64_t)ctx->dsFont, "CTX DescSet FONT");
-	vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_DESCRIPTOR_SET, (uint64_t)ctx->dsGrad, "CTX DescSet GRADIENT");
-
-	vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_BUFFER, (uint64_t)ctx->indices.buffer, "CTX Index Buff");
-	vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_BUFFER, (uint64_t)ctx->vertices.buffer, "CTX Vertex Buff");
-#endif
-
 	return ctx;
 }
 void vkvg_flush (VkvgContext ctx){
@@ -215,6 +196,30 @@ void vkvg_flush (VkvgContext ctx){
 */
 }
 
+void vkvg_trim (VkvgContext ctx) {
+	if (ctx->status)
+		return;
+	_flush_cmd_buff		(ctx);
+	if (!_wait_flush_fence (ctx))
+		return;
+	_trim_caches		(ctx, true);
+}
+
+//free additional stencil use in save/restore process
+void _clear_saved_stencils (VkvgContext ctx) {
+	if (ctx->savedStencils) {
+		uint8_t curSaveStencil = ctx->curSavBit / STENCIL_SAVE_COUNT;
+		for (int i=curSaveStencil;i>0;i--) {
+			vkh_image_destroy(ctx->savedStencils[i-1]);
+			_device_release_memory (ctx->dev, VKVG_MEMORY_ATTACHMENTS,
+									_device_image_size (ctx->dev->stencilFormat, ctx->dev->samples,
+														ctx->renderPassBeginInfo.renderArea.extent.width, ctx->renderPassBeginInfo.renderArea.extent.height, 1));
+		}
+		free(ctx->savedStencils);
+		ctx->savedStencils = NULL;
+	}
+	ctx->curSavBit = 0;
+}
 void _clear_context (VkvgContext ctx) {
 	//free saved context stack elmt
 	vkvg_context_save_t* next = ctx->pSavedCtxs;
@@ -225,16 +230,6 @@ void _clear_context (VkvgContext ctx) {
 		if (cur->pattern)
 			vkvg_pattern_destroy (cur->pattern);
 	}
-	//free additional stencil use in save/restore process
-	if (ctx->savedStencils) {
-		uint8_t curSaveStencil = ctx->curSavBit / 6;
-		for (int i=curSaveStencil;i>0;i--)
-			vkh_image_destroy(ctx->savedStencils[i-1]);
-		free(ctx->savedStencils);
-		ctx->savedStencils = NULL;
-		ctx->curSavBit = 0;
-	}
-
 	//remove context from double linked list of context in device
 	/*if (ctx->dev->lastCtx == ctx){
 		ctx->dev->lastCtx = ctx->pPrev;
@@ -249,32 +244,14 @@ void _clear_context (VkvgContext ctx) {
 	}*/
 	if (ctx->dashCount > 0)
 		free(ctx->dashes);
+	ctx->pSavedCtxs	= NULL;
+	ctx->dashes		= NULL;
+	ctx->dashCount	= 0;
 }
 
-void vkvg_destroy (VkvgContext ctx)
-{
-	if (ctx->status)
-		return;
-
-	ctx->references--;
-	if (ctx->references > 0)
-		return;
-
-	LOG(VKVG_LOG_INFO, "DESTROY Context: ctx = %p (status:%d); surf = %p\n", ctx, ctx->status, ctx->pSurf);
-
-	vkvg_flush (ctx);
-
-	LOG(VKVG_LOG_DBG_ARRAYS, "END\tctx = %p; pathes:%d pts:%d vch:%d vbo:%d ich:%d ibo:%d\n", ctx, ctx->sizePathes, ctx->sizePoints, ctx->sizeVertices, ctx->sizeVBO, ctx->sizeIndices, ctx->sizeIBO);
-
-#if VKVG_RECORDING
-	if (ctx->recording)
-		_destroy_recording(ctx->recording);
-#endif
-
-	if (ctx->pattern)
-		vkvg_pattern_destroy (ctx->pattern);
-
-	_clear_context (ctx);
+//release or store in cache a context no longer referenced whose gpu work is completed.
+void _release_context (VkvgContext ctx) {
+	_clear_saved_stencils (ctx);
 
 #if VKVG_DBG_STATS
 	if (ctx->dev->threadAware)
@@ -298,15 +275,87 @@ void vkvg_destroy (VkvgContext ctx)
 		mtx_unlock (&ctx->dev->mutex);
 #endif
 
-	vkvg_surface_destroy(ctx->pSurf);
-
 	if (!ctx->status && ctx->dev->cachedContextCount < VKVG_MAX_CACHED_CONTEXT_COUNT) {
+		_trim_caches (ctx, false);
 		_device_store_context (ctx);
 		return;
 	}
 
 	_release_context_ressources (ctx);
 }
+
+void vkvg_destroy (VkvgContext ctx)
+{
+	if (ctx->status)
+		return;
+
+	ctx->references--;
+	if (ctx->references > 0)
+		return;
+
+	LOG(VKVG_LOG_INFO, "DESTROY Context: ctx = %p (status:%d); surf = %p\n", ctx, ctx->status, ctx->pSurf);
+
+	VkvgDevice dev = ctx->dev;
+	bool deferred = dev->deferRelease;
+
+	if (deferred)
+		_flush_cmd_buff (ctx);
+	else
+		vkvg_flush (ctx);
+
+	LOG(VKVG_LOG_DBG_ARRAYS, "END\tctx = %p; pathes:%d pts:%d vch:%d vbo:%d ich:%d ibo:%d\n", ctx, ctx->sizePathes, ctx->sizePoints, ctx->sizeVertices, ctx->sizeVBO, ctx->sizeIndices, ctx->sizeIBO);
+
+#if VKVG_RECORDING
+	if (ctx->recording)
+		_destroy_recording(ctx->recording);
+#endif
+
+	//queued before releasing pattern and target so that their surfaces are deferred after it.
+	if (deferred)
+		_device_defer_context (ctx);
+
+	if (ctx->pattern)
+		vkvg_pattern_destroy (ctx->pattern);
+	ctx->pattern = NULL;
+
+	_clear_context (ctx);
+
+	vkvg_surface_destroy(ctx->pSurf);
+	ctx->pSurf = NULL;
+
+	if (deferred)
+		_device_release_deferred (dev, false);
+	else
+		_release_context (ctx);
+}
+void vkvg_set_target (VkvgContext ctx, VkvgSurface surf) {
+	if (ctx->status)
+		return;
+	if (!surf || surf->status || surf->dev != ctx->dev) {
+		ctx->status = VKVG_STATUS_INVALID_SURFACE;
+		return;
+	}
+
+	LOG(VKVG_LOG_INFO, "RETARGET Context: ctx = %p; surf = %p -> %p\n", ctx, ctx->pSurf, surf);
+
+	vkvg_flush (ctx);
+
+	if (ctx->pattern)
+		vkvg_pattern_destroy (ctx->pattern);
+
+	_clear_context (ctx);
+	_clear_saved_stencils (ctx);//sized on the previous target
+
+	//vulkan ressources and grown caches are kept, only the target dependent states are reset.
+	VkvgSurface prevSurf = ctx->pSurf;
+	ctx->pSurf = surf;
+	_init_ctx (ctx);
+	if (ctx->dsSrc)
+		_update_descriptor_set (ctx, ctx->dev->emptyImg, ctx->dsSrc);
+	_clear_path (ctx);
+
+	vkvg_surface_destroy (prevSurf);
+}
 void vkvg_set_opacity (VkvgContext ctx, float opacity) {
 	if (ctx->status)
 		return;
@@ -407,6 +456,8 @@ void vkvg_arc (VkvgContext ctx, float xc, float yc, float radius, float a1, floa
 	RECORD(ctx, VKVG_CMD_ARC, xc, yc, radius, a1, a2);
 	LOG(VKVG_LOG_INFO_CMD, "\tCMD: arc: %f,%f %f %f %f\n", xc, yc, radius, a1, a2);
 
+	uint32_t startPointCount = ctx->pointCount;
+
 	while (a2 < a1)//positive arc must have a1<a2
 		a2 += 2.f*M_PIF;
 
@@ -416,7 +467,6 @@ void vkvg_arc (VkvgContext ctx, float xc, float yc, float radius, float a1, floa
 	vec2 v = {cosf(a1)*radius + xc, sinf(a1)*radius + yc};
 
 	float step = _get_arc_step(ctx, radius);
-	float a = a1;
 
 	if (_current_path_is_empty(ctx)){
 		_set_curve_start (ctx);
@@ -431,29 +481,22 @@ void vkvg_arc (VkvgContext ctx, float xc, float yc, float radius, float a1, floa
 		ctx->simpleConvex = false;
 	}
 
-	a+=step;
-
 	if (EQUF(a2, a1))
 		return;
 
-	while(a < a2){
-		v.x = cosf(a)*radius + xc;
-		v.y = sinf(a)*radius + yc;
-		_add_point (ctx, v.x, v.y);
-		a+=step;
-	}
+	//intermediate points at a1 + k * step while lower than a2
+	_add_arc_points (ctx, (vec2){xc, yc}, radius, radius, NULL, a1, step, (uint32_t)ceilf ((a2 - a1) / step) - 1);
 
 	if (EQUF(a2-a1,M_PIF*2.f)){//if arc is complete circle, last point is the same as the first one
 		_set_curve_end(ctx);
 		vkvg_close_path(ctx);
+		if (radius > 0)
+			_set_sdf_shape (ctx, startPointCount, xc, yc, radius, radius, -1.0f);
 		return;
 	}
-	a = a2;
-	//vec2 lastP = v;
-	v.x = cosf(a)*radius + xc;
-	v.y = sinf(a)*radius + yc;
-	//if (!vec2_equ (v,lastP))//this test should not be required
-		_add_point (ctx, v.x, v.y);
+	v.x = cosf(a2)*radius + xc;
+	v.y = sinf(a2)*radius + yc;
+	_add_point (ctx, v.x, v.y);
 	_set_curve_end(ctx);
 }
 void vkvg_arc_negative (VkvgContext ctx, float xc, float yc, float radius, float a1, float a2) {
@@ -461,6 +504,9 @@ void vkvg_arc_negative (VkvgContext ctx, float xc, float yc, float radius, float
 		return;
 	RECORD(ctx, VKVG_CMD_ARC_NEG, xc, yc, radius, a1, a2);
 	LOG(VKVG_LOG_INFO_CMD, "\tCMD: %f,%f %f %f %f\n", xc, yc, radius, a1, a2);
+
+	uint32_t startPointCount = ctx->pointCount;
+
 	while (a2 > a1)
 		a2 -= 2.f*M_PIF;
 	if (a1 - a2 > a1 + 2.f * M_PIF) //limit arc to 2PI
@@ -469,7 +515,6 @@ void vkvg_arc_negative (VkvgContext ctx, float xc, float yc, float radius, float
 	vec2 v = {cosf(a1)*radius + xc, sinf(a1)*radius + yc};
 
 	float step = _get_arc_step(ctx, radius);
-	float a = a1;
 
 	if (_current_path_is_empty(ctx)){
 		_set_curve_start (ctx);
@@ -484,30 +529,22 @@ void vkvg_arc_negative (VkvgContext ctx, float xc, float yc, float radius, float
 		ctx->simpleConvex = false;
 	}
 
-	a-=step;
-
 	if (EQUF(a2, a1))
 		return;
 
-	while(a > a2){
-		v.x = cosf(a)*radius + xc;
-		v.y = sinf(a)*radius + yc;
-		_add_point (ctx,v.x,v.y);
-		a-=step;
-	}
+	_add_arc_points (ctx, (vec2){xc, yc}, radius, radius, NULL, a1, -step, (uint32_t)ceilf ((a1 - a2) / step) - 1);
 
 	if (EQUF(a1-a2,M_PIF*2.f)){//if arc is complete circle, last point is the same as the first one
 		_set_curve_end(ctx);
 		vkvg_close_path(ctx);
+		if (radius > 0)
+			_set_sdf_shape (ctx, startPointCount, xc, yc, radius, radius, -1.0f);
 		return;
 	}
 
-	a = a2;
-	//vec2 lastP = v;
-	v.x = cosf(a)*radius + xc;
-	v.y = sinf(a)*radius + yc;
-	//if (!vec2_equ (v,lastP))
-		_add_point (ctx, v.x, v.y);
+	v.x = cosf(a2)*radius + xc;
+	v.y = sinf(a2)*radius + yc;
+	_add_point (ctx, v.x, v.y);
 	_set_curve_end(ctx);
 }
 void vkvg_rel_move_to (VkvgContext ctx, float x, float y)
@@ -546,7 +583,7 @@ void vkvg_get_current_point (VkvgContext ctx, float* x, float* y) {
 	*y = cp.y;
 }
 void _curve_to (VkvgContext ctx, float x1, float y1, float x2, float y2, float x3, float y3) {
-	//prevent running _recursive_bezier when all 4 curve points are equal
+	//prevent flattening when all 4 curve points are equal
 	if (EQUF(x1,x2) && EQUF(x2,x3) && EQUF(y1,y2) && EQUF(y2,y3)) {
 		if (_current_path_is_empty(ctx) || (EQUF(_get_current_position(ctx).x,x1) && EQUF(_get_current_position(ctx).y,y1)))
 			return;
@@ -558,12 +595,7 @@ void _curve_to (VkvgContext ctx, float x1, float y1, float x2, float y2, float x
 
 	vec2 cp = _get_current_position(ctx);
 
-	//compute dyn distanceTolerance depending on current scale
-	float sx = 1, sy = 1;
-	vkvg_matrix_get_scale (&ctx->pushConsts.mat, &sx, &sy);
-	float distanceTolerance = fabs(0.25f / fmaxf(sx,sy));
-
-	_recursive_bezier (ctx, distanceTolerance, cp.x, cp.y, x1, y1, x2, y2, x3, y3, 0);
+	_flatten_cubic (ctx, cp, (vec2){x1, y1}, (vec2){x2, y2}, (vec2){x3, y3});
 	/*cp.x = x3;
 	cp.y = y3;
 	if (!vec2_equ(ctx->points[ctx->pointCount-1],cp))*/
@@ -623,7 +655,11 @@ void vkvg_fill_rectangle (VkvgContext ctx, float x, float y, float w, float h){
 	if (ctx->status)
 		return;
 	LOG(VKVG_LOG_INFO_CMD, "\tCMD: fill_rectangle:\n");
-	_vao_add_rectangle (ctx,x,y,w,h);
+	_add_rect_instance (ctx,x,y,w,h);
+	if (ctx->antialias == VKVG_ANTIALIAS_FRINGE) {
+		vec2 pts[] = {{x,y},{x+w,y},{x+w,y+h},{x,y+h}};
+		_add_aa_fringe (ctx, pts, 4, w * h > 0 ? 1.0f : -1.0f, _aa_fringe_width (ctx));
+	}
 	//_record_draw_cmd(ctx);
 }
 
@@ -659,6 +695,8 @@ vkvg_status_t vkvg_rounded_rectangle (VkvgContext ctx, float x, float y, float w
 	if ((radius > w / 2.0f) || (radius > h / 2.0f))
 		radius = fmin (w / 2.0f, h / 2.0f);
 
+	uint32_t startPointCount = ctx->pointCount;
+
 	vkvg_move_to(ctx, x, y + radius);
 	vkvg_arc(ctx, x + radius, y + radius, radius, M_PIF, -M_PIF_2);
 	vkvg_line_to(ctx, x + w - radius, y);
@@ -670,6 +708,9 @@ vkvg_status_t vkvg_rounded_rectangle (VkvgContext ctx, float x, float y, float w
 	vkvg_line_to(ctx, x, y + radius);
 	vkvg_close_path(ctx);
 
+	if (radius >= 0)
+		_set_sdf_shape (ctx, startPointCount, x + w / 2.0f, y + h / 2.0f, w / 2.0f, h / 2.0f, radius);
+
 	return VKVG_STATUS_SUCCESS;
 }
 void vkvg_rounded_rectangle2 (VkvgContext ctx, float x, float y, float w, float h, float rx, float ry){
@@ -777,9 +818,13 @@ void _clip_preserve (VkvgContext ctx){
 	vkh_cmd_label_start(ctx->cmd, "clip", DBG_LAB_COLOR_CLIP);
 #endif
 
-	if (ctx->curFillRule == VKVG_FILL_RULE_EVEN_ODD){
+	if (ctx->curFillRule == VKVG_FILL_RULE_EVEN_ODD && !(ctx->subpathCount == 1 && ctx->pathes[0] & PATH_IS_CONVEX_BIT)){
 		_poly_fill				(ctx, NULL);
 		CmdBindPipeline			(ctx->cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, ctx->dev->pipelineClipping);
+	}else if (_fill_non_zero_with_stencil (ctx)){
+		_poly_fill					(ctx, NULL);
+		_resolve_non_zero_stencil	(ctx, NULL);
+		CmdBindPipeline				(ctx->cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, ctx->dev->pipelineClipping);
 	}else{
 		CmdBindPipeline			(ctx->cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, ctx->dev->pipelineClipping);
 		CmdSetStencilReference	(ctx->cmd, VK_STENCIL_FRONT_AND_BACK, STENCIL_FILL_BIT);
@@ -811,14 +856,43 @@ void _fill_preserve (VkvgContext ctx){
 
 	LOG(VKVG_LOG_INFO, "FILL: ctx = %p; path cpt = %d;\n", ctx, ctx->subpathCount);
 
-	 if (ctx->curFillRule == VKVG_FILL_RULE_EVEN_ODD){
+	if (_path_is_axis_aligned_rect (ctx)) {//single rectangle fill rule agnostic
+		vec2* p = ctx->points;
+		_add_rect_instance (ctx, p[0].x, p[0].y, p[2].x - p[0].x, p[2].y - p[0].y);
+		if (ctx->antialias == VKVG_ANTIALIAS_FRINGE)
+			_fill_aa_fringe (ctx);
+		return;
+	}
+	if (_sdf_shape_drawable (ctx)) {//single circle, ellipse or rounded rectangle, fill rule agnostic
+		_add_sdf_instance (ctx, 0);
+		return;
+	}
+
+	if (ctx->curFillRule == VKVG_FILL_RULE_EVEN_ODD && ctx->subpathCount == 1) {
+		//fill rules are equivalent for a single convex or simple contour, no stencil pass is needed
+		if (ctx->vertCount - ctx->curVertOffset + ctx->pointCount > VKVG_IBO_MAX)
+			_emit_draw_cmd_undrawn_vertices(ctx);
+		if (ctx->pattern)
+			_ensure_renderpass_is_started(ctx);
+		if (_fill_convex (ctx) || _fill_monotone_cached (ctx)) {
+			if (ctx->antialias == VKVG_ANTIALIAS_FRINGE)
+				_fill_aa_fringe (ctx);
+			return;
+		}
+	}
+
+	if (ctx->curFillRule == VKVG_FILL_RULE_EVEN_ODD || _fill_non_zero_with_stencil (ctx)){
 		 _emit_draw_cmd_undrawn_vertices(ctx);
 		vec4 bounds = {FLT_MAX,FLT_MAX,FLT_MIN,FLT_MIN};
 		_poly_fill				(ctx, &bounds);
+		if (ctx->curFillRule == VKVG_FILL_RULE_NON_ZERO)
+			_resolve_non_zero_stencil (ctx, &bounds);
 		_bind_draw_pipeline		(ctx);
 		CmdSetStencilCompareMask(ctx->cmd, VK_STENCIL_FRONT_AND_BACK, STENCIL_FILL_BIT);
 		_draw_full_screen_quad	(ctx, &bounds);
 		CmdSetStencilCompareMask(ctx->cmd, VK_STENCIL_FRONT_AND_BACK, STENCIL_CLIP_BIT);
+		if (ctx->antialias == VKVG_ANTIALIAS_FRINGE)
+			_fill_aa_fringe (ctx);
 		return;
 	}
 
@@ -828,6 +902,8 @@ void _fill_preserve (VkvgContext ctx){
 	if (ctx->pattern)//if not solid color, source img or gradient has to be bound
 		_ensure_renderpass_is_started(ctx);
 	_fill_non_zero(ctx);
+	if (ctx->antialias == VKVG_ANTIALIAS_FRINGE)
+		_fill_aa_fringe (ctx);
 }
 void _stroke_preserve (VkvgContext ctx)
 {
@@ -838,6 +914,38 @@ void _stroke_preserve (VkvgContext ctx)
 
 	LOG(VKVG_LOG_INFO, "STROKE: ctx = %p; path ptr = %d;\n", ctx, ctx->pathPtr);
 
+	//sharp corners of rounded rectangles with a null radius are only matched by round joins. The ellipse distance
+	//is approximated away from its outline, so only circles are stroked with it.
+	if (ctx->dashCount == 0 && ctx->lineWidth > 0 && _sdf_shape_drawable (ctx) &&
+			(ctx->sdfShape.radius != 0 || ctx->lineJoin == VKVG_LINE_JOIN_ROUND) &&
+			(ctx->sdfShape.radius >= 0 || ctx->sdfShape.halfSize.x == ctx->sdfShape.halfSize.y)) {
+		_add_sdf_instance (ctx, ctx->lineWidth * 0.5f);
+		return;
+	}
+
+	//lines thinner than a pixel are drawn one pixel wide with a coverage reduced by their width, joins are beveled
+	float hairline = _hairline_width (ctx);
+	if (hairline > 0) {
+		_add_line_records (ctx, ctx->lineWidth * 0.5f / hairline, _scale_color_coverage (ctx->curColor, hairline),
+						   VKVG_LINE_JOIN_BEVEL);
+		return;
+	}
+
+	if (_gpu_stroke_drawable (ctx)) {
+		_add_line_records (ctx, ctx->lineWidth * 0.5f, ctx->curColor, ctx->lineJoin);
+		return;
+	}
+
+	_mesh_key_t key;
+	uint64_t hash;
+	if (_mesh_cache_draw (ctx, vkvg_mesh_stroke, &key, &hash)) {
+		if (ctx->antialias == VKVG_ANTIALIAS_FRINGE)
+			_stroke_aa_fringe (ctx);
+		return;
+	}
+	//stroke is cached only if it has been built in a single batch
+	uint32_t firstVert = ctx->vertCount, firstInd = ctx->indCount, vertexDraws = ctx->vertexDraws;
+
 	stroke_context_t str = {0};
 	str.hw = ctx->lineWidth * 0.5f;
 	str.lhMax = ctx->miterLimit * ctx->lineWidth;
@@ -898,8 +1006,11 @@ void _stroke_preserve (VkvgContext ctx)
 					break;
 				}
 			}
-		}else while (str.cp < lastPathPointIdx)
-			_draw_segment(ctx, &str, &dc, false);
+		}else if (ctx->dashCount > 0) {
+			while (str.cp < lastPathPointIdx)
+				_draw_segment(ctx, &str, &dc, false);
+		}else
+			_draw_polyline(ctx, &str, lastPathPointIdx);
 
 		if (ctx->dashCount > 0) {
 			if (_path_is_closed(ctx,ptrPath)){
@@ -951,6 +1062,11 @@ void _stroke_preserve (VkvgContext ctx)
 			_emit_draw_cmd_undrawn_vertices (ctx);
 	}
 
+	if (ctx->vertexDraws == vertexDraws)
+		_mesh_cache_store (ctx, &key, hash, firstVert, firstInd);
+
+	if (ctx->antialias == VKVG_ANTIALIAS_FRINGE)
+		_stroke_aa_fringe (ctx);
 }
 
 void vkvg_clip (VkvgContext ctx){
@@ -1005,6 +1121,7 @@ void vkvg_paint (VkvgContext ctx){
 		return;
 	}
 
+	_emit_draw_cmd_undrawn_vertices (ctx);
 	_ensure_renderpass_is_started (ctx);
 	_draw_full_screen_quad (ctx, NULL);
 }
@@ -1097,6 +1214,39 @@ vkvg_fill_rule_t vkvg_get_fill_rule (VkvgContext ctx){
 		return VKVG_FILL_RULE_NON_ZERO;
 	return ctx->curFillRule;
 }
+void vkvg_set_antialias (VkvgContext ctx, vkvg_antialias_t antialias){
+	if (ctx->status)
+		return;
+	RECORD(ctx, VKVG_CMD_SET_ANTIALIAS, antialias);
+	ctx->antialias = antialias;
+}
+vkvg_antialias_t vkvg_get_antialias (VkvgContext ctx){
+	if (ctx->status)
+		return VKVG_ANTIALIAS_DEFAULT;
+	return ctx->antialias;
+}
+void vkvg_set_tolerance (VkvgContext ctx, float tolerance){
+	if (ctx->status || isnan(tolerance))
+		return;
+	RECORD(ctx, VKVG_CMD_SET_TOLERANCE, tolerance);
+	ctx->tolerance = fmaxf (tolerance, VKVG_TOLERANCE_MIN);
+}
+float vkvg_get_tolerance (VkvgContext ctx){
+	if (ctx->status)
+		return VKVG_TOLERANCE_DEFAULT;
+	return ctx->tolerance;
+}
+void vkvg_set_stroke_mode (VkvgContext ctx, vkvg_stroke_mode_t mode){
+	if (ctx->status)
+		return;
+	RECORD(ctx, VKVG_CMD_SET_STROKE_MODE, mode);
+	ctx->strokeMode = mode;
+}
+vkvg_stroke_mode_t vkvg_get_stroke_mode (VkvgContext ctx){
+	if (ctx->status)
+		return VKVG_STROKE_MODE_TESSELLATED;
+	return ctx->strokeMode;
+}
 float vkvg_get_line_width (VkvgContext ctx){
 	if (ctx->status)
 		return 0;
@@ -1277,9 +1427,9 @@ void vkvg_save (VkvgContext ctx){
 	if (ctx->curClipState == vkvg_clip_state_clip) {
 		sav->clippingState = vkvg_clip_state_clip_saved;
 
-		uint8_t curSaveStencil = ctx->curSavBit / 6;
+		uint8_t curSaveStencil = ctx->curSavBit / STENCIL_SAVE_COUNT;
 
-		if (ctx->curSavBit > 0 && ctx->curSavBit % 6 == 0){//new save/restore stencil image have to be created
+		if (ctx->curSavBit > 0 && ctx->curSavBit % STENCIL_SAVE_COUNT == 0){//new save/restore stencil image have to be created
 			VkhImage* savedStencilsPtr = NULL;
 			if (savedStencilsPtr)
 				savedStencilsPtr = (VkhImage*)realloc(ctx->savedStencils, curSaveStencil * sizeof(VkhImage));
@@ -1291,10 +1441,13 @@ void vkvg_save (VkvgContext ctx){
 				return;
 			}
 			ctx->savedStencils = savedStencilsPtr;
+			_device_reserve_memory (dev, VKVG_MEMORY_ATTACHMENTS,
+									_device_image_size (dev->stencilFormat, dev->samples, ctx->pSurf->width, ctx->pSurf->height, 1));
 			VkhImage savStencil = vkh_image_ms_create ((VkhDevice)dev, dev->stencilFormat, dev->samples, ctx->pSurf->width, ctx->pSurf->height,
 									VMA_MEMORY_USAGE_GPU_ONLY, VK_IMAGE_USAGE_TRANSFER_SRC_BIT|VK_IMAGE_USAGE_TRANSFER_DST_BIT);
 			ctx->savedStencils[curSaveStencil-1] = savStencil;
 
+			_ensure_cmd_ressources (ctx);
 			vkh_cmd_begin (ctx->cmd, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
 			ctx->cmdStarted = true;
 
@@ -1329,7 +1482,7 @@ void vkvg_save (VkvgContext ctx){
 			_wait_and_submit_cmd(ctx);
 		}
 
-		uint8_t curSaveBit = 1 << (ctx->curSavBit % 6 + 2);
+		uint8_t curSaveBit = 1 << (ctx->curSavBit % STENCIL_SAVE_COUNT + STENCIL_SAVE_SHIFT);
 
 		_start_cmd_for_render_pass (ctx);
 
@@ -1369,6 +1522,9 @@ void vkvg_save (VkvgContext ctx){
 	sav->lineCap	= ctx->lineCap;
 	sav->lineWidth	= ctx->lineWidth;
 	sav->curFillRule= ctx->curFillRule;
+	sav->antialias	= ctx->antialias;
+	sav->tolerance	= ctx->tolerance;
+	sav->strokeMode	= ctx->strokeMode;
 
 	sav->selectedCharSize = ctx->selectedCharSize;
 	strcpy (sav->selectedFontName, ctx->selectedFontName);
@@ -1414,7 +1570,7 @@ void vkvg_restore (VkvgContext ctx){
 			_reset_clip (ctx);
 		} else {
 
-			uint8_t curSaveBit = 1 << ((ctx->curSavBit-1) % 6 + 2);
+			uint8_t curSaveBit = 1 << ((ctx->curSavBit-1) % STENCIL_SAVE_COUNT + STENCIL_SAVE_SHIFT);
 
 			_start_cmd_for_render_pass (ctx);
 
@@ -1445,10 +1601,11 @@ void vkvg_restore (VkvgContext ctx){
 	if (sav->clippingState == vkvg_clip_state_clip_saved) {
 		ctx->curSavBit--;
 
-		uint8_t curSaveStencil = ctx->curSavBit / 6;
-		if (ctx->curSavBit > 0 && ctx->curSavBit % 6 == 0){//addtional save/restore stencil image have to be copied back to surf stencil first
+		uint8_t curSaveStencil = ctx->curSavBit / STENCIL_SAVE_COUNT;
+		if (ctx->curSavBit > 0 && ctx->curSavBit % STENCIL_SAVE_COUNT == 0){//addtional save/restore stencil image have to be copied back to surf stencil first
 			VkhImage savStencil = ctx->savedStencils[curSaveStencil-1];
 
+			_ensure_cmd_ressources (ctx);
 			vkh_cmd_begin (ctx->cmd, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
 			ctx->cmdStarted = true;
 
@@ -1483,6 +1640,9 @@ void vkvg_restore (VkvgContext ctx){
 			if (!_wait_flush_fence (ctx))
 				return;
 			vkh_image_destroy (savStencil);
+			_device_release_memory (ctx->dev, VKVG_MEMORY_ATTACHMENTS,
+									_device_image_size (ctx->dev->stencilFormat, ctx->dev->samples,
+														ctx->renderPassBeginInfo.renderArea.extent.width, ctx->renderPassBeginInfo.renderArea.extent.height, 1));
 		}
 	}
 
@@ -1503,6 +1663,9 @@ void vkvg_restore (VkvgContext ctx){
 	ctx->lineCap	= sav->lineCap;
 	ctx->lineJoin	= sav->lineJoint;
 	ctx->curFillRule= sav->curFillRule;
+	ctx->antialias	= sav->antialias;
+	ctx->tolerance	= sav->tolerance;
+	ctx->strokeMode	= sav->strokeMode;
 
 	ctx->selectedCharSize = sav->selectedCharSize;
 	strcpy (ctx->selectedFontName, sav->selectedFontName);
@@ -1631,6 +1794,7 @@ void vkvg_ellipse (VkvgContext ctx, float radiusX, float radiusY, float x, float
 	float bottomLeftY = bottomCenterY - dy2;
 
 	_finish_path(ctx);
+	uint32_t startPointCount = ctx->pointCount;
 	_add_point (ctx, bottomCenterX, bottomCenterY);
 
 	_curve_to (ctx, bottomRightX, bottomRightY, topRightX, topRightY, topCenterX, topCenterY);
@@ -1638,6 +1802,9 @@ void vkvg_ellipse (VkvgContext ctx, float radiusX, float radiusY, float x, float
 
 	ctx->pathes[ctx->pathPtr] |= PATH_CLOSED_BIT;
 	_finish_path(ctx);
+
+	if (rotationAngle == 0 && radiusX > 0 && radiusY > 0)
+		_set_sdf_shape (ctx, startPointCount, x, y, radiusX, radiusY, -1.0f);
 }
 
 VkvgSurface vkvg_get_target (VkvgContext ctx) {
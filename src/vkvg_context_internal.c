@@ -95,9 +95,14 @@ void _check_index_cache_size (VkvgContext ctx) {
 }
 //check host path array size, return true if error. pathPtr is already incremented
 bool _check_pathes_array (VkvgContext ctx){
-	if (ctx->sizePathes - ctx->pathPtr - ctx->segmentPtr > VKVG_ARRAY_THRESHOLD)
+	return _ensure_pathes_array (ctx, 0);
+}
+//grow host path array so that 'count' elements may be added after the current path and its segments, return true if error
+bool _ensure_pathes_array (VkvgContext ctx, uint32_t count){
+	if (ctx->sizePathes - VKVG_ARRAY_THRESHOLD > ctx->pathPtr + ctx->segmentPtr + count)
 		return false;
-	ctx->sizePathes += VKVG_PATHES_SIZE;
+	while (ctx->sizePathes - VKVG_ARRAY_THRESHOLD <= ctx->pathPtr + ctx->segmentPtr + count)
+		ctx->sizePathes += VKVG_PATHES_SIZE;
 	uint32_t* tmp = (uint32_t*) realloc (ctx->pathes, (size_t)ctx->sizePathes * sizeof(uint32_t));
 	LOG(VKVG_LOG_DBG_ARRAYS, "resize PATH: new size: %u Ptr: %p -> %p\n", ctx->sizePathes, ctx->pathes, tmp);
 	if (tmp == NULL){
@@ -111,9 +116,14 @@ bool _check_pathes_array (VkvgContext ctx){
 }
 //check host point array size, return true if error
 bool _check_point_array (VkvgContext ctx){
-	if (ctx->sizePoints - VKVG_ARRAY_THRESHOLD > ctx->pointCount)
+	return _ensure_point_array (ctx, 0);
+}
+//grow host point array so that 'count' points may be added after the current ones, return true if error
+bool _ensure_point_array (VkvgContext ctx, uint32_t count){
+	if (ctx->sizePoints - VKVG_ARRAY_THRESHOLD > ctx->pointCount + count)
 		return false;
-	ctx->sizePoints += VKVG_PTS_SIZE;
+	while (ctx->sizePoints - VKVG_ARRAY_THRESHOLD <= ctx->pointCount + count)
+		ctx->sizePoints += VKVG_PTS_SIZE;
 	vec2* tmp = (vec2*) realloc (ctx->points, (size_t)ctx->sizePoints * sizeof(vec2));
 	LOG(VKVG_LOG_DBG_ARRAYS, "resize Points: new size(point): %u Ptr: %p -> %p\n", ctx->sizePoints, ctx->points, tmp);
 	if (tmp == NULL){
@@ -125,6 +135,75 @@ bool _check_point_array (VkvgContext ctx){
 	ctx->points = tmp;
 	return false;
 }
+//smallest size multiple of granularity keeping count under the array threshold
+uint32_t _trimmed_size (uint32_t count, uint32_t granularity) {
+	uint32_t n = count + VKVG_ARRAY_THRESHOLD + 1;
+	return ((n + granularity - 1) / granularity) * granularity;
+}
+//shrink host arrays and vk buffers to the high-water marks of the last trim period, or to the
+//current usage if force is true. Without force, arrays are only reduced if they are at least twice
+//as large as needed to prevent reallocation thrashing.
+void _trim_caches (VkvgContext ctx, bool force) {
+	uint32_t vxCount	= force ? ctx->vertCount	: MAX(ctx->hwmVertices, ctx->vertCount);
+	uint32_t idxCount	= force ? ctx->indCount		: MAX(ctx->hwmIndices, ctx->indCount);
+	uint32_t ptsCount	= force ? ctx->pointCount	: MAX(ctx->hwmPoints, ctx->pointCount);
+	uint32_t pathCount	= ctx->pathPtr + ctx->segmentPtr;
+	if (!force)
+		pathCount = MAX(ctx->hwmPathes, pathCount);
+
+	uint32_t newSize = _trimmed_size (vxCount, VKVG_VBO_SIZE);
+	if (newSize < ctx->sizeVertices && (force || newSize * 2 <= ctx->sizeVertices))
+		_resize_vertex_cache (ctx, newSize);
+	newSize = _trimmed_size (idxCount, VKVG_IBO_SIZE);
+	if (newSize < ctx->sizeIndices && (force || newSize * 2 <= ctx->sizeIndices))
+		_resize_index_cache (ctx, newSize);
+
+	newSize = _trimmed_size (ptsCount, VKVG_PTS_SIZE);
+	if (newSize < ctx->sizePoints && (force || newSize * 2 <= ctx->sizePoints)) {
+		vec2* tmp = (vec2*) realloc (ctx->points, (size_t)newSize * sizeof(vec2));
+		if (tmp) {
+			ctx->points = tmp;
+			ctx->sizePoints = newSize;
+		}
+	}
+	newSize = _trimmed_size (pathCount, VKVG_PATHES_SIZE);
+	if (newSize < ctx->sizePathes && (force || newSize * 2 <= ctx->sizePathes)) {
+		uint32_t* tmp = (uint32_t*) realloc (ctx->pathes, (size_t)newSize * sizeof(uint32_t));
+		if (tmp) {
+			ctx->pathes = tmp;
+			ctx->sizePathes = newSize;
+		}
+	}
+
+	if (force) {
+		tess_arena_free (&ctx->tessArena);
+		tess_arena_free (&ctx->outlineArena);
+	}
+
+	//not yet created vk buffers will use the new sizes. Existing ones may still be read by the last submitted cmd,
+	//they are shrunk by _trim_vk_buffers once it is completed, right now if forced after a wait on its fence.
+	if (!ctx->vertices.buffer) {
+		ctx->sizeVBO = MIN(ctx->sizeVBO, _trimmed_size (vxCount, VKVG_VBO_SIZE));
+		ctx->sizeIBO = MIN(ctx->sizeIBO, _trimmed_size (idxCount, VKVG_IBO_SIZE));
+	} else {
+		newSize = _trimmed_size (vxCount, VKVG_VBO_SIZE);
+		if (newSize < ctx->sizeVBO && (force || newSize * 2 <= ctx->sizeVBO))
+			ctx->trimVBO = newSize;
+		newSize = _trimmed_size (idxCount, VKVG_IBO_SIZE);
+		if (newSize < ctx->sizeIBO && (force || newSize * 2 <= ctx->sizeIBO))
+			ctx->trimIBO = newSize;
+		if (force && !ctx->cmdStarted)
+			_trim_vk_buffers (ctx);
+	}
+
+	LOG(VKVG_LOG_DBG_ARRAYS, "TRIM\tctx = %p; pathes:%u pts:%u vch:%u vbo:%u ich:%u ibo:%u\n", ctx, ctx->sizePathes, ctx->sizePoints, ctx->sizeVertices, ctx->sizeVBO, ctx->sizeIndices, ctx->sizeIBO);
+
+	ctx->flushCount = 0;
+	ctx->hwmVertices = ctx->vertCount;
+	ctx->hwmIndices = ctx->indCount;
+	ctx->hwmPoints = ctx->pointCount;
+	ctx->hwmPathes = ctx->pathPtr + ctx->segmentPtr;
+}
 bool _current_path_is_empty (VkvgContext ctx) {
 	return ctx->pathes [ctx->pathPtr] == 0;
 }
@@ -174,8 +253,9 @@ void _finish_path (VkvgContext ctx){
 
 	LOG(VKVG_LOG_INFO_PATH, "PATH: points count=%10d\n", ctx->pathes[ctx->pathPtr]&PATH_ELT_MASK);
 
-	if (ctx->pathPtr == 0 && ctx->simpleConvex)
-		ctx->pathes[0] |= PATH_IS_CONVEX_BIT;
+	if ((ctx->pathPtr == 0 && ctx->simpleConvex) || _path_is_convex (ctx))
+		ctx->pathes[ctx->pathPtr] |= PATH_IS_CONVEX_BIT;
+	ctx->windingBound += _path_winding_bound (ctx);
 
 	if (ctx->segmentPtr > 0) {
 		ctx->pathes[ctx->pathPtr] |= PATH_HAS_CURVES_BIT;
@@ -197,12 +277,18 @@ void _finish_path (VkvgContext ctx){
 }
 //clear path datas in context
 void _clear_path (VkvgContext ctx){
+	if (ctx->pointCount > ctx->hwmPoints)
+		ctx->hwmPoints = ctx->pointCount;
+	if (ctx->pathPtr + ctx->segmentPtr > ctx->hwmPathes)
+		ctx->hwmPathes = ctx->pathPtr + ctx->segmentPtr;
 	ctx->pathPtr = 0;
 	ctx->pathes [ctx->pathPtr] = 0;
 	ctx->pointCount = 0;
 	ctx->segmentPtr = 0;
 	ctx->subpathCount = 0;
+	ctx->windingBound = 0;
 	ctx->simpleConvex = false;
+	ctx->sdfShape.pointCount = 0;
 }
 void _remove_last_point (VkvgContext ctx){
 	ctx->pathes[ctx->pathPtr]--;
@@ -220,6 +306,36 @@ void _remove_last_point (VkvgContext ctx){
 bool _path_is_closed (VkvgContext ctx, uint32_t ptrPath){
 	return ctx->pathes[ptrPath] & PATH_CLOSED_BIT;
 }
+//track turn direction and direction changes of the subpath edges
+static void _convexity_add_edge (_convexity_t* cv, vec2 e) {
+	if (e.x == 0 && e.y == 0)
+		return;
+	if (cv->edgeCount++ == 0)
+		cv->firstEdge = e;
+	else if (cv->convex) {
+		float cross = vec2_det (cv->lastEdge, e);
+		if (cross == 0) {
+			if (vec2_dot (cv->lastEdge, e) < 0)
+				cv->convex = false;//going backward
+		} else {
+			int8_t turn = cross > 0 ? 1 : -1;
+			if (cv->turn == 0)
+				cv->turn = turn;
+			else if (cv->turn != turn)
+				cv->convex = false;
+		}
+	}
+	float d[] = {e.x, e.y};
+	for (int i = 0; i < 2; i++) {
+		int8_t dir = d[i] > 0 ? 1 : d[i] < 0 ? -1 : 0;
+		if (dir == 0)
+			continue;
+		if (cv->lastDir[i] != 0 && cv->lastDir[i] != dir && ++cv->dirChanges[i] > 2)
+			cv->convex = false;
+		cv->lastDir[i] = dir;
+	}
+	cv->lastEdge = e;
+}
 void _add_point (VkvgContext ctx, float x, float y){
 	if (_check_point_array(ctx))
 		return;
@@ -237,6 +353,71 @@ void _add_point (VkvgContext ctx, float x, float y){
 	ctx->pathes[ctx->pathPtr]++;//total point count in path
 	if (ctx->segmentPtr > 0)
 		ctx->pathes[ctx->pathPtr + ctx->segmentPtr]++;//total point count in path's segment
+
+	if ((ctx->pathes[ctx->pathPtr] & PATH_ELT_MASK) == 1) {
+		_convexity_t cv = {.convex = true};
+		ctx->convexity = cv;
+	} else
+		_convexity_add_edge (&ctx->convexity, vec2_sub (v, ctx->points[ctx->pointCount - 2]));
+}
+//add 'count' points of the ellipse of center 'c' and radii 'rx','ry' rotated by 'm' (axis aligned if NULL), at angles
+//a + step, a + 2 * step, ... . Successive points are computed with a rotation recurrence in double precision
+//instead of evaluating cos and sin for each of them, and the point array is grown only once.
+void _add_arc_points (VkvgContext ctx, vec2 c, float rx, float ry, const mat2* m, double a, double step, uint32_t count){
+	if (count == 0 || isnan(c.x) || isnan(c.y) || isnan(rx) || isnan(ry))
+		return;
+	if (_ensure_point_array (ctx, count))
+		return;
+	LOG(VKVG_LOG_INFO_PTS, "_add_arc_points: %u points from %f step %f\n", count, a, step);
+
+	double cs = cos (step), sn = sin (step);
+	double x = cos (a), y = sin (a);
+	vec2* pts = &ctx->points[ctx->pointCount];
+
+	if ((ctx->pathes[ctx->pathPtr] & PATH_ELT_MASK) == 0) {
+		//first point of the subpath resets convexity tracking
+		_convexity_t cv = {.convex = true};
+		ctx->convexity = cv;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		double nx = x * cs - y * sn;
+		y = x * sn + y * cs;
+		x = nx;
+		vec2 p = {(float)(x * rx), (float)(y * ry)};
+		if (m)
+			p = mat2_mult_vec2 (*m, p);
+		pts[i] = vec2_add (p, c);
+	}
+	for (uint32_t i = (ctx->pathes[ctx->pathPtr] & PATH_ELT_MASK) ? 0 : 1; i < count; i++)
+		_convexity_add_edge (&ctx->convexity, vec2_sub (pts[i], pts[(int32_t)i - 1]));
+
+	ctx->pointCount += count;
+	ctx->pathes[ctx->pathPtr] += count;
+	if (ctx->segmentPtr > 0)
+		ctx->pathes[ctx->pathPtr + ctx->segmentPtr] += count;
+}
+//close the current subpath for the convexity test, it is always implicitly closed when filled.
+bool _path_is_convex (VkvgContext ctx) {
+	_convexity_t cv = ctx->convexity;
+	if (!cv.convex)
+		return false;
+	uint32_t pathPointCount = ctx->pathes[ctx->pathPtr] & PATH_ELT_MASK;
+	_convexity_add_edge (&cv, vec2_sub (ctx->points[ctx->pointCount - pathPointCount], ctx->points[ctx->pointCount - 1]));
+	//turn from closing edge to first edge, and direction changes between them
+	_convexity_add_edge (&cv, cv.firstEdge);
+	return cv.convex && cv.turn != 0 && cv.edgeCount > 3;
+}
+//upper bound of the winding number of the current subpath around any point. A horizontal line through a point the
+//contour winds n times around is crossed at least 2n times, with a y extremum between two crossings, so the closed
+//contour has at least 2n y direction changes, and as many x ones.
+uint32_t _path_winding_bound (VkvgContext ctx) {
+	_convexity_t cv = ctx->convexity;
+	uint32_t pathPointCount = ctx->pathes[ctx->pathPtr] & PATH_ELT_MASK;
+	_convexity_add_edge (&cv, vec2_sub (ctx->points[ctx->pointCount - pathPointCount], ctx->points[ctx->pointCount - 1]));
+	_convexity_add_edge (&cv, cv.firstEdge);
+	//closed contours have an even count, a change before a first edge null on an axis is missed
+	uint32_t changes = MIN (cv.dirChanges[0], cv.dirChanges[1]);
+	return (changes + 1) / 2;
 }
 float _normalizeAngle(float a)
 {
@@ -245,13 +426,14 @@ float _normalizeAngle(float a)
 		res += 2.0f * M_PIF;
 	return res;
 }
+//angle step keeping chords of an arc of the given radius within tolerance of the arc on screen
 float _get_arc_step (VkvgContext ctx, float radius) {
 	float sx, sy;
 	vkvg_matrix_get_scale (&ctx->pushConsts.mat, &sx, &sy);
-	float r = radius * fabsf(fmaxf(sx,sy));
-	if (r < 30.0f)
-		return fminf(M_PIF / 3.f, M_PIF / r);
-	return fminf(M_PIF / 3.f,M_PIF / (r * 0.4f));
+	float r = radius * fmaxf (fabsf (sx), fabsf (sy));
+	if (!(r > ctx->tolerance))
+		return M_PIF / 3.f;
+	return fmaxf (VKVG_ARC_MIN_STEP, fminf (M_PIF / 3.f, 2.f * acosf (1.f - ctx->tolerance / r)));
 }
 void _create_gradient_buff (VkvgContext ctx){
 	vkvg_buffer_create (ctx->dev,
@@ -259,15 +441,38 @@ void _create_gradient_buff (VkvgContext ctx){
 		VMA_MEMORY_USAGE_CPU_TO_GPU,
 		sizeof(vkvg_gradient_t), &ctx->uboGrad);
 }
-void _create_vertices_buff (VkvgContext ctx){
-	vkvg_buffer_create (ctx->dev,
-		VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-		VMA_MEMORY_USAGE_CPU_TO_GPU,
-		ctx->sizeVBO * sizeof(Vertex), &ctx->vertices);
-	vkvg_buffer_create (ctx->dev,
-		VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-		VMA_MEMORY_USAGE_CPU_TO_GPU,
-		ctx->sizeIBO * sizeof(VKVG_IBO_INDEX_TYPE), &ctx->indices);
+//vbo and ibo are created on first draw, or directly with the requested size on first resize.
+void _ensure_vertices_buff (VkvgContext ctx){
+	if (!ctx->vertices.buffer)
+		vkvg_buffer_create (ctx->dev,
+			VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+			VMA_MEMORY_USAGE_CPU_TO_GPU,
+			ctx->sizeVBO * sizeof(Vertex), &ctx->vertices);
+	if (!ctx->indices.buffer)
+		vkvg_buffer_create (ctx->dev,
+			VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+			VMA_MEMORY_USAGE_CPU_TO_GPU,
+			ctx->sizeIBO * sizeof(VKVG_IBO_INDEX_TYPE), &ctx->indices);
+#if defined(DEBUG) && defined (VKVG_DBG_UTILS)
+	vkh_device_set_object_name((VkhDevice)ctx->dev, VK_OBJECT_TYPE_BUFFER, (uint64_t)ctx->indices.buffer, "CTX Index Buff");
+	vkh_device_set_object_name((VkhDevice)ctx->dev, VK_OBJECT_TYPE_BUFFER, (uint64_t)ctx->vertices.buffer, "CTX Vertex Buff");
+#endif
+}
+//shrink vk buffers to the sizes of the last trim check if the last submitted cmd is completed, so that
+//resizing never waits. It has to be called before a cmd is started, while buffers are not bound.
+void _trim_vk_buffers (VkvgContext ctx) {
+	if (!ctx->trimVBO && !ctx->trimIBO)
+		return;
+	if (ctx->flushFence && vkGetFenceStatus (ctx->dev->vkDev, ctx->flushFence) != VK_SUCCESS)
+		return;
+	//caches may already hold vertices for the next cmd
+	uint32_t newSize = MAX(ctx->trimVBO, _trimmed_size (ctx->vertCount, VKVG_VBO_SIZE));
+	if (ctx->trimVBO && newSize < ctx->sizeVBO)
+		_resize_vbo (ctx, newSize);
+	newSize = MAX(ctx->trimIBO, _trimmed_size (ctx->indCount, VKVG_IBO_SIZE));
+	if (ctx->trimIBO && newSize < ctx->sizeIBO)
+		_resize_ibo (ctx, newSize);
+	ctx->trimVBO = ctx->trimIBO = 0;
 }
 void _resize_vbo (VkvgContext ctx, uint32_t new_size) {
 	if (!_wait_flush_fence (ctx))//wait previous cmd if not completed
@@ -278,7 +483,8 @@ void _resize_vbo (VkvgContext ctx, uint32_t new_size) {
 	if (mod > 0)
 		ctx->sizeVBO += VKVG_VBO_SIZE - mod;
 	LOG(VKVG_LOG_DBG_ARRAYS, "%d\n", ctx->sizeVBO);
-	vkvg_buffer_destroy (&ctx->vertices);
+	if (ctx->vertices.buffer)
+		vkvg_buffer_destroy (&ctx->vertices);
 	vkvg_buffer_create (ctx->dev,
 		VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
 		VMA_MEMORY_USAGE_CPU_TO_GPU,
@@ -292,7 +498,8 @@ void _resize_ibo (VkvgContext ctx, size_t new_size) {
 	if (mod > 0)
 		ctx->sizeIBO += VKVG_IBO_SIZE - mod;
 	LOG(VKVG_LOG_DBG_ARRAYS, "resize IBO: new size: %d\n", ctx->sizeIBO);
-	vkvg_buffer_destroy (&ctx->indices);
+	if (ctx->indices.buffer)
+		vkvg_buffer_destroy (&ctx->indices);
 	vkvg_buffer_create (ctx->dev,
 		VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
 		VMA_MEMORY_USAGE_CPU_TO_GPU,
@@ -303,8 +510,7 @@ void _add_vertexf (VkvgContext ctx, float x, float y){
 	pVert->pos.x = x;
 	pVert->pos.y = y;
 	pVert->color = ctx->curColor;
-	pVert->uv.z = -1;
-	LOG(VKVG_LOG_INFO_VBO, "Add Vertexf %10d: pos:(%10.4f, %10.4f) uv:(%10.4f,%10.4f,%10.4f) color:0x%.8x \n", ctx->vertCount, pVert->pos.x, pVert->pos.y, pVert->uv.x, pVert->uv.y, pVert->uv.z, pVert->color);
+	LOG(VKVG_LOG_INFO_VBO, "Add Vertexf %10d: pos:(%10.4f, %10.4f) color:0x%.8x \n", ctx->vertCount, pVert->pos.x, pVert->pos.y, pVert->color);
 	ctx->vertCount++;
 	_check_vertex_cache_size(ctx);
 }
@@ -313,19 +519,29 @@ void _add_vertexf_unchecked (VkvgContext ctx, float x, float y){
 	pVert->pos.x = x;
 	pVert->pos.y = y;
 	pVert->color = ctx->curColor;
-	pVert->uv.z = -1;
-	LOG(VKVG_LOG_INFO_VBO, "Add Vertexf %10d: pos:(%10.4f, %10.4f) uv:(%10.4f,%10.4f,%10.4f) color:0x%.8x \n", ctx->vertCount, pVert->pos.x, pVert->pos.y, pVert->uv.x, pVert->uv.y, pVert->uv.z, pVert->color);
+	LOG(VKVG_LOG_INFO_VBO, "Add Vertexf %10d: pos:(%10.4f, %10.4f) color:0x%.8x \n", ctx->vertCount, pVert->pos.x, pVert->pos.y, pVert->color);
 	ctx->vertCount++;
 }
 void _add_vertex(VkvgContext ctx, Vertex v){
 	ctx->vertexCache[ctx->vertCount] = v;
-	LOG(VKVG_LOG_INFO_VBO, "Add Vertex  %10d: pos:(%10.4f, %10.4f) uv:(%10.4f,%10.4f,%10.4f) color:0x%.8x \n", ctx->vertCount, v.pos.x, v.pos.y, v.uv.x, v.uv.y, v.uv.z, v.color);
+	LOG(VKVG_LOG_INFO_VBO, "Add Vertex  %10d: pos:(%10.4f, %10.4f) color:0x%.8x \n", ctx->vertCount, v.pos.x, v.pos.y, v.color);
 	ctx->vertCount++;
 	_check_vertex_cache_size(ctx);
 }
+void _add_vertex_unchecked (VkvgContext ctx, Vertex v){
+	ctx->vertexCache[ctx->vertCount] = v;
+	LOG(VKVG_LOG_INFO_VBO, "Add Vertex  %10d: pos:(%10.4f, %10.4f) color:0x%.8x \n", ctx->vertCount, v.pos.x, v.pos.y, v.color);
+	ctx->vertCount++;
+}
 void _set_vertex(VkvgContext ctx, uint32_t idx, Vertex v){
 	ctx->vertexCache[idx] = v;
 }
+void _add_glyph_instance (VkvgContext ctx, GlyphInstance g){
+	memcpy (&ctx->vertexCache[ctx->vertCount], &g, sizeof(GlyphInstance));
+	LOG(VKVG_LOG_INFO_VBO, "Add Glyph   %10d: pos:(%10.4f, %10.4f) size:(%d, %d) texel:(%d, %d) page:%f color:0x%.8x \n", ctx->vertCount, g.pos.x, g.pos.y, g.size.x, g.size.y, g.texel.x, g.texel.y, g.page, g.color);
+	ctx->vertCount += sizeof(GlyphInstance) / sizeof(Vertex);
+	_check_vertex_cache_size(ctx);
+}
 #ifdef VKVG_FILL_NZ_GLUTESS
 void _add_indice (VkvgContext ctx, VKVG_IBO_INDEX_TYPE i) {
 	ctx->indexCache[ctx->indCount++] = i;
@@ -367,6 +583,18 @@ void _add_tri_indices_for_rect (VkvgContext ctx, VKVG_IBO_INDEX_TYPE i){
 	_check_index_cache_size(ctx);
 	LOG(VKVG_LOG_INFO_IBO, "Rectangle IDX: %d %d %d | %d %d %d (count=%d)\n", inds[0], inds[1], inds[2], inds[3], inds[4], inds[5], ctx->indCount);
 }
+void _add_tri_indices_for_rect_unchecked (VkvgContext ctx, VKVG_IBO_INDEX_TYPE i){
+	VKVG_IBO_INDEX_TYPE* inds = &ctx->indexCache[ctx->indCount];
+	inds[0] = i;
+	inds[1] = i+2;
+	inds[2] = i+1;
+	inds[3] = i+1;
+	inds[4] = i+2;
+	inds[5] = i+3;
+	ctx->indCount+=6;
+
+	LOG(VKVG_LOG_INFO_IBO, "Rectangle IDX: %d %d %d | %d %d %d (count=%d)\n", inds[0], inds[1], inds[2], inds[3], inds[4], inds[5], ctx->indCount);
+}
 void _add_triangle_indices(VkvgContext ctx, VKVG_IBO_INDEX_TYPE i0, VKVG_IBO_INDEX_TYPE i1, VKVG_IBO_INDEX_TYPE i2){
 	VKVG_IBO_INDEX_TYPE* inds = &ctx->indexCache[ctx->indCount];
 	inds[0] = i0;
@@ -389,10 +617,10 @@ void _add_triangle_indices_unchecked (VkvgContext ctx, VKVG_IBO_INDEX_TYPE i0, V
 void _vao_add_rectangle (VkvgContext ctx, float x, float y, float width, float height){
 	Vertex v[4] =
 	{
-		{{x,y},				ctx->curColor, {0,0,-1}},
-		{{x,y+height},		ctx->curColor, {0,0,-1}},
-		{{x+width,y},		ctx->curColor, {0,0,-1}},
-		{{x+width,y+height},ctx->curColor, {0,0,-1}}
+		{{x,y},				ctx->curColor},
+		{{x,y+height},		ctx->curColor},
+		{{x+width,y},		ctx->curColor},
+		{{x+width,y+height},ctx->curColor}
 	};
 	VKVG_IBO_INDEX_TYPE firstIdx = (VKVG_IBO_INDEX_TYPE)(ctx->vertCount - ctx->curVertOffset);
 	Vertex* pVert = &ctx->vertexCache[ctx->vertCount];
@@ -403,6 +631,195 @@ void _vao_add_rectangle (VkvgContext ctx, float x, float y, float width, float h
 
 	_add_tri_indices_for_rect(ctx, firstIdx);
 }
+//append an instance expanding the device unit quad, consecutive instances of the same type are drawn
+//with a single draw call. Pending vector geometry or instances of another type are emitted first to keep drawing order.
+void _add_instance (VkvgContext ctx, vkvg_instance_type_t type, const void* instance, uint32_t size){
+	if (ctx->indCount > ctx->curIndStart || (ctx->instCount > 0 && ctx->instType != type))
+		_emit_draw_cmd_undrawn_vertices (ctx);
+	if (ctx->instCount == 0) {
+		ctx->instType = type;
+		ctx->instStart = ctx->vertCount;
+	}
+	memcpy (&ctx->vertexCache[ctx->vertCount], instance, size);
+	ctx->vertCount += size / sizeof(Vertex);
+	ctx->instCount++;
+	_check_vertex_cache_size(ctx);
+}
+//add an axis aligned rectangle drawn by instancing the device unit quad
+void _add_rect_instance (VkvgContext ctx, float x, float y, float width, float height){
+	RectInstance r = {{x,y}, ctx->curColor, {width,height}, 0};
+	LOG(VKVG_LOG_INFO_VBO, "Add Rect    %10d: pos:(%10.4f, %10.4f) size:(%10.4f, %10.4f) color:0x%.8x \n", ctx->vertCount, x, y, width, height, r.color);
+	_add_instance (ctx, vkvg_instance_rect, &r, sizeof(RectInstance));
+}
+//keep track of a circle, ellipse or rounded rectangle if it is the first shape added to the path
+void _set_sdf_shape (VkvgContext ctx, uint32_t startPointCount, float cx, float cy, float halfWidth, float halfHeight, float radius) {
+	if (startPointCount > 0 || ctx->subpathCount != 1)
+		return;
+	ctx->sdfShape = (_sdf_shape_t) {ctx->pointCount, {cx, cy}, {halfWidth, halfHeight}, radius};
+}
+//true if current path is only made of the recorded shape and if it may be drawn with a sdf instance,
+//that is with a solid color source and without the clear operator that would clear the whole quad.
+bool _sdf_shape_drawable (VkvgContext ctx) {
+	if (ctx->sdfShape.pointCount == 0 || ctx->sdfShape.pointCount != ctx->pointCount || ctx->subpathCount != 1 ||
+			ctx->pattern || ctx->curOperator == VKVG_OPERATOR_CLEAR)
+		return false;
+	float sx, sy;
+	vkvg_matrix_get_scale (&ctx->pushConsts.mat, &sx, &sy);
+	return sx > 0 && sy > 0;
+}
+//add the recorded shape as a bounding quad instance, coverage is computed in the fragment shader from the
+//signed distance to the shape. The quad is grown by one pixel for antialiasing.
+void _add_sdf_instance (VkvgContext ctx, float strokeHalfWidth){
+	float sx, sy;
+	vkvg_matrix_get_scale (&ctx->pushConsts.mat, &sx, &sy);
+	SdfInstance s = {ctx->sdfShape.center, ctx->curColor, ctx->sdfShape.halfSize, ctx->sdfShape.radius,
+					 strokeHalfWidth, 1.0f / fminf (sx, sy), 0};
+	LOG(VKVG_LOG_INFO_VBO, "Add Sdf     %10d: center:(%10.4f, %10.4f) half size:(%10.4f, %10.4f) radius:%10.4f stroke:%10.4f\n",
+		ctx->vertCount, s.center.x, s.center.y, s.halfSize.x, s.halfSize.y, s.radius, s.strokeHalf);
+	_add_instance (ctx, vkvg_instance_sdf, &s, sizeof(SdfInstance));
+}
+//fill line pipeline push constants with the current miter limit and dash pattern. Odd patterns are repeated
+//twice for even dashes to be always on. Return false if the pattern is too long for the shader.
+static bool _get_line_push_constants (VkvgContext ctx, line_push_constants* lpc) {
+	*lpc = (line_push_constants) {ctx->miterLimit, 0, 0, {0}};
+	if (ctx->dashCount == 0)
+		return true;
+	uint32_t count = ctx->dashCount % 2 ? ctx->dashCount * 2 : ctx->dashCount;
+	if (count > VKVG_GPU_DASH_MAX)
+		return false;
+	for (uint32_t i = 0; i < count; i++) {
+		lpc->dashes[i] = ctx->dashes[i % ctx->dashCount];
+		lpc->dashTotal += lpc->dashes[i];
+	}
+	lpc->dashOffset = fmodf (ctx->dashOffset, lpc->dashTotal);
+	return lpc->dashTotal > 0;
+}
+//true if current stroke may be drawn with line records, long dash patterns and non solid sources are tessellated.
+static bool _line_records_drawable (VkvgContext ctx) {
+	line_push_constants lpc;
+	return ctx->lineWidth > 0 && !ctx->pattern && ctx->curOperator != VKVG_OPERATOR_CLEAR &&
+			_get_line_push_constants (ctx, &lpc);
+}
+//true if current stroke has to be expanded on the gpu from the path points
+bool _gpu_stroke_drawable (VkvgContext ctx) {
+	return ctx->strokeMode == VKVG_STROKE_MODE_GPU && _line_records_drawable (ctx);
+}
+//return the line width in device units if the current stroke is thin enough to be drawn as a hairline, 0 otherwise.
+//The width on the surface depends on the direction of the lines if the matrix scale is not uniform, those strokes
+//are tessellated as without antialiasing.
+float _hairline_width (VkvgContext ctx) {
+	if (ctx->antialias == VKVG_ANTIALIAS_NONE)
+		return 0;
+	vkvg_matrix_t* m = &ctx->pushConsts.mat;
+	float s = m->xx * m->xx + m->yx * m->yx + m->xy * m->xy + m->yy * m->yy;
+	float det = fabsf (m->xx * m->yy - m->yx * m->xy);
+	//squared singular values differ by sqrt(s^2 - 4det^2)
+	if (s * s - 4.f * det * det > 1e-4f * s * s)
+		return 0;
+	float w = ctx->lineWidth * sqrtf (det);
+	if (w >= VKVG_HAIRLINE_WIDTH || !_line_records_drawable (ctx))
+		return 0;
+	return w;
+}
+//scale the coverage of a packed color, all its components are scaled when alpha is premultiplied.
+uint32_t _scale_color_coverage (uint32_t color, float coverage) {
+	uint32_t a = (uint32_t)((color >> 24) * coverage + 0.5f);
+#ifdef VKVG_PREMULT_ALPHA
+	uint32_t r = (uint32_t)((color & 0xff) * coverage + 0.5f);
+	uint32_t g = (uint32_t)(((color >> 8) & 0xff) * coverage + 0.5f);
+	uint32_t b = (uint32_t)(((color >> 16) & 0xff) * coverage + 0.5f);
+	return (a << 24) | (b << 16) | (g << 8) | r;
+#else
+	return (color & 0x00ffffff) | (a << 24);
+#endif
+}
+//append the points of each subpath as line records. Subpathes are bordered with the points giving the direction
+//of their first and last joins, or with repeated end points for open pathes. Those border records are flagged
+//as starting no segment, so are instances spanning two subpathes that are all drawn with a single draw call.
+//Dashes are evaluated per fragment from the arc length of the records.
+void _add_line_records (VkvgContext ctx, float halfWidth, uint32_t color, vkvg_line_join_t join) {
+	line_push_constants lpc;
+	_get_line_push_constants (ctx, &lpc);
+
+	if (ctx->indCount > ctx->curIndStart || (ctx->instCount > 0 && (ctx->instType != vkvg_instance_line ||
+			memcmp (&lpc, &ctx->linePushConsts, sizeof(line_push_constants)))))
+		_emit_draw_cmd_undrawn_vertices (ctx);
+	if (ctx->instCount == 0) {
+		ctx->instType = vkvg_instance_line;
+		ctx->instStart = ctx->vertCount;
+		ctx->linePushConsts = lpc;
+	}
+
+	LineRecord r = {{0}, color, halfWidth, 0, ((uint32_t)join << 2) | ((uint32_t)ctx->lineCap << 4)};
+	uint32_t ptrPath = 0, firstPtIdx = 0;
+
+	while (ptrPath < ctx->pathPtr){
+		uint32_t pathPointCount = ctx->pathes[ptrPath] & PATH_ELT_MASK;
+		bool closed = _path_is_closed (ctx, ptrPath);
+
+		_ensure_vertex_cache_size (ctx, (pathPointCount + 3) * sizeof(LineRecord) / sizeof(Vertex));
+		LineRecord* recs = (LineRecord*)&ctx->vertexCache[ctx->vertCount];
+
+		//distinct points are stored from the second record
+		uint32_t count = 0;
+		r.arcLength = 0;
+		for (uint32_t i = 0; i < pathPointCount; i++) {
+			r.pos = ctx->points[firstPtIdx + i];
+			if (count == 0) {
+				recs[++count] = r;
+				continue;
+			}
+			float l = vec2_length (vec2_sub (r.pos, recs[count].pos));
+			if (l > FLT_EPSILON) {
+				r.arcLength += l;
+				recs[++count] = r;
+			}
+		}
+		if (closed && count > 1 && vec2_length (vec2_sub (recs[1].pos, recs[count].pos)) <= FLT_EPSILON)
+			count--;
+
+		if (count > 2 && closed) {
+			recs[0] = recs[count];
+			recs[count + 1] = recs[1];
+			recs[count + 2] = recs[2];
+			recs[0].flags |= LINE_NO_SEGMENT;
+			recs[count + 1].flags |= LINE_NO_SEGMENT;
+			recs[count + 2].flags |= LINE_NO_SEGMENT;
+			ctx->vertCount += (count + 3) * sizeof(LineRecord) / sizeof(Vertex);
+		} else if (count > 1) {
+			recs[1].flags |= LINE_CAP;
+			recs[count].flags |= LINE_CAP | LINE_NO_SEGMENT;
+			recs[0] = recs[1];
+			recs[0].flags |= LINE_NO_SEGMENT;
+			recs[count + 1] = recs[count];
+			ctx->vertCount += (count + 2) * sizeof(LineRecord) / sizeof(Vertex);
+		}
+
+		firstPtIdx += pathPointCount;
+		if (_path_has_curves (ctx, ptrPath)) {
+			//skip segments lengths used in stroke
+			ptrPath++;
+			uint32_t totPts = 0;
+			while (totPts < pathPointCount)
+				totPts += (ctx->pathes[ptrPath++] & PATH_ELT_MASK);
+		}else
+			ptrPath++;
+	}
+
+	//the three last records of the run only border the previous instances
+	uint32_t recCount = (ctx->vertCount - ctx->instStart) * sizeof(Vertex) / sizeof(LineRecord);
+	ctx->instCount = recCount > 3 ? recCount - 3 : 0;
+	_check_vertex_cache_size (ctx);
+}
+//true if current path is a single closed axis aligned rectangle
+bool _path_is_axis_aligned_rect (VkvgContext ctx) {
+	if (ctx->pathPtr != 1 || (ctx->pathes[0] & PATH_ELT_MASK) != 4 ||
+			!(ctx->pathes[0] & PATH_CLOSED_BIT) || _path_has_curves (ctx, 0))
+		return false;
+	vec2* p = ctx->points;
+	return (p[0].y == p[1].y && p[1].x == p[2].x && p[2].y == p[3].y && p[3].x == p[0].x) ||
+		   (p[0].x == p[1].x && p[1].y == p[2].y && p[2].x == p[3].x && p[3].y == p[0].y);
+}
 //start render pass if not yet started or update push const if requested
 void _ensure_renderpass_is_started (VkvgContext ctx) {
 	LOG(VKVG_LOG_INFO, "_ensure_renderpass_is_started\n");
@@ -422,6 +839,8 @@ void _clear_attachment (VkvgContext ctx) {
 }
 bool _wait_flush_fence (VkvgContext ctx) {
 	LOG(VKVG_LOG_INFO, "CTX: _wait_flush_fence\n");
+	if (!ctx->flushFence)//nothing submitted yet
+		return true;
 	if (WaitForFences (ctx->dev->vkDev, 1, &ctx->flushFence, VK_TRUE, VKVG_FENCE_TIMEOUT) == VK_SUCCESS)
 		return true;
 	LOG(VKVG_LOG_DEBUG, "CTX: _wait_flush_fence timeout\n");
@@ -473,15 +892,42 @@ bool _wait_and_submit_cmd (VkvgContext ctx){
 
 //pre flush vertices because of vbo or ibo too small, all vertices except last draw call are flushed
 //this function expects a vertex offset > 0
+void _update_vertices_hwm (VkvgContext ctx) {
+	if (ctx->vertCount > ctx->hwmVertices)
+		ctx->hwmVertices = ctx->vertCount;
+	if (ctx->indCount > ctx->hwmIndices)
+		ctx->hwmIndices = ctx->indCount;
+}
+//copy emitted index runs to the ibo, 16bit runs are narrowed from the 32bit cache
+void _write_index_runs (VkvgContext ctx) {
+	uint8_t* ibo = (uint8_t*)ctx->indices.allocInfo.pMappedData;
+	for (uint32_t r = 0; r < ctx->indexRunCount; r++) {
+		_index_run_t* run = &ctx->indexRuns[r];
+		VKVG_IBO_INDEX_TYPE* src = &ctx->indexCache[run->cacheStart];
+#if VKVG_CUR_IBO_TYPE == VKVG_IBO_32
+		if (run->type == VK_INDEX_TYPE_UINT16) {
+			uint16_t* dst = (uint16_t*)(ibo + run->iboOffset);
+			for (uint32_t i = 0; i < run->count; i++)
+				dst[i] = (uint16_t)src[i];
+			continue;
+		}
+#endif
+		memcpy(ibo + run->iboOffset, src, run->count * sizeof (VKVG_IBO_INDEX_TYPE));
+	}
+	ctx->indexRunCount = ctx->iboBytes = 0;
+}
 void _flush_vertices_caches_until_vertex_base (VkvgContext ctx) {
 	_wait_flush_fence (ctx);
+	_update_vertices_hwm (ctx);
 
 	memcpy(ctx->vertices.allocInfo.pMappedData, ctx->vertexCache, ctx->curVertOffset * sizeof (Vertex));
-	memcpy(ctx->indices.allocInfo.pMappedData, ctx->indexCache, ctx->curIndStart * sizeof (VKVG_IBO_INDEX_TYPE));
+	_write_index_runs (ctx);
 
 	//copy remaining vertices and indices to caches starts
 	ctx->vertCount -= ctx->curVertOffset;
 	ctx->indCount -= ctx->curIndStart;
+	if (ctx->instCount > 0)
+		ctx->instStart -= ctx->curVertOffset;
 	memcpy(ctx->vertexCache, &ctx->vertexCache[ctx->curVertOffset], ctx->vertCount * sizeof (Vertex));
 	memcpy(ctx->indexCache, &ctx->indexCache[ctx->curIndStart], ctx->indCount * sizeof (VKVG_IBO_INDEX_TYPE));
 
@@ -493,11 +939,13 @@ void _flush_vertices_caches_until_vertex_base (VkvgContext ctx) {
 void _flush_vertices_caches (VkvgContext ctx) {
 	if (!_wait_flush_fence (ctx))
 		return;
+	_update_vertices_hwm (ctx);
 
 	memcpy(ctx->vertices.allocInfo.pMappedData, ctx->vertexCache, ctx->vertCount * sizeof (Vertex));
-	memcpy(ctx->indices.allocInfo.pMappedData, ctx->indexCache, ctx->indCount * sizeof (VKVG_IBO_INDEX_TYPE));
+	_write_index_runs (ctx);
 
 	ctx->vertCount = ctx->indCount = ctx->curIndStart = ctx->curVertOffset = 0;
+	ctx->instCount = 0;
 }
 //this func expect cmdStarted to be true
 void _end_render_pass (VkvgContext ctx) {
@@ -523,30 +971,105 @@ void _check_vao_size (VkvgContext ctx) {
 	}
 }
 
+//add undrawn indices to the index runs and rebind the ibo if the index type changes.
+//Indices are relative to the draw vertex offset, so batches addressing less than 64k vertices
+//are stored as 16bit indices.
+//return the first index for the draw command, ctx status is set on failure.
+uint32_t _emit_index_run (VkvgContext ctx) {
+	uint32_t count = ctx->indCount - ctx->curIndStart;
+#if VKVG_CUR_IBO_TYPE == VKVG_IBO_32
+	VkIndexType type = (ctx->vertCount - ctx->curVertOffset <= UINT16_MAX) ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+#else
+	VkIndexType type = VK_INDEX_TYPE_UINT16;
+#endif
+	uint32_t idxSize = (type == VK_INDEX_TYPE_UINT16) ? 2 : 4;
+	uint32_t offset = ctx->iboBytes;
+	if (offset % idxSize)
+		offset += idxSize - offset % idxSize;
+
+	if (ctx->indexRunCount > 0 && ctx->indexRuns[ctx->indexRunCount-1].type == type)
+		ctx->indexRuns[ctx->indexRunCount-1].count += count;
+	else {
+		if (ctx->indexRunCount == ctx->sizeIndexRuns) {
+			uint32_t newSize = ctx->sizeIndexRuns + VKVG_ARRAY_THRESHOLD;
+			_index_run_t* tmp = (_index_run_t*)realloc (ctx->indexRuns, newSize * sizeof(_index_run_t));
+			if (tmp == NULL) {
+				ctx->status = VKVG_STATUS_NO_MEMORY;
+				LOG(VKVG_LOG_ERR, "resize index runs failed: run count: %u\n", newSize);
+				return 0;
+			}
+			ctx->indexRuns = tmp;
+			ctx->sizeIndexRuns = newSize;
+		}
+		ctx->indexRuns[ctx->indexRunCount++] = (_index_run_t){ctx->curIndStart, count, offset, type};
+	}
+	ctx->iboBytes = offset + count * idxSize;
+
+	if (ctx->boundIndexType != type) {
+		CmdBindIndexBuffer(ctx->cmd, ctx->indices.buffer, 0, type);
+		ctx->boundIndexType = type;
+	}
+	return offset / idxSize;
+}
+//instanced draw call for undrawn rectangles or rounded shapes, the vbo is bound at the first instance
+//with the pipelines of the instance type.
+void _emit_draw_cmd_undrawn_instances (VkvgContext ctx){
+	VkDeviceSize offset = ctx->instStart * sizeof(Vertex);
+	if (ctx->instType == vkvg_instance_sdf)
+		_bind_sdf_pipeline	(ctx);
+	else if (ctx->instType == vkvg_instance_line) {
+		_bind_line_pipeline	(ctx);
+		CmdPushConstants	(ctx->cmd, ctx->dev->pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT|VK_SHADER_STAGE_FRAGMENT_BIT,
+							 sizeof(push_constants), sizeof(line_push_constants), &ctx->linePushConsts);
+	} else
+		_bind_rect_pipeline	(ctx);
+	CmdBindVertexBuffers	(ctx->cmd, 0, 1, &ctx->vertices.buffer, &offset);
+	CmdDraw					(ctx->cmd, 4, ctx->instCount, 0, 0);
+	offset = 0;
+	CmdBindVertexBuffers	(ctx->cmd, 0, 1, &ctx->vertices.buffer, &offset);
+	_bind_draw_pipeline		(ctx);
+
+	LOG(VKVG_LOG_INFO, "RECORD INSTANCES DRAW CMD: ctx = %p; type = %d; instances = %d (first slot = %d)\n",
+		ctx, ctx->instType, ctx->instCount, ctx->instStart);
+
+	ctx->instCount = 0;
+}
 //stroke and non-zero draw call for solid color flush
 void _emit_draw_cmd_undrawn_vertices (VkvgContext ctx){
-	if (ctx->indCount == ctx->curIndStart)
+	if (ctx->indCount == ctx->curIndStart && ctx->instCount == 0)
 		return;
 
 	_check_vao_size (ctx);
 
 	_ensure_renderpass_is_started (ctx);
 
+	if (ctx->instCount > 0) {
+		_emit_draw_cmd_undrawn_instances (ctx);
+		if (ctx->indCount == ctx->curIndStart) {
+			ctx->curVertOffset = ctx->vertCount;
+			return;
+		}
+	}
+
+	uint32_t firstIdx = _emit_index_run (ctx);
+	if (ctx->status)
+		return;
+
 #ifdef VKVG_WIRED_DEBUG
 	if (vkvg_wired_debug&vkvg_wired_debug_mode_normal)
-		CmdDrawIndexed(ctx->cmd, ctx->indCount - ctx->curIndStart, 1, ctx->curIndStart, (int32_t)ctx->curVertOffset, 0);
+		CmdDrawIndexed(ctx->cmd, ctx->indCount - ctx->curIndStart, 1, firstIdx, (int32_t)ctx->curVertOffset, 0);
 	if (vkvg_wired_debug&vkvg_wired_debug_mode_lines) {
 		CmdBindPipeline(ctx->cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, ctx->pSurf->dev->pipelineLineList);
-		CmdDrawIndexed(ctx->cmd, ctx->indCount - ctx->curIndStart, 1, ctx->curIndStart, (int32_t)ctx->curVertOffset, 0);
+		CmdDrawIndexed(ctx->cmd, ctx->indCount - ctx->curIndStart, 1, firstIdx, (int32_t)ctx->curVertOffset, 0);
 	}
 	if (vkvg_wired_debug&vkvg_wired_debug_mode_points) {
 		CmdBindPipeline(ctx->cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, ctx->pSurf->dev->pipelineWired);
-		CmdDrawIndexed(ctx->cmd, ctx->indCount - ctx->curIndStart, 1, ctx->curIndStart, (int32_t)ctx->curVertOffset, 0);
+		CmdDrawIndexed(ctx->cmd, ctx->indCount - ctx->curIndStart, 1, firstIdx, (int32_t)ctx->curVertOffset, 0);
 	}
 	if (vkvg_wired_debug&vkvg_wired_debug_mode_both)
 		CmdBindPipeline(ctx->cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, ctx->pSurf->dev->pipe_OVER);
 #else
-	CmdDrawIndexed(ctx->cmd, ctx->indCount - ctx->curIndStart, 1, ctx->curIndStart, (int32_t)ctx->curVertOffset, 0);
+	CmdDrawIndexed(ctx->cmd, ctx->indCount - ctx->curIndStart, 1, firstIdx, (int32_t)ctx->curVertOffset, 0);
 #endif
 	LOG(VKVG_LOG_INFO, "RECORD DRAW CMD: ctx = %p; vertices = %d; indices = %d (vxOff = %d idxStart = %d idxTot = %d )\n",
 		ctx, ctx->vertCount - ctx->curVertOffset,
@@ -554,6 +1077,31 @@ void _emit_draw_cmd_undrawn_vertices (VkvgContext ctx){
 
 	ctx->curIndStart = ctx->indCount;
 	ctx->curVertOffset = ctx->vertCount;
+	ctx->vertexDraws++;
+}
+//instanced draw call for glyphs added since last emitted draw, the vbo is bound at the first glyph
+//with the text pipelines.
+void _emit_draw_cmd_undrawn_glyphs (VkvgContext ctx){
+	if (ctx->vertCount == ctx->curVertOffset)
+		return;
+
+	_check_vao_size (ctx);
+
+	_ensure_renderpass_is_started (ctx);
+
+	uint32_t glyphCount = (ctx->vertCount - ctx->curVertOffset) * sizeof(Vertex) / sizeof(GlyphInstance);
+	VkDeviceSize offset = ctx->curVertOffset * sizeof(Vertex);
+	_bind_text_pipeline		(ctx);
+	CmdBindVertexBuffers	(ctx->cmd, 0, 1, &ctx->vertices.buffer, &offset);
+	CmdDraw					(ctx->cmd, 4, glyphCount, 0, 0);
+	offset = 0;
+	CmdBindVertexBuffers	(ctx->cmd, 0, 1, &ctx->vertices.buffer, &offset);
+	_bind_draw_pipeline		(ctx);
+
+	LOG(VKVG_LOG_INFO, "RECORD GLYPHS DRAW CMD: ctx = %p; glyphs = %d (first slot = %d)\n",
+		ctx, glyphCount, ctx->curVertOffset);
+
+	ctx->curVertOffset = ctx->vertCount;
 }
 //preflush vertices with drawcommand already emited
 void _flush_cmd_until_vx_base (VkvgContext ctx){
@@ -575,6 +1123,9 @@ void _flush_cmd_buff (VkvgContext ctx){
 	vkh_cmd_end				(ctx->cmd);
 
 	_wait_and_submit_cmd	(ctx);
+
+	if (++ctx->flushCount >= VKVG_TRIM_FLUSH_PERIOD)
+		_trim_caches (ctx, false);
 }
 
 //bind correct draw pipeline depending on current OPERATOR
@@ -594,6 +1145,48 @@ void _bind_draw_pipeline (VkvgContext ctx) {
 		break;
 	}
 }
+//bind instanced rectangles pipeline depending on current OPERATOR
+void _bind_rect_pipeline (VkvgContext ctx) {
+	switch (ctx->curOperator) {
+	case VKVG_OPERATOR_CLEAR:
+		CmdBindPipeline(ctx->cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, ctx->dev->pipeRect_CLEAR);
+		break;
+	case VKVG_OPERATOR_DIFFERENCE:
+		CmdBindPipeline(ctx->cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, ctx->dev->pipeRect_SUB);
+		break;
+	default:
+		CmdBindPipeline(ctx->cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, ctx->dev->pipeRect_OVER);
+		break;
+	}
+}
+//bind instanced rounded shapes pipeline depending on current OPERATOR, clear is drawn with paths
+void _bind_sdf_pipeline (VkvgContext ctx) {
+	if (ctx->curOperator == VKVG_OPERATOR_DIFFERENCE)
+		CmdBindPipeline(ctx->cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, ctx->dev->pipeSdf_SUB);
+	else
+		CmdBindPipeline(ctx->cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, ctx->dev->pipeSdf_OVER);
+}
+//bind instanced stroke segments pipeline depending on current OPERATOR
+void _bind_line_pipeline (VkvgContext ctx) {
+	if (ctx->curOperator == VKVG_OPERATOR_DIFFERENCE)
+		CmdBindPipeline(ctx->cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, ctx->dev->pipeLine_SUB);
+	else
+		CmdBindPipeline(ctx->cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, ctx->dev->pipeLine_OVER);
+}
+//bind instanced glyphs pipeline depending on current OPERATOR
+void _bind_text_pipeline (VkvgContext ctx) {
+	switch (ctx->curOperator) {
+	case VKVG_OPERATOR_CLEAR:
+		CmdBindPipeline(ctx->cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, ctx->dev->pipeText_CLEAR);
+		break;
+	case VKVG_OPERATOR_DIFFERENCE:
+		CmdBindPipeline(ctx->cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, ctx->dev->pipeText_SUB);
+		break;
+	default:
+		CmdBindPipeline(ctx->cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, ctx->dev->pipeText_OVER);
+		break;
+	}
+}
 #if defined(DEBUG) && defined (VKVG_DBG_UTILS)
 const float DBG_LAB_COLOR_RP[4]		= {0,0,1,1};
 const float DBG_LAB_COLOR_FSQ[4]	= {1,0,0,1};
@@ -601,6 +1194,10 @@ const float DBG_LAB_COLOR_FSQ[4]	= {1,0,0,1};
 
 void _start_cmd_for_render_pass (VkvgContext ctx) {
 	LOG(VKVG_LOG_INFO, "START RENDER PASS: ctx = %p\n", ctx);
+	_ensure_cmd_ressources	(ctx);
+	_ensure_descriptor_sets	(ctx);
+	_trim_vk_buffers		(ctx);
+	_ensure_vertices_buff	(ctx);
 	vkh_cmd_begin (ctx->cmd,VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
 
 	if (ctx->pSurf->img->layout != VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL || ctx->dev->threadAware){
@@ -632,9 +1229,11 @@ void _start_cmd_for_render_pass (VkvgContext ctx) {
 	CmdBindDescriptorSets(ctx->cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, ctx->dev->pipelineLayout,
 							0, 3, dss, 0, NULL);
 
-	VkDeviceSize offsets[1] = { 0 };
-	CmdBindVertexBuffers(ctx->cmd, 0, 1, &ctx->vertices.buffer, offsets);
+	VkBuffer vbos[] = {ctx->vertices.buffer, ctx->dev->defaultUV.buffer, ctx->dev->unitQuad.buffer};
+	VkDeviceSize offsets[3] = { 0 };
+	CmdBindVertexBuffers(ctx->cmd, 0, 3, vbos, offsets);
 	CmdBindIndexBuffer(ctx->cmd, ctx->indices.buffer, 0, VKVG_VK_INDEX_TYPE);
+	ctx->boundIndexType = VKVG_VK_INDEX_TYPE;
 
 	_update_push_constants	(ctx);
 
@@ -665,8 +1264,10 @@ void _update_cur_pattern (VkvgContext ctx, VkvgPattern pat) {
 	if (pat == NULL) {//solid color
 		if (lastPat == NULL)//solid
 			return;//solid to solid transition, no extra action requested
-	}else
+	}else {
 		newPatternType = pat->type;
+		ctx->curColor = 0xffffffff;//vertex alpha of patterns only hold antialiasing coverage
+	}
 
 	switch (newPatternType)	 {
 	case VKVG_PATTERN_TYPE_SOLID:
@@ -682,6 +1283,9 @@ void _update_cur_pattern (VkvgContext ctx, VkvgPattern pat) {
 
 		VkvgSurface surf = (VkvgSurface)pat->data;
 
+		_ensure_cmd_ressources	(ctx);
+		_ensure_descriptor_sets	(ctx);
+
 		//flush ctx in two steps to add the src transitioning in the cmd buff
 		if (ctx->cmdStarted){//transition of img without appropriate dependencies in subpass must be done outside renderpass.
 			_end_render_pass (ctx);
@@ -753,6 +1357,8 @@ void _update_cur_pattern (VkvgContext ctx, VkvgPattern pat) {
 		vec4 bounds = {{(float)ctx->pSurf->width}, {(float)ctx->pSurf->height}, {0}, {0}};//store img bounds in unused source field
 		ctx->pushConsts.source = bounds;
 
+		_ensure_gradient_buff (ctx);
+
 		//transform control point with current ctx matrix
 		vkvg_gradient_t grad = *(vkvg_gradient_t*)pat->data;
 
@@ -811,7 +1417,7 @@ void _update_descriptor_set (VkvgContext ctx, VkhImage img, VkDescriptorSet ds){
 }
 
 void _update_gradient_desc_set (VkvgContext ctx){
-	VkDescriptorBufferInfo dbi = {ctx->uboGrad.buffer, 0, VK_WHOLE_SIZE};
+	VkDescriptorBufferInfo dbi = {ctx->uboGrad.buffer ? ctx->uboGrad.buffer : ctx->dev->emptyGrad.buffer, 0, VK_WHOLE_SIZE};
 	VkWriteDescriptorSet writeDescriptorSet = {
 			.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
 			.dstSet = ctx->dsGrad,
@@ -837,52 +1443,80 @@ void _update_gradient_desc_set (VkvgContext ctx){
 	VK_CHECK_RESULT(vkAllocateDescriptorSets(dev->vkDev, &descriptorSetAllocateInfo, &ctx->dsSrc));
 }*/
 
-void _createDescriptorPool (VkvgContext ctx) {
+//context gpu ressources are created on first need, contexts used only for measurement stay lightweight.
+//for context to be thread safe, command pool has to be created in the thread of the context.
+void _ensure_cmd_ressources (VkvgContext ctx) {
+	if (ctx->cmdPool)
+		return;
 	VkvgDevice dev = ctx->dev;
-	const VkDescriptorPoolSize descriptorPoolSize[] = {
-		{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 2 },
-		{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1 }
-	};
-	VkDescriptorPoolCreateInfo descriptorPoolCreateInfo = { .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
-															.maxSets = 3,
-															.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT,
-															.poolSizeCount = 2,
-															.pPoolSizes = descriptorPoolSize };
-	VK_CHECK_RESULT(vkCreateDescriptorPool (dev->vkDev, &descriptorPoolCreateInfo, NULL, &ctx->descriptorPool));
-}
-void _init_descriptor_sets (VkvgContext ctx){
+	ctx->cmdPool	= vkh_cmd_pool_create ((VkhDevice)dev, dev->gQueue->familyIndex, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+	ctx->flushFence	= vkh_fence_create_signaled ((VkhDevice)dev);
+	_create_cmd_buff (ctx);
+	ctx->cmd = ctx->cmdBuffers[0];//current recording buffer
+#if defined(DEBUG) && defined (VKVG_DBG_UTILS)
+	vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_COMMAND_POOL, (uint64_t)ctx->cmdPool, "CTX Cmd Pool");
+	vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_COMMAND_BUFFER, (uint64_t)ctx->cmdBuffers[0], "CTX Cmd Buff A");
+	vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_COMMAND_BUFFER, (uint64_t)ctx->cmdBuffers[1], "CTX Cmd Buff B");
+	vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_FENCE, (uint64_t)ctx->flushFence, "CTX Flush Fence");
+#endif
+}
+//descriptor sets are allocated from the device shared pools, gradient set is bound to the device
+//empty gradient until a gradient pattern is used.
+void _ensure_descriptor_sets (VkvgContext ctx) {
+	if (ctx->dsSrc)
+		return;
 	VkvgDevice dev = ctx->dev;
-	VkDescriptorSetAllocateInfo descriptorSetAllocateInfo = { .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
-															  .descriptorPool = ctx->descriptorPool,
-															  .descriptorSetCount = 1,
-															  .pSetLayouts = &dev->dslFont
-															};
-	VK_CHECK_RESULT(vkAllocateDescriptorSets(dev->vkDev, &descriptorSetAllocateInfo, &ctx->dsFont));
-	descriptorSetAllocateInfo.pSetLayouts = &dev->dslSrc;
-	VK_CHECK_RESULT(vkAllocateDescriptorSets(dev->vkDev, &descriptorSetAllocateInfo, &ctx->dsSrc));
-	descriptorSetAllocateInfo.pSetLayouts = &dev->dslGrad;
-	VK_CHECK_RESULT(vkAllocateDescriptorSets(dev->vkDev, &descriptorSetAllocateInfo, &ctx->dsGrad));
+	VkDescriptorSet dss[3];
+	_device_alloc_context_descriptor_sets (dev, &ctx->descriptorPool, dss);
+	ctx->dsFont = dss[0];
+	ctx->dsSrc	= dss[1];
+	ctx->dsGrad = dss[2];
+
+	_font_cache_update_context_descset (ctx);
+	_update_descriptor_set	(ctx, dev->emptyImg, ctx->dsSrc);
+	_update_gradient_desc_set(ctx);
+#if defined(DEBUG) && defined (VKVG_DBG_UTILS)
+	vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_DESCRIPTOR_SET, (uint64_t)ctx->dsSrc, "CTX DescSet SOURCE");
+	vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_DESCRIPTOR_SET, (uint64_t)ctx->dsFont, "CTX DescSet FONT");
+	vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_DESCRIPTOR_SET, (uint64_t)ctx->dsGrad, "CTX DescSet GRADIENT");
+#endif
+}
+void _ensure_gradient_buff (VkvgContext ctx) {
+	if (ctx->uboGrad.buffer)
+		return;
+	_ensure_descriptor_sets		(ctx);
+	_create_gradient_buff		(ctx);
+	_update_gradient_desc_set	(ctx);
 }
 void _release_context_ressources (VkvgContext ctx) {
 	VkDevice dev = ctx->dev->vkDev;
-	
-	_device_destroy_fence (ctx->dev, ctx->flushFence);
-	vkFreeCommandBuffers(dev, ctx->cmdPool, 2, ctx->cmdBuffers);
-	vkDestroyCommandPool(dev, ctx->cmdPool, NULL);
 
-	VkDescriptorSet dss[] = {ctx->dsFont, ctx->dsSrc, ctx->dsGrad};
-	vkFreeDescriptorSets	(dev, ctx->descriptorPool, 3, dss);
+	if (ctx->cmdPool) {
+		_device_destroy_fence (ctx->dev, ctx->flushFence);
+		vkFreeCommandBuffers(dev, ctx->cmdPool, 2, ctx->cmdBuffers);
+		vkDestroyCommandPool(dev, ctx->cmdPool, NULL);
+	}
 
-	vkDestroyDescriptorPool (dev, ctx->descriptorPool,NULL);
+	if (ctx->dsSrc) {
+		VkDescriptorSet dss[] = {ctx->dsFont, ctx->dsSrc, ctx->dsGrad};
+		_device_free_context_descriptor_sets (ctx->dev, ctx->descriptorPool, dss);
+	}
 
-	vkvg_buffer_destroy (&ctx->uboGrad);
-	vkvg_buffer_destroy (&ctx->indices);
-	vkvg_buffer_destroy (&ctx->vertices);
+	if (ctx->uboGrad.buffer)
+		vkvg_buffer_destroy (&ctx->uboGrad);
+	if (ctx->indices.buffer)
+		vkvg_buffer_destroy (&ctx->indices);
+	if (ctx->vertices.buffer)
+		vkvg_buffer_destroy (&ctx->vertices);
 
 	free(ctx->vertexCache);
 	free(ctx->indexCache);
+	free(ctx->indexRuns);
+	tess_arena_free (&ctx->tessArena);
+	tess_arena_free (&ctx->outlineArena);
 
-	vkh_image_destroy	  (ctx->fontCacheImg);
+	if (ctx->fontCacheImg)
+		vkh_image_destroy (ctx->fontCacheImg);
 	//TODO:check this for source counter
 	//vkh_image_destroy	  (ctx->source);
 
@@ -891,23 +1525,23 @@ void _release_context_ressources (VkvgContext ctx) {
 
 	free(ctx);
 }
-//populate vertice buff for stroke
-bool _build_vb_step(VkvgContext ctx, stroke_context_t* str, bool isCurve){
-	Vertex v = {{0},ctx->curColor, {0,0,-1}};
-	vec2 pL = ctx->points[str->iL];
-	vec2 p0 = ctx->points[str->cp];
-	vec2 pR = ctx->points[str->iR];
-
-	vec2 v0 = vec2_sub(p0, pL);
-	vec2 v1 = vec2_sub(pR, p0);
-	float length_v0 = vec2_length(v0);
-	float length_v1 = vec2_length(v1);
+//upper bound of the vertices added by one join, round joins add one vertex per arc step. Indices count is at most
+//three times this value.
+static uint32_t _join_max_vertices (VkvgContext ctx, stroke_context_t* str, bool isCurve) {
+	if (!isCurve && ctx->lineJoin != VKVG_LINE_JOIN_ROUND)
+		return 3;
+	if (!str->arcStep)
+		str->arcStep = _get_arc_step (ctx, str->hw);
+	return 4 + (uint32_t)(M_PIF / str->arcStep);
+}
+//populate vertice buff for the join at p0 of the incoming and outgoing edges given by their unit directions and
+//lengths. Vertex and index caches have to be large enough for _join_max_vertices.
+static bool _build_vb_join (VkvgContext ctx, stroke_context_t* str, vec2 p0, vec2 v0n, vec2 v1n, float length_v0, float length_v1, bool isCurve){
+	Vertex v = {{0},ctx->curColor};
 	if (length_v0 < FLT_EPSILON || length_v1 < FLT_EPSILON) {
 		LOG(VKVG_LOG_STROKE, "vb_step discard, length<epsilon: l0:%f l1:%f\n", length_v0, length_v1);
 		return false;
 	}
-	vec2 v0n = vec2_div_s (v0, length_v0);
-	vec2 v1n = vec2_div_s (v1, length_v1);
 	float dot = vec2_dot (v0n, v1n);
 	float det = v0n.x * v1n.y - v0n.y * v1n.x;
 	if (EQUF(dot,1.0f)) {//colinear
@@ -921,12 +1555,12 @@ bool _build_vb_step(VkvgContext ctx, stroke_context_t* str, bool isCurve){
 		VKVG_IBO_INDEX_TYPE idx = (VKVG_IBO_INDEX_TYPE)(ctx->vertCount - ctx->curVertOffset);
 
 		v.pos = vec2_add(p0, vPerp);
-		_add_vertex(ctx, v);
+		_add_vertex_unchecked(ctx, v);
 		v.pos = vec2_sub(p0, vPerp);
-		_add_vertex(ctx, v);
+		_add_vertex_unchecked(ctx, v);
 
-		_add_triangle_indices(ctx, idx, idx+1, idx+2);
-		_add_triangle_indices(ctx, idx, idx+2, idx+3);
+		_add_triangle_indices_unchecked(ctx, idx, idx+1, idx+2);
+		_add_triangle_indices_unchecked(ctx, idx, idx+2, idx+3);
 		LOG(VKVG_LOG_STROKE, "vb_step cusp, dot==-1\n");
 		return true;
 	}
@@ -999,50 +1633,50 @@ bool _build_vb_step(VkvgContext ctx, stroke_context_t* str, bool isCurve){
 			bisec = vec2_mult_s (bisec_n_perp, str->lhMax);
 			if (det < 0) {
 				v.pos = rlh_inside_pos;
-				_add_vertex(ctx, v);
+				_add_vertex_unchecked(ctx, v);
 
 				vec2 p = vec2_sub(p0, bisec);
 
 				v.pos = vec2_sub(p, bisecPerp);
-				_add_vertex(ctx, v);
+				_add_vertex_unchecked(ctx, v);
 				v.pos = vec2_add(p, bisecPerp);
-				_add_vertex(ctx, v);
+				_add_vertex_unchecked(ctx, v);
 
-				_add_triangle_indices(ctx, idx, idx+2, idx+1);
-				_add_triangle_indices(ctx, idx+2, idx+4, idx);
-				_add_triangle_indices(ctx, idx, idx+3, idx+4);
+				_add_triangle_indices_unchecked(ctx, idx, idx+2, idx+1);
+				_add_triangle_indices_unchecked(ctx, idx+2, idx+4, idx);
+				_add_triangle_indices_unchecked(ctx, idx, idx+3, idx+4);
 				return true;
 			} else {
 				vec2 p = vec2_add(p0, bisec);
 				v.pos = vec2_sub(p, bisecPerp);
-				_add_vertex(ctx, v);
+				_add_vertex_unchecked(ctx, v);
 
 				v.pos = rlh_inside_pos;
-				_add_vertex(ctx, v);
+				_add_vertex_unchecked(ctx, v);
 
 				v.pos = vec2_add(p, bisecPerp);
-				_add_vertex(ctx, v);
+				_add_vertex_unchecked(ctx, v);
 
-				_add_triangle_indices(ctx, idx, idx+2, idx+1);
-				_add_triangle_indices(ctx, idx+2, idx+3, idx+1);
-				_add_triangle_indices(ctx, idx+1, idx+3, idx+4);
+				_add_triangle_indices_unchecked(ctx, idx, idx+2, idx+1);
+				_add_triangle_indices_unchecked(ctx, idx+2, idx+3, idx+1);
+				_add_triangle_indices_unchecked(ctx, idx+1, idx+3, idx+4);
 				return false;
 			}
 
 		} else {//normal miter
 			if (det < 0) {
 				v.pos = rlh_inside_pos;
-				_add_vertex(ctx, v);
+				_add_vertex_unchecked(ctx, v);
 				v.pos = rlh_outside_pos;
-				_add_vertex(ctx, v);
+				_add_vertex_unchecked(ctx, v);
 			} else {
 				v.pos = rlh_outside_pos;
-				_add_vertex(ctx, v);
+				_add_vertex_unchecked(ctx, v);
 				v.pos = rlh_inside_pos;
-				_add_vertex(ctx, v);
+				_add_vertex_unchecked(ctx, v);
 			}
 
-			_add_tri_indices_for_rect(ctx, idx);
+			_add_tri_indices_for_rect_unchecked(ctx, idx);
 			return false;
 		}
 	}else{
@@ -1053,27 +1687,27 @@ bool _build_vb_step(VkvgContext ctx, stroke_context_t* str, bool isCurve){
 				v.pos = rlh_inside_pos;
 			else
 				v.pos = vec2_add (p0, bisec);
-			_add_vertex(ctx, v);
+			_add_vertex_unchecked(ctx, v);
 			v.pos = vec2_sub (p0, vec2_mult_s (vp, str->hw));
 		}else{
 			v.pos = vec2_add (p0, vec2_mult_s (vp, str->hw));
-			_add_vertex(ctx, v);
+			_add_vertex_unchecked(ctx, v);
 			if (dot < 0 && rlh < lh)
 				v.pos = rlh_inside_pos;
 			else
 				v.pos = vec2_sub (p0, bisec);
 		}
-		_add_vertex(ctx, v);
+		_add_vertex_unchecked(ctx, v);
 
 		if (join == VKVG_LINE_JOIN_BEVEL){
 			if (det<0){
-				_add_triangle_indices(ctx, idx, idx+2, idx+1);
-				_add_triangle_indices(ctx, idx+2, idx+4, idx+0);
-				_add_triangle_indices(ctx, idx, idx+3, idx+4);
+				_add_triangle_indices_unchecked(ctx, idx, idx+2, idx+1);
+				_add_triangle_indices_unchecked(ctx, idx+2, idx+4, idx+0);
+				_add_triangle_indices_unchecked(ctx, idx, idx+3, idx+4);
 			}else{
-				_add_triangle_indices(ctx, idx, idx+2, idx+1);
-				_add_triangle_indices(ctx, idx+2, idx+3, idx+1);
-				_add_triangle_indices(ctx, idx+1, idx+3, idx+4);
+				_add_triangle_indices_unchecked(ctx, idx, idx+2, idx+1);
+				_add_triangle_indices_unchecked(ctx, idx+2, idx+3, idx+1);
+				_add_triangle_indices_unchecked(ctx, idx+1, idx+3, idx+4);
 			}
 		}else if (join == VKVG_LINE_JOIN_ROUND){
 			if (!str->arcStep)
@@ -1087,29 +1721,29 @@ bool _build_vb_step(VkvgContext ctx, stroke_context_t* str, bool isCurve){
 				float a1 = a + alpha;
 				a-=str->arcStep;
 				while (a > a1){
-					_add_vertexf(ctx, cosf(a) * str->hw + p0.x, sinf(a) * str->hw + p0.y);
+					_add_vertexf_unchecked(ctx, cosf(a) * str->hw + p0.x, sinf(a) * str->hw + p0.y);
 					a-=str->arcStep;
 				}
 			}else{
 				float a1 = a + alpha;
 				a+=str->arcStep;
 				while (a < a1){
-					_add_vertexf(ctx, cosf(a) * str->hw + p0.x, sinf(a) * str->hw + p0.y);
+					_add_vertexf_unchecked(ctx, cosf(a) * str->hw + p0.x, sinf(a) * str->hw + p0.y);
 					a+=str->arcStep;
 				}
 			}
 			VKVG_IBO_INDEX_TYPE p0Idx = (VKVG_IBO_INDEX_TYPE)(ctx->vertCount - ctx->curVertOffset);
-			_add_triangle_indices(ctx, idx, idx+2, idx+1);
+			_add_triangle_indices_unchecked(ctx, idx, idx+2, idx+1);
 			if (det < 0){
 				for (VKVG_IBO_INDEX_TYPE p = idx+2; p < p0Idx; p++)
-					_add_triangle_indices(ctx, p, p+1, idx);
-				_add_triangle_indices(ctx, p0Idx, p0Idx+2, idx);
-				_add_triangle_indices(ctx, idx, p0Idx+1, p0Idx+2);
+					_add_triangle_indices_unchecked(ctx, p, p+1, idx);
+				_add_triangle_indices_unchecked(ctx, p0Idx, p0Idx+2, idx);
+				_add_triangle_indices_unchecked(ctx, idx, p0Idx+1, p0Idx+2);
 			}else{
 				for (VKVG_IBO_INDEX_TYPE p = idx+2; p < p0Idx; p++)
-					_add_triangle_indices(ctx, p, p+1, idx+1);
-				_add_triangle_indices(ctx, p0Idx, p0Idx+1, idx+1);
-				_add_triangle_indices(ctx, idx+1, p0Idx+1, p0Idx+2);
+					_add_triangle_indices_unchecked(ctx, p, p+1, idx+1);
+				_add_triangle_indices_unchecked(ctx, p0Idx, p0Idx+1, idx+1);
+				_add_triangle_indices_unchecked(ctx, idx+1, p0Idx+1, p0Idx+2);
 			}
 
 		}
@@ -1119,7 +1753,7 @@ bool _build_vb_step(VkvgContext ctx, stroke_context_t* str, bool isCurve){
 			v.pos = vec2_sub (p0, vp);
 		else
 			v.pos = vec2_add (p0, vp);
-		_add_vertex(ctx, v);
+		_add_vertex_unchecked(ctx, v);
 	}
 
 /*
@@ -1140,9 +1774,23 @@ bool _build_vb_step(VkvgContext ctx, stroke_context_t* str, bool isCurve){
 	else*/
 	return (det < 0);
 }
+//populate vertice buff for stroke
+bool _build_vb_step(VkvgContext ctx, stroke_context_t* str, bool isCurve){
+	vec2 p0 = ctx->points[str->cp];
+	vec2 v0 = vec2_sub(p0, ctx->points[str->iL]);
+	vec2 v1 = vec2_sub(ctx->points[str->iR], p0);
+	float length_v0 = vec2_length(v0);
+	float length_v1 = vec2_length(v1);
+
+	uint32_t maxVerts = _join_max_vertices (ctx, str, isCurve);
+	_ensure_vertex_cache_size (ctx, maxVerts);
+	_ensure_index_cache_size (ctx, maxVerts * 3);
+
+	return _build_vb_join (ctx, str, p0, vec2_div_s (v0, length_v0), vec2_div_s (v1, length_v1), length_v0, length_v1, isCurve);
+}
 
 void _draw_stoke_cap (VkvgContext ctx, stroke_context_t *str, vec2 p0, vec2 n, bool isStart) {
-	Vertex v = {{0},ctx->curColor,{0,0,-1}};
+	Vertex v = {{0},ctx->curColor};
 
 	VKVG_IBO_INDEX_TYPE firstIdx = (VKVG_IBO_INDEX_TYPE)(ctx->vertCount - ctx->curVertOffset);
 
@@ -1241,13 +1889,8 @@ float _draw_dashed_segment (VkvgContext ctx, stroke_context_t* str, dash_context
 	dc->curDashOffset = fmodf(dc->curDashOffset, dc->totDashLength);
 	return segmentLength;
 }
-void _draw_segment (VkvgContext ctx, stroke_context_t* str, dash_context_t* dc, bool isCurve) {
-	str->iR = str->cp + 1;
-	if (ctx->dashCount > 0)
-		_draw_dashed_segment(ctx, str, dc, isCurve);
-	else
-		_build_vb_step (ctx, str, isCurve);
-	str->iL = str->cp++;
+//limit batch size to 1/3 of the ibo index type ability while stroking a path
+static void _check_stroke_batch_size (VkvgContext ctx, stroke_context_t* str) {
 	if (ctx->vertCount - ctx->curVertOffset > VKVG_IBO_MAX / 3) {
 		Vertex v0 = ctx->vertexCache[ctx->curVertOffset + str->firstIdx];
 		Vertex v1 = ctx->vertexCache[ctx->curVertOffset + str->firstIdx + 1];
@@ -1259,18 +1902,41 @@ void _draw_segment (VkvgContext ctx, stroke_context_t* str, dash_context_t* dc,
 		ctx->curVertOffset = ctx->vertCount;//prevent redrawing them at the start of the batch
 	}
 }
-
-bool ptInTriangle(vec2 p, vec2 p0, vec2 p1, vec2 p2) {
-	float dX = p.x-p2.x;
-	float dY = p.y-p2.y;
-	float dX21 = p2.x-p1.x;
-	float dY12 = p1.y-p2.y;
-	float D = dY12*(p0.x-p2.x) + dX21*(p0.y-p2.y);
-	float s = dY12*dX + dX21*dY;
-	float t = (p2.y-p0.y)*dX + (p0.x-p2.x)*dY;
-	if (D<0)
-		return (s<=0) && (t<=0) && (s+t>=D);
-	return (s>=0) && (t>=0) && (s+t<=D);
+void _draw_segment (VkvgContext ctx, stroke_context_t* str, dash_context_t* dc, bool isCurve) {
+	str->iR = str->cp + 1;
+	if (ctx->dashCount > 0)
+		_draw_dashed_segment(ctx, str, dc, isCurve);
+	else
+		_build_vb_step (ctx, str, isCurve);
+	str->iL = str->cp++;
+	_check_stroke_batch_size (ctx, str);
+}
+//stroke the straight undashed segments from the current point up to lastIdx. Edge directions and lengths are
+//computed in blocks of VKVG_STROKE_BATCH points with the vectorized kernel, and cache space for a block is
+//reserved once before building its joins.
+void _draw_polyline (VkvgContext ctx, stroke_context_t* str, uint32_t lastIdx) {
+	if (str->cp >= lastIdx)
+		return;
+	//first join may be with the closing edge of the path
+	_draw_segment (ctx, str, NULL, false);
+
+	vec2 dirs[VKVG_STROKE_BATCH + 1];
+	float lengths[VKVG_STROKE_BATCH + 1];
+	uint32_t maxVerts = _join_max_vertices (ctx, str, false);
+	uint32_t batch = MIN (VKVG_STROKE_BATCH, MAX (1, VKVG_IBO_MAX / 3 / maxVerts));
+
+	while (str->cp < lastIdx) {
+		uint32_t count = MIN (batch, lastIdx - str->cp);
+		_points_edges (&ctx->points[str->cp - 1], count + 2, dirs, lengths);
+		_ensure_vertex_cache_size (ctx, count * maxVerts);
+		_ensure_index_cache_size (ctx, count * maxVerts * 3);
+		for (uint32_t i = 0; i < count; i++) {
+			str->iR = str->cp + 1;
+			_build_vb_join (ctx, str, ctx->points[str->cp], dirs[i], dirs[i+1], lengths[i], lengths[i+1], false);
+			str->iL = str->cp++;
+		}
+		_check_stroke_batch_size (ctx, str);
+	}
 }
 
 void _free_ctx_save (vkvg_context_save_t* sav){
@@ -1280,183 +1946,40 @@ void _free_ctx_save (vkvg_context_save_t* sav){
 }
 
 
-#define M_APPROXIMATION_SCALE	1.0
-#define M_ANGLE_TOLERANCE		0.01
-#define M_CUSP_LIMIT			0.01
-#define CURVE_RECURSION_LIMIT	100
-#define CURVE_COLLINEARITY_EPSILON 1.7
-#define CURVE_ANGLE_TOLERANCE_EPSILON 0.001
-//no floating point arithmetic operation allowed in macro.
-#pragma warning(disable:4127)
-void _recursive_bezier (VkvgContext ctx, float distanceTolerance,
-						float x1, float y1, float x2, float y2,
-						float x3, float y3, float x4, float y4,
-						unsigned level) {
-	if(level > CURVE_RECURSION_LIMIT)
-	{
+//flatten a cubic bezier with forward differencing. The segment count is given by Wang's formula applied to the
+//control polygon in device space, so that the distance to the curve on screen stays below the tolerance.
+void _flatten_cubic (VkvgContext ctx, vec2 p0, vec2 p1, vec2 p2, vec2 p3) {
+	vec2 d0 = {p0.x - 2.f * p1.x + p2.x, p0.y - 2.f * p1.y + p2.y};
+	vec2 d1 = {p1.x - 2.f * p2.x + p3.x, p1.y - 2.f * p2.y + p3.y};
+	vec2 dd0 = d0, dd1 = d1;
+	vkvg_matrix_transform_distance (&ctx->pushConsts.mat, &dd0.x, &dd0.y);
+	vkvg_matrix_transform_distance (&ctx->pushConsts.mat, &dd1.x, &dd1.y);
+	float segs = ceilf (sqrtf (0.75f * fmaxf (vec2_length (dd0), vec2_length (dd1)) / ctx->tolerance));
+	if (!(segs > 1.f))//nan or straight
 		return;
+	uint32_t n = segs < VKVG_CURVE_MAX_SEGMENTS ? (uint32_t)segs : VKVG_CURVE_MAX_SEGMENTS;
+
+	//B(t) = a.t³ + b.t² + c.t + p0, differences are accumulated in double precision
+	double h = 1.0 / n, h2 = h * h, h3 = h2 * h;
+	double ax = p3.x - p0.x + 3.0 * (p1.x - p2.x), ay = p3.y - p0.y + 3.0 * (p1.y - p2.y);
+	double bx = 3.0 * d0.x, by = 3.0 * d0.y;
+	double cx = 3.0 * (p1.x - p0.x), cy = 3.0 * (p1.y - p0.y);
+
+	double x = p0.x, y = p0.y;
+	double dx = ax * h3 + bx * h2 + cx * h, dy = ay * h3 + by * h2 + cy * h;
+	double ddx = 6.0 * ax * h3 + 2.0 * bx * h2, ddy = 6.0 * ay * h3 + 2.0 * by * h2;
+	double dddx = 6.0 * ax * h3, dddy = 6.0 * ay * h3;
+
+	for (uint32_t i = 1; i < n; i++) {
+		x += dx;
+		y += dy;
+		dx += ddx;
+		dy += ddy;
+		ddx += dddx;
+		ddy += dddy;
+		_add_point (ctx, (float)x, (float)y);
 	}
-
-	// Calculate all the mid-points of the line segments
-	//----------------------
-	float x12	= (x1 + x2) / 2;
-	float y12	= (y1 + y2) / 2;
-	float x23	= (x2 + x3) / 2;
-	float y23	= (y2 + y3) / 2;
-	float x34	= (x3 + x4) / 2;
-	float y34	= (y3 + y4) / 2;
-	float x123	= (x12 + x23) / 2;
-	float y123	= (y12 + y23) / 2;
-	float x234	= (x23 + x34) / 2;
-	float y234	= (y23 + y34) / 2;
-	float x1234 = (x123 + x234) / 2;
-	float y1234 = (y123 + y234) / 2;
-
-	if(level > 0) // Enforce subdivision first time
-	{
-		// Try to approximate the full cubic curve by a single straight line
-		//------------------
-		float dx = x4-x1;
-		float dy = y4-y1;
-
-		float d2 = fabsf(((x2 - x4) * dy - (y2 - y4) * dx));
-		float d3 = fabsf(((x3 - x4) * dy - (y3 - y4) * dx));
-
-		float da1, da2;
-
-		if(d2 > CURVE_COLLINEARITY_EPSILON && d3 > CURVE_COLLINEARITY_EPSILON)
-		{
-			// Regular care
-			//-----------------
-			if((d2 + d3)*(d2 + d3) <= (dx*dx + dy*dy) * distanceTolerance)
-			{
-				// If the curvature doesn't exceed the distance_tolerance value
-				// we tend to finish subdivisions.
-				//----------------------
-				if (M_ANGLE_TOLERANCE < CURVE_ANGLE_TOLERANCE_EPSILON) {
-					_add_point(ctx, x1234, y1234);
-					return;
-				}
-
-				// Angle & Cusp Condition
-				//----------------------
-				float a23 = atan2f(y3 - y2, x3 - x2);
-				da1 = fabsf(a23 - atan2f(y2 - y1, x2 - x1));
-				da2 = fabsf(atan2f(y4 - y3, x4 - x3) - a23);
-				if(da1 >= M_PIF) da1 = M_2_PIF - da1;
-				if(da2 >= M_PIF) da2 = M_2_PIF - da2;
-
-				if(da1 + da2 < (float)M_ANGLE_TOLERANCE)
-				{
-					// Finally we can stop the recursion
-					//----------------------
-					_add_point (ctx, x1234, y1234);
-					return;
-				}
-
-				if(M_CUSP_LIMIT != 0.0)
-				{
-					if(da1 > M_CUSP_LIMIT)
-					{
-						_add_point (ctx, x2, y2);
-						return;
-					}
-
-					if(da2 > M_CUSP_LIMIT)
-					{
-						_add_point (ctx, x3, y3);
-						return;
-					}
-				}
-			}
-		} else {
-			if(d2 > CURVE_COLLINEARITY_EPSILON)
-			{
-				// p1,p3,p4 are collinear, p2 is considerable
-				//----------------------
-				if(d2 * d2 <= distanceTolerance * (dx*dx + dy*dy))
-				{
-					if(M_ANGLE_TOLERANCE < CURVE_ANGLE_TOLERANCE_EPSILON)
-					{
-						_add_point (ctx, x1234, y1234);
-						return;
-					}
-
-					// Angle Condition
-					//----------------------
-					da1 = fabsf(atan2f(y3 - y2, x3 - x2) - atan2f(y2 - y1, x2 - x1));
-					if(da1 >= M_PIF) da1 = M_2_PIF - da1;
-
-					if(da1 < M_ANGLE_TOLERANCE)
-					{
-						_add_point (ctx, x2, y2);
-						_add_point (ctx, x3, y3);
-						return;
-					}
-
-					if(M_CUSP_LIMIT != 0.0)
-					{
-						if(da1 > M_CUSP_LIMIT)
-						{
-							_add_point (ctx, x2, y2);
-							return;
-						}
-					}
-				}
-			} else if(d3 > CURVE_COLLINEARITY_EPSILON) {
-				// p1,p2,p4 are collinear, p3 is considerable
-				//----------------------
-				if(d3 * d3 <= distanceTolerance* (dx*dx + dy*dy))
-				{
-					if(M_ANGLE_TOLERANCE < CURVE_ANGLE_TOLERANCE_EPSILON)
-					{
-						_add_point (ctx, x1234, y1234);
-						return;
-					}
-
-					// Angle Condition
-					//----------------------
-					da1 = fabsf(atan2f(y4 - y3, x4 - x3) - atan2f(y3 - y2, x3 - x2));
-					if(da1 >= M_PIF) da1 = M_2_PIF - da1;
-
-					if(da1 < M_ANGLE_TOLERANCE)
-					{
-						_add_point (ctx, x2, y2);
-						_add_point (ctx, x3, y3);
-						return;
-					}
-
-					if(M_CUSP_LIMIT != 0.0)
-					{
-						if(da1 > M_CUSP_LIMIT)
-						{
-							_add_point (ctx, x3, y3);
-							return;
-						}
-					}
-				}
-			}
-			else
-			{
-				// Collinear case
-				//-----------------
-				dx = x1234 - (x1 + x4) / 2;
-				dy = y1234 - (y1 + y4) / 2;
-				if(dx*dx + dy*dy <= distanceTolerance)
-				{
-					_add_point (ctx, x1234, y1234);
-					return;
-				}
-			}
-		}
-	}
-
-	// Continue subdivision
-	//----------------------
-	_recursive_bezier (ctx, distanceTolerance, x1, y1, x12, y12, x123, y123, x1234, y1234, level + 1);
-	_recursive_bezier (ctx, distanceTolerance,x1234, y1234, x234, y234, x34, y34, x4, y4, level + 1);
 }
-#pragma warning(default:4127)
 void _line_to (VkvgContext ctx, float x, float y) {
 	vec2 p = {x,y};
 	if (!_current_path_is_empty (ctx)){
@@ -1542,7 +2065,7 @@ void _elliptic_arc (VkvgContext ctx, float x1, float y1, float x2, float y2, boo
 	double theta = sa;
 	double ea = sa + delta_theta;
 
-	float step = fmaxf(0.001f, fminf(M_PIF, _get_arc_step(ctx, fminf (rx, ry))*0.1f));
+	float step = _get_arc_step (ctx, fmaxf (rx, ry));
 
 	p = (vec2) {
 		rx * cosf (theta),
@@ -1565,29 +2088,10 @@ void _elliptic_arc (VkvgContext ctx, float x1, float y1, float x2, float y2, boo
 
 	_set_curve_start (ctx);
 
-	if (sa < ea) {
-		theta += step;
-		while (theta < ea) {
-			p = (vec2) {
-				rx * cosf (theta),
-				ry * sinf (theta)
-			};
-			xy = vec2_add (mat2_mult_vec2 (m, p), c);
-			_add_point (ctx, xy.x, xy.y);
-			theta += step;
-		}
-	} else {
-		theta -= step;
-		while (theta > ea) {
-			p = (vec2) {
-				rx * cosf (theta),
-				ry * sinf (theta)
-			};
-			xy = vec2_add (mat2_mult_vec2 (m, p), c);
-			_add_point (ctx, xy.x, xy.y);
-			theta -= step;
-		}
-	}
+	if (sa < ea)
+		_add_arc_points (ctx, c, rx, ry, &m, theta, step, (uint32_t)ceil ((ea - sa) / step) - 1);
+	else if (sa > ea)
+		_add_arc_points (ctx, c, rx, ry, &m, theta, -step, (uint32_t)ceil ((sa - ea) / step) - 1);
 	p = (vec2) {
 		rx * cosf (ea),
 		ry * sinf (ea)
@@ -1625,9 +2129,12 @@ void _poly_fill (VkvgContext ctx, vec4* bounds){
 		_ensure_renderpass_is_started (ctx);
 	}
 
-	CmdBindPipeline (ctx->cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, ctx->dev->pipelinePolyFill);
+	if (ctx->curFillRule == VKVG_FILL_RULE_EVEN_ODD)
+		CmdBindPipeline (ctx->cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, ctx->dev->pipelinePolyFill);
+	else//winding is counted in the stencil with front and back faces
+		CmdBindPipeline (ctx->cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, ctx->dev->pipelinePolyFillNZ);
 
-	Vertex v = {{0}, ctx->curColor, {0,0,-1}};
+	Vertex v = {{0}, ctx->curColor};
 	uint32_t ptrPath = 0;
 	uint32_t firstPtIdx = 0;
 
@@ -1639,21 +2146,11 @@ void _poly_fill (VkvgContext ctx, vec4* bounds){
 			for (uint32_t i = 0; i < pathPointCount; i++) {
 				v.pos = ctx->points [i+firstPtIdx];
 				ctx->vertexCache[ctx->vertCount++] = v;
-				if (!bounds)
-					continue;
-				//bounds are computed here to scissor the painting operation
-				//that speed up fill drastically.
-				vkvg_matrix_transform_point (&ctx->pushConsts.mat, &v.pos.x, &v.pos.y);
-
-				if (v.pos.x < bounds->xMin)
-					bounds->xMin = v.pos.x;
-				if (v.pos.x > bounds->xMax)
-					bounds->xMax = v.pos.x;
-				if (v.pos.y < bounds->yMin)
-					bounds->yMin = v.pos.y;
-				if (v.pos.y > bounds->yMax)
-					bounds->yMax = v.pos.y;
 			}
+			//bounds are computed here to scissor the painting operation
+			//that speed up fill drastically.
+			if (bounds)
+				_matrix_points_bounds (&ctx->pushConsts.mat, &ctx->points[firstPtIdx], pathPointCount, bounds);
 
 			LOG(VKVG_LOG_INFO_PATH, "\tpoly fill: point count = %d; 1st vert = %d; vert count = %d\n", pathPointCount, firstVertIdx, ctx->vertCount - firstVertIdx);
 			CmdDraw (ctx->cmd, pathPointCount, 1, firstVertIdx , 0);
@@ -1671,6 +2168,88 @@ void _poly_fill (VkvgContext ctx, vec4* bounds){
 	}
 	ctx->curVertOffset = ctx->vertCount;
 }
+//true if the current path has to be filled with stencil then cover for the non-zero rule, cpu tessellation is kept
+//for single contours of moderate size that may be batched. The stencil counter wraps at 8, so pathes that could
+//wind as many times around a point, whatever their contour count, are tessellated.
+bool _fill_non_zero_with_stencil (VkvgContext ctx) {
+#ifdef __APPLE__
+	return false;
+#else
+	if (ctx->windingBound > STENCIL_FILL_MASK)
+		return false;
+	return ctx->subpathCount > 1 ||
+			(ctx->pointCount > VKVG_NZ_STENCIL_THRESHOLD && !(ctx->pathes[0] & PATH_IS_CONVEX_BIT));
+#endif
+}
+//set fill bit where the winding counted by _poly_fill is not zero, counter bits are cleared by the cover pass.
+void _resolve_non_zero_stencil (VkvgContext ctx, vec4* bounds) {
+	CmdBindPipeline			(ctx->cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, ctx->dev->pipelineResolveNZ);
+	_draw_full_screen_quad	(ctx, bounds);
+}
+//fill a single convex contour as a triangle fan, return false if path is not convex
+bool _fill_convex (VkvgContext ctx) {
+	if (ctx->subpathCount != 1 || !(ctx->pathes[0] & PATH_IS_CONVEX_BIT))
+		return false;
+	Vertex v = {{0},ctx->curColor};
+	VKVG_IBO_INDEX_TYPE firstVertIdx = (VKVG_IBO_INDEX_TYPE)(ctx->vertCount - ctx->curVertOffset);
+	uint32_t pathPointCount = ctx->pathes[0] & PATH_ELT_MASK;
+
+	_ensure_vertex_cache_size(ctx, pathPointCount);
+	_ensure_index_cache_size(ctx, (pathPointCount-2)*3);
+
+	VKVG_IBO_INDEX_TYPE i = 0;
+	while (i < 2){
+		v.pos = ctx->points [i++];
+		_set_vertex (ctx, ctx->vertCount++, v);
+	}
+	while (i < pathPointCount){
+		v.pos = ctx->points [i];
+		_set_vertex (ctx, ctx->vertCount++, v);
+		_add_triangle_indices_unchecked(ctx, firstVertIdx, firstVertIdx + i - 1, firstVertIdx + i);
+		i++;
+	}
+	return true;
+}
+//triangulate a single simple contour with the monotone sweep of the tessellator, indices are written directly
+//in the index cache. Return false if path has several contours or is self intersecting.
+bool _fill_monotone (VkvgContext ctx) {
+#if VKVG_CUR_IBO_TYPE == VKVG_IBO_32
+	uint32_t pathPointCount = ctx->pathes[0] & PATH_ELT_MASK;
+	//simplicity check of the sweep is quadratic, larger contours go to stencil or earcut
+	if (pathPointCount < 3 || pathPointCount != ctx->pointCount || pathPointCount > VKVG_NZ_STENCIL_THRESHOLD)
+		return false;
+
+	VKVG_IBO_INDEX_TYPE firstVertIdx = (VKVG_IBO_INDEX_TYPE)(ctx->vertCount - ctx->curVertOffset);
+	uint32_t indCount = 0;
+
+	_ensure_index_cache_size(ctx, (pathPointCount-2)*3);
+	if (!tess_monotone (&ctx->tessArena, ctx->points, pathPointCount, firstVertIdx, &ctx->indexCache[ctx->indCount], &indCount))
+		return false;
+
+	_ensure_vertex_cache_size(ctx, pathPointCount);
+	Vertex v = {{0},ctx->curColor};
+	for (uint32_t i = 0; i < pathPointCount; i++) {
+		v.pos = ctx->points[i];
+		_set_vertex (ctx, ctx->vertCount++, v);
+	}
+	ctx->indCount += indCount;
+	return true;
+#else
+	return false;
+#endif
+}
+//monotone fill of a single contour, reusing the triangles of the device tessellation cache if enabled.
+bool _fill_monotone_cached (VkvgContext ctx) {
+	_mesh_key_t key;
+	uint64_t hash;
+	if (_mesh_cache_draw (ctx, vkvg_mesh_fill_even_odd, &key, &hash))
+		return true;
+	uint32_t firstVert = ctx->vertCount, firstInd = ctx->indCount;
+	if (!_fill_monotone (ctx))
+		return false;
+	_mesh_cache_store (ctx, &key, hash, firstVert, firstInd);
+	return true;
+}
 #ifdef VKVG_FILL_NZ_GLUTESS
 void fan_vertex2(VKVG_IBO_INDEX_TYPE v, VkvgContext ctx) {
 	VKVG_IBO_INDEX_TYPE i = (VKVG_IBO_INDEX_TYPE)v;
@@ -1731,7 +2310,7 @@ void combine2(const GLdouble newVertex[3],
 			 const GLfloat neighborWeight[4], void **outData, void *poly_data)
 {
 	VkvgContext ctx = (VkvgContext)poly_data;
-	Vertex v = {{newVertex[0],newVertex[1]},ctx->curColor, {0,0,-1}};
+	Vertex v = {{newVertex[0],newVertex[1]},ctx->curColor};
 	*outData = (void*)((unsigned long)(ctx->vertCount - ctx->curVertOffset));
 	_add_vertex(ctx, v);
 }
@@ -1741,34 +2320,25 @@ void vertex2(void *vertex_data, void *poly_data)
 	VkvgContext ctx = (VkvgContext)poly_data;
 	ctx->vertex_cb(i, ctx);
 }
+//create fill from current path with the glu tessellator, single simple contours are handled by the monotone sweep.
+//Triangles are reused from the device tessellation cache if enabled.
 void _fill_non_zero (VkvgContext ctx){
-	Vertex v = {{0},ctx->curColor, {0,0,-1}};
-
-	uint32_t ptrPath = 0;
-	uint32_t firstPtIdx = 0;
-
-	if (ctx->pathPtr == 1 && ctx->pathes[0] & PATH_IS_CONVEX_BIT) {
-		//simple concave rectangle or circle
-		VKVG_IBO_INDEX_TYPE firstVertIdx = (VKVG_IBO_INDEX_TYPE)(ctx->vertCount - ctx->curVertOffset);
-		uint32_t pathPointCount = ctx->pathes[ptrPath] & PATH_ELT_MASK;
-
-		_ensure_vertex_cache_size(ctx, pathPointCount);
-		_ensure_index_cache_size(ctx, (pathPointCount-2)*3);
-
-		VKVG_IBO_INDEX_TYPE i = 0;
-		while (i < 2){
-			v.pos = ctx->points [i++];
-			_set_vertex (ctx, ctx->vertCount++, v);
-		}
-		while (i < pathPointCount){
-			v.pos = ctx->points [i];
-			_set_vertex (ctx, ctx->vertCount++, v);
-			_add_triangle_indices_unchecked(ctx, firstVertIdx, firstVertIdx + i - 1, firstVertIdx + i);
-			i++;
-		}
+	if (_fill_convex (ctx))
+		return;
+	_mesh_key_t key;
+	uint64_t hash;
+	if (_mesh_cache_draw (ctx, vkvg_mesh_fill_non_zero, &key, &hash))
+		return;
+	uint32_t firstVert = ctx->vertCount, firstInd = ctx->indCount;
+	if (_fill_monotone (ctx)) {
+		_mesh_cache_store (ctx, &key, hash, firstVert, firstInd);
 		return;
 	}
 
+	Vertex v = {{0},ctx->curColor};
+
+	uint32_t ptrPath = 0;
+	uint32_t firstPtIdx = 0;
 
 	GLUtesselator *tess = gluNewTess();
 	gluTessProperty(tess, GLU_TESS_WINDING_RULE, GLU_TESS_WINDING_NONZERO);
@@ -1815,78 +2385,408 @@ void _fill_non_zero (VkvgContext ctx){
 	gluTessEndPolygon(tess);
 
 	gluDeleteTess(tess);
+
+	_mesh_cache_store (ctx, &key, hash, firstVert, firstInd);
 }
 #else
-//create fill from current path with ear clipping technic
+//create fill from current path with the earcut triangulation of the tessellator, small single simple contours are
+//handled by the monotone sweep. Triangles are reused from the device tessellation cache if enabled.
 void _fill_non_zero (VkvgContext ctx){
-	Vertex v = {{0},ctx->curColor, {0,0,-1}};
+	if (_fill_convex (ctx))
+		return;
+	_mesh_key_t key;
+	uint64_t hash;
+	if (_mesh_cache_draw (ctx, vkvg_mesh_fill_non_zero, &key, &hash))
+		return;
+	uint32_t firstVert = ctx->vertCount, firstInd = ctx->indCount;
+	if (_fill_monotone (ctx)) {
+		_mesh_cache_store (ctx, &key, hash, firstVert, firstInd);
+		return;
+	}
 
 	uint32_t ptrPath = 0;
-	uint32_t firstPtIdx = 0;
+	uint32_t contourCount = 0;
+	while (ptrPath < ctx->pathPtr){
+		uint32_t pathPointCount = ctx->pathes[ptrPath] & PATH_ELT_MASK;
+		if (pathPointCount > 2)
+			contourCount++;
+		if (_path_has_curves (ctx, ptrPath)) {
+			//skip segments lengths used in stroke
+			ptrPath++;
+			uint32_t totPts = 0;
+			while (totPts < pathPointCount)
+				totPts += (ctx->pathes[ptrPath++] & PATH_ELT_MASK);
+		}else
+			ptrPath++;
+	}
+	if (contourCount == 0)
+		return;
+	if (!tess_earcut_begin (&ctx->tessArena, ctx->points, ctx->pointCount, contourCount)) {
+		LOG(VKVG_LOG_ERR, "_fill_non_zero: earcut allocation failed\n");
+		ctx->status = VKVG_STATUS_NO_MEMORY;
+		return;
+	}
 
+	ptrPath = 0;
+	uint32_t firstPtIdx = 0;
 	while (ptrPath < ctx->pathPtr){
 		uint32_t pathPointCount = ctx->pathes[ptrPath] & PATH_ELT_MASK;
+		tess_earcut_contour (&ctx->tessArena, firstPtIdx, pathPointCount);
+
+		firstPtIdx += pathPointCount;
+		if (_path_has_curves (ctx, ptrPath)) {
+			ptrPath++;
+			uint32_t totPts = 0;
+			while (totPts < pathPointCount)
+				totPts += (ctx->pathes[ptrPath++] & PATH_ELT_MASK);
+		}else
+			ptrPath++;
+	}
+
+	//crossing contours are split, intersections are added after path points
+	const vec2* inters;
+	uint32_t interCount, maxIndCount;
+	if (!tess_earcut_resolve (&ctx->tessArena, &inters, &interCount, &maxIndCount)) {
+		LOG(VKVG_LOG_ERR, "_fill_non_zero: resolving crossing contours failed\n");
+		ctx->status = VKVG_STATUS_NO_MEMORY;
+		return;
+	}
+	if (interCount > 0 && ctx->vertCount - ctx->curVertOffset + ctx->pointCount + interCount > VKVG_IBO_MAX)
+		_emit_draw_cmd_undrawn_vertices(ctx);
+
+	VKVG_IBO_INDEX_TYPE firstVertIdx = (VKVG_IBO_INDEX_TYPE)(ctx->vertCount - ctx->curVertOffset);
+	Vertex v = {{0},ctx->curColor};
+	_ensure_vertex_cache_size (ctx, ctx->pointCount + interCount);
+	for (uint32_t i = 0; i < ctx->pointCount; i++) {
+		v.pos = ctx->points[i];
+		_set_vertex (ctx, ctx->vertCount++, v);
+	}
+	for (uint32_t i = 0; i < interCount; i++) {
+		v.pos = inters[i];
+		_set_vertex (ctx, ctx->vertCount++, v);
+	}
+
+	uint32_t indCount = 0;
+	bool done;
+#if VKVG_CUR_IBO_TYPE == VKVG_IBO_32
+	_ensure_index_cache_size (ctx, maxIndCount);
+	done = tess_earcut_end (&ctx->tessArena, firstVertIdx, &ctx->indexCache[ctx->indCount], &indCount);
+	ctx->indCount += indCount;
+#else
+	//earcut output is 32 bits, it is written at the end of the index cache then narrowed from the start
+	_ensure_index_cache_size (ctx, maxIndCount * 2);
+	uint32_t* indices = (uint32_t*)((uintptr_t)&ctx->indexCache[ctx->sizeIndices] & ~(uintptr_t)3) - maxIndCount;
+	done = tess_earcut_end (&ctx->tessArena, firstVertIdx, indices, &indCount);
+	for (uint32_t i = 0; i < indCount; i++)
+		ctx->indexCache[ctx->indCount++] = (VKVG_IBO_INDEX_TYPE)indices[i];
+#endif
+	if (!done) {
+		//triangles emitted before the failure are drawn, the partial mesh is not cached
+		LOG(VKVG_LOG_ERR, "_fill_non_zero: earcut triangulation failed\n");
+		ctx->status = VKVG_STATUS_NO_MEMORY;
+		return;
+	}
+	_mesh_cache_store (ctx, &key, hash, firstVert, firstInd);
+
+	//limit batch size here to 1/3 of the ibo index type ability
+	if (ctx->vertCount - ctx->curVertOffset > VKVG_IBO_MAX / 3)
+		_emit_draw_cmd_undrawn_vertices(ctx);
+}
+#endif
+
+//fringe width in user space for one device pixel, 0 if current matrix is degenerated
+float _aa_fringe_width (VkvgContext ctx) {
+	float sx, sy;
+	vkvg_matrix_get_scale (&ctx->pushConsts.mat, &sx, &sy);
+	float s = fminf (fabsf(sx), fabsf(sy));
+	return s > FLT_EPSILON ? 1.0f / s : 0;
+}
+//index of the next point of a closed ring that differs from pts[i], forward or backward
+static uint32_t _ring_neighbour (const vec2* pts, uint32_t count, uint32_t i, bool forward) {
+	uint32_t j = i;
+	for (uint32_t k = 1; k < count; k++) {
+		j = forward ? (j + 1) % count : (j + count - 1) % count;
+		if (!vec2_equ (pts[j], pts[i]))
+			return j;
+	}
+	return i;
+}
+//add a one pixel wide fringe along a closed ring with a coverage fading from the ring to zero on the outer border.
+//side is 1 if the fringe lies on the vec2_perp side of the ring direction, -1 otherwise.
+void _add_aa_fringe (VkvgContext ctx, const vec2* pts, uint32_t count, float side, float width) {
+	if (count < 2 || width <= 0 || _ring_neighbour (pts, count, 0, true) == 0)
+		return;
+	if (ctx->vertCount - ctx->curVertOffset + 2 * count > VKVG_IBO_MAX)
+		_emit_draw_cmd_undrawn_vertices(ctx);//limit draw call to addressable vx with choosen index type
+
+	_ensure_vertex_cache_size (ctx, 2 * count);
+	_ensure_index_cache_size (ctx, 6 * count);
 
+	VKVG_IBO_INDEX_TYPE firstIdx = (VKVG_IBO_INDEX_TYPE)(ctx->vertCount - ctx->curVertOffset);
+	Vertex vIn = {{0}, ctx->curColor};
+#ifdef VKVG_PREMULT_ALPHA
+	Vertex vOut = {{0}, 0};//transparent
+#else
+	Vertex vOut = {{0}, ctx->curColor & 0x00FFFFFF};//transparent
+#endif
+
+	for (uint32_t i = 0; i < count; i++) {
+		vec2 p = pts[i];
+		vec2 n0 = vec2_perp (vec2_line_norm (pts[_ring_neighbour (pts, count, i, false)], p));
+		vec2 n1 = vec2_perp (vec2_line_norm (p, pts[_ring_neighbour (pts, count, i, true)]));
+		vec2 n = vec2_add (n0, n1);
+		float l = vec2_length (n);
+		if (l < 1e-3f)//cusp
+			n = n1;
+		else {//miter direction, length clamped for sharp corners
+			n = vec2_div_s (n, l);
+			n = vec2_div_s (n, fmaxf (vec2_dot (n, n1), 0.25f));
+		}
+		vIn.pos = p;
+		vOut.pos = vec2_add (p, vec2_mult_s (n, width * side));
+		_set_vertex (ctx, ctx->vertCount++, vIn);
+		_set_vertex (ctx, ctx->vertCount++, vOut);
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		VKVG_IBO_INDEX_TYPE a = firstIdx + 2 * i;
+		VKVG_IBO_INDEX_TYPE c = firstIdx + 2 * ((i + 1) % count);
+		_add_triangle_indices_unchecked (ctx, a, a + 1, c);
+		_add_triangle_indices_unchecked (ctx, c, a + 1, c + 1);
+	}
+}
+//signed area of a closed ring
+static float _ring_area (const vec2* pts, uint32_t count) {
+	float a = 0;
+	for (uint32_t i = 0, j = count - 1; i < count; j = i++)
+		a += pts[j].x * pts[i].y - pts[i].x * pts[j].y;
+	return a * 0.5f;
+}
+//winding number of p around a closed ring, positive for rings with a positive area
+static int32_t _ring_winding (const vec2* pts, uint32_t count, vec2 p) {
+	int32_t w = 0;
+	for (uint32_t i = 0, j = count - 1; i < count; j = i++) {
+		vec2 a = pts[j], b = pts[i];
+		float isLeft = (b.x - a.x) * (p.y - a.y) - (p.x - a.x) * (b.y - a.y);
+		if (a.y <= p.y) {
+			if (b.y > p.y && isLeft > 0)
+				w++;
+		} else if (b.y <= p.y && isLeft < 0)
+			w--;
+	}
+	return w;
+}
+static bool _winding_is_filled (VkvgContext ctx, int32_t w) {
+	return ctx->curFillRule == VKVG_FILL_RULE_EVEN_ODD ? (w & 1) != 0 : w != 0;
+}
+//add fringes outside of the filled area along each subpath of the current path. Winding around the first point of
+//a subpath tells if it borders the fill, subpathes separating two filled or two empty areas are skipped.
+void _fill_aa_fringe (VkvgContext ctx) {
+	float width = _aa_fringe_width (ctx);
+	if (width == 0)
+		return;
+
+	if (!tess_arena_reserve (&ctx->tessArena, ctx->pathPtr * 2 * sizeof(uint32_t)))
+		return;
+	uint32_t* subpathes = (uint32_t*)ctx->tessArena.mem;//first point and count
+	uint32_t subpathCount = 0;
+	uint32_t ptrPath = 0;
+	uint32_t firstPtIdx = 0;
+
+	while (ptrPath < ctx->pathPtr){
+		uint32_t pathPointCount = ctx->pathes[ptrPath] & PATH_ELT_MASK;
 		if (pathPointCount > 2) {
-			VKVG_IBO_INDEX_TYPE firstVertIdx = (VKVG_IBO_INDEX_TYPE)(ctx->vertCount - ctx->curVertOffset);
-			ear_clip_point* ecps = (ear_clip_point*)malloc(pathPointCount*sizeof(ear_clip_point));
-			uint32_t ecps_count = pathPointCount;
-			VKVG_IBO_INDEX_TYPE i = 0;
+			subpathes[subpathCount * 2] = firstPtIdx;
+			subpathes[subpathCount * 2 + 1] = pathPointCount;
+			subpathCount++;
+		}
+		firstPtIdx += pathPointCount;
+		if (_path_has_curves (ctx, ptrPath)) {
+			//skip segments lengths used in stroke
+			ptrPath++;
+			uint32_t totPts = 0;
+			while (totPts < pathPointCount)
+				totPts += (ctx->pathes[ptrPath++] & PATH_ELT_MASK);
+		}else
+			ptrPath++;
+	}
 
-			//init points link list
-			while (i < pathPointCount-1){
-				v.pos = ctx->points[i+firstPtIdx];
-				ear_clip_point ecp = {v.pos, firstVertIdx+i, &ecps[i+1]};
-				ecps[i] = ecp;
-				_add_vertex(ctx, v);
-				i++;
-			}
+	for (uint32_t s = 0; s < subpathCount; s++) {
+		vec2* pts = &ctx->points[subpathes[s * 2]];
+		uint32_t count = subpathes[s * 2 + 1];
+		float area = _ring_area (pts, count);
+		if (area == 0)
+			continue;
+		int32_t w = 0;
+		for (uint32_t o = 0; o < subpathCount; o++) {
+			if (o != s)
+				w += _ring_winding (&ctx->points[subpathes[o * 2]], subpathes[o * 2 + 1], pts[0]);
+		}
+		bool outFilled = _winding_is_filled (ctx, w);
+		if (outFilled == _winding_is_filled (ctx, area > 0 ? w + 1 : w - 1))
+			continue;
+		_add_aa_fringe (ctx, pts, count, (area > 0) != outFilled ? 1.0f : -1.0f, width);
+	}
+}
 
-			v.pos = ctx->points[i+firstPtIdx];
-			ear_clip_point ecp = {v.pos, firstVertIdx+i, ecps};
-			ecps[i] = ecp;
-			_add_vertex(ctx, v);
+//stroke outlines rings, their first point and count are stored at the start of the arena followed by their points.
+typedef struct {
+	tess_arena_t*	arena;
+	size_t			offset;		//first point
+	uint32_t		count;
+	uint32_t		size;
+	uint32_t		ringCount;
+} _outline_t;
 
-			ear_clip_point* ecp_current = ecps;
-			uint32_t tries = 0;
+static void _outline_add (_outline_t* o, vec2 p) {
+	if (o->count == o->size) {
+		uint32_t size = o->size ? o->size * 2 : 64;
+		if (!tess_arena_reserve (o->arena, o->offset + size * sizeof(vec2)))
+			return;
+		o->size = size;
+	}
+	((vec2*)((char*)o->arena->mem + o->offset))[o->count++] = p;
+}
+//close the ring of the points added since 'first'
+static void _outline_end_ring (_outline_t* o, uint32_t first) {
+	uint32_t* rings = (uint32_t*)o->arena->mem;
+	rings[o->ringCount * 2] = first;
+	rings[o->ringCount * 2 + 1] = o->count - first;
+	o->ringCount++;
+}
+//points of an arc of radius hw around c, starting from direction n and rotating toward q, end points excluded.
+static void _outline_add_arc (VkvgContext ctx, _outline_t* o, vec2 c, vec2 n, vec2 q, float angle, float hw) {
+	float step = _get_arc_step (ctx, hw);
+	for (float a = step; a < angle; a += step)
+		_outline_add (o, vec2_add (c, vec2_mult_s (vec2_add (vec2_mult_s (n, cosf(a)), vec2_mult_s (q, sinf(a))), hw)));
+}
+//outline of the cap at point p of direction d, from the vec2_perp side to the opposite one, butt caps add nothing.
+static void _outline_add_cap (VkvgContext ctx, _outline_t* o, vec2 p, vec2 d, float hw) {
+	vec2 n = vec2_perp (d);
+	if (ctx->lineCap == VKVG_LINE_CAP_SQUARE) {
+		_outline_add (o, vec2_add (p, vec2_mult_s (vec2_add (d, n), hw)));
+		_outline_add (o, vec2_add (p, vec2_mult_s (vec2_sub (d, n), hw)));
+	} else if (ctx->lineCap == VKVG_LINE_CAP_ROUND)
+		_outline_add_arc (ctx, o, p, n, d, M_PIF, hw);
+}
+//outline of the vec2_perp side of a polyline offset by the half line width, with the joins of the stroke.
+static void _outline_add_side (VkvgContext ctx, _outline_t* o, const vec2* pts, uint32_t count, bool closed, float hw) {
+	for (uint32_t i = 0; i < count; i++) {
+		vec2 p = pts[i];
+		if (!closed && (i == 0 || i == count - 1)) {
+			vec2 d = i == 0 ? vec2_line_norm (p, pts[1]) : vec2_line_norm (pts[i - 1], p);
+			_outline_add (o, vec2_add (p, vec2_mult_s (vec2_perp (d), hw)));
+			continue;
+		}
+		vec2 pPrev = pts[(i + count - 1) % count], pNext = pts[(i + 1) % count];
+		vec2 d0 = vec2_line_norm (pPrev, p), d1 = vec2_line_norm (p, pNext);
+		vec2 n0 = vec2_perp (d0), n1 = vec2_perp (d1);
+		float dot = vec2_dot (n0, n1);
+
+		if (dot > 0.999f) {//colinear
+			_outline_add (o, vec2_add (p, vec2_mult_s (vec2_norm (vec2_add (n0, n1)), hw)));
+			continue;
+		}
+		if (dot < -0.999f) {//cusp
+			_outline_add (o, vec2_add (p, vec2_mult_s (n0, hw)));
+			if (ctx->lineJoin == VKVG_LINE_JOIN_ROUND)
+				_outline_add_arc (ctx, o, p, n0, d0, M_PIF, hw);
+			_outline_add (o, vec2_add (p, vec2_mult_s (n1, hw)));
+			continue;
+		}
 
-			while (ecps_count > 3) {
-				if (tries > ecps_count) {
-					break;
-				}
-				ear_clip_point* v0 = ecp_current->next,
-						*v1 = ecp_current, *v2 = ecp_current->next->next;
-				if (ecp_zcross (v0, v2, v1)<0){
-					ecp_current = ecp_current->next;
-					tries++;
-					continue;
-				}
-				ear_clip_point* vP = v2->next;
-				bool isEar = true;
-				while (vP!=v1){
-					if (ptInTriangle (vP->pos, v0->pos, v2->pos, v1->pos)){
-						isEar = false;
-						break;
-					}
-					vP = vP->next;
-				}
-				if (isEar){
-					_add_triangle_indices (ctx, v0->idx, v1->idx, v2->idx);
-					v1->next = v2;
-					ecps_count --;
-					tries = 0;
-				}else{
-					ecp_current = ecp_current->next;
-					tries++;
-				}
+		vec2 m = vec2_mult_s (vec2_add (n0, n1), hw / (1.0f + dot));//miter offset
+		float lm = vec2_length (m);
+
+		if (vec2_det (d0, d1) < 0) {//inner side, limit miter to segments lengths like the stroke does
+			float lMax = fminf (vec2_length (vec2_sub (p, pPrev)), vec2_length (vec2_sub (pNext, p)));
+			if (lm > lMax)
+				m = vec2_mult_s (m, lMax / lm);
+			_outline_add (o, vec2_add (p, m));
+			continue;
+		}
+
+		switch (ctx->lineJoin) {
+		case VKVG_LINE_JOIN_MITER:
+		{
+			float lhMax = ctx->miterLimit * ctx->lineWidth;
+			if (lm <= lhMax) {
+				_outline_add (o, vec2_add (p, m));
+				break;
 			}
-			if (ecps_count == 3)
-				_add_triangle_indices(ctx, ecp_current->next->idx, ecp_current->idx, ecp_current->next->next->idx);
-			free (ecps);
+			//clipped miter
+			vec2 mn = vec2_div_s (m, lm);
+			float t0 = (lhMax - hw * vec2_dot (n0, mn)) / vec2_dot (d0, mn);
+			float t1 = (lhMax - hw * vec2_dot (n1, mn)) / -vec2_dot (d1, mn);
+			_outline_add (o, vec2_add (p, vec2_add (vec2_mult_s (n0, hw), vec2_mult_s (d0, t0))));
+			_outline_add (o, vec2_sub (vec2_add (p, vec2_mult_s (n1, hw)), vec2_mult_s (d1, t1)));
+			break;
+		}
+		case VKVG_LINE_JOIN_ROUND:
+			_outline_add (o, vec2_add (p, vec2_mult_s (n0, hw)));
+			_outline_add_arc (ctx, o, p, n0, d0, acosf (dot), hw);
+			_outline_add (o, vec2_add (p, vec2_mult_s (n1, hw)));
+			break;
+		default:
+			_outline_add (o, vec2_add (p, vec2_mult_s (n0, hw)));
+			_outline_add (o, vec2_add (p, vec2_mult_s (n1, hw)));
+			break;
+		}
+	}
+}
+static void _reverse_points (vec2* pts, uint32_t count) {
+	for (uint32_t i = 0, j = count - 1; i < j; i++, j--) {
+		vec2 tmp = pts[i];
+		pts[i] = pts[j];
+		pts[j] = tmp;
+	}
+}
+//add fringes along the outlines of the stroke of each subpath, the stroke body always lies on the opposite side of
+//vec2_perp of the outlines. Closed subpathes have an outline on each side, open ones a single one joining the caps.
+//Outlines of overlapping parts and inner joins are merged first with the non-zero rule of the earcut tessellator,
+//so that fringes stay outside of the stroke.
+void _stroke_aa_fringe (VkvgContext ctx) {
+	float width = _aa_fringe_width (ctx);
+	float hw = ctx->lineWidth * 0.5f;
+	if (width == 0 || hw <= 0 || ctx->dashCount > 0)
+		return;
 
-			//limit batch size here to 1/3 of the ibo index type ability
-			if (ctx->vertCount - ctx->curVertOffset > VKVG_IBO_MAX / 3)
-				_emit_draw_cmd_undrawn_vertices(ctx);
+	//polylines without repeated points are built in the tessellator arena, free until outlines are merged
+	_outline_t o = {&ctx->outlineArena, ctx->pathPtr * 4 * sizeof(uint32_t), 0, 0, 0};
+	if (!tess_arena_reserve (&ctx->tessArena, ctx->pointCount * sizeof(vec2)) || !tess_arena_reserve (o.arena, o.offset))
+		return;
+	vec2* pts = (vec2*)ctx->tessArena.mem;
+	uint32_t ptrPath = 0;
+	uint32_t firstPtIdx = 0;
+
+	while (ptrPath < ctx->pathPtr){
+		uint32_t pathPointCount = ctx->pathes[ptrPath] & PATH_ELT_MASK;
+		bool closed = _path_is_closed (ctx, ptrPath);
+
+		//skip repeated points
+		uint32_t count = 0;
+		for (uint32_t i = 0; i < pathPointCount; i++) {
+			vec2 p = ctx->points[firstPtIdx + i];
+			if (count == 0 || vec2_length (vec2_sub (p, pts[count - 1])) > FLT_EPSILON)
+				pts[count++] = p;
+		}
+		if (closed && count > 1 && vec2_length (vec2_sub (pts[0], pts[count - 1])) <= FLT_EPSILON)
+			count--;
+
+		uint32_t first = o.count;
+		if (closed && count > 2) {
+			_outline_add_side (ctx, &o, pts, count, true, hw);
+			_outline_end_ring (&o, first);
+			_reverse_points (pts, count);
+			first = o.count;
+			_outline_add_side (ctx, &o, pts, count, true, hw);
+			_outline_end_ring (&o, first);
+		} else if (count > 1) {
+			_outline_add_side (ctx, &o, pts, count, false, hw);
+			_outline_add_cap (ctx, &o, pts[count - 1], vec2_line_norm (pts[count - 2], pts[count - 1]), hw);
+			_reverse_points (pts, count);
+			_outline_add_side (ctx, &o, pts, count, false, hw);
+			_outline_add_cap (ctx, &o, pts[count - 1], vec2_line_norm (pts[count - 2], pts[count - 1]), hw);
+			_outline_end_ring (&o, first);
 		}
 
 		firstPtIdx += pathPointCount;
@@ -1899,32 +2799,40 @@ void _fill_non_zero (VkvgContext ctx){
 		}else
 			ptrPath++;
 	}
+	if (o.ringCount == 0)
+		return;
+
+	const vec2* outline = (const vec2*)((char*)o.arena->mem + o.offset);
+	const uint32_t* rings = (const uint32_t*)o.arena->mem;
+	if (tess_earcut_begin (&ctx->tessArena, outline, o.count, o.ringCount)) {
+		for (uint32_t r = 0; r < o.ringCount; r++)
+			tess_earcut_contour (&ctx->tessArena, rings[r * 2], rings[r * 2 + 1]);
+		const vec2* inters;
+		uint32_t interCount, maxIndCount;
+		if (tess_earcut_resolve (&ctx->tessArena, &inters, &interCount, &maxIndCount)) {
+			const vec2* ring;
+			uint32_t count;
+			bool perpFilled;
+			for (uint32_t r = 0; tess_earcut_boundary (&ctx->tessArena, r, &ring, &count, &perpFilled); r++)
+				_add_aa_fringe (ctx, ring, count, perpFilled ? -1.0f : 1.0f, width);
+			return;
+		}
+	}
+	//outlines can't be merged without memory
+	for (uint32_t r = 0; r < o.ringCount; r++)
+		_add_aa_fringe (ctx, outline + rings[r * 2], rings[r * 2 + 1], 1.0f, width);
 }
-#endif
 
 void _vkvg_path_extents (VkvgContext ctx, bool transformed, float *x1, float *y1, float *x2, float *y2) {
 	uint32_t ptrPath = 0;
 	uint32_t firstPtIdx = 0;
 
-	float xMin = FLT_MAX, yMin = FLT_MAX;
-	float xMax = FLT_MIN, yMax = FLT_MIN;
+	vec4 bounds = {{FLT_MAX}, {FLT_MAX}, {FLT_MIN}, {FLT_MIN}};
 
 	while (ptrPath < ctx->pathPtr){
 		uint32_t pathPointCount = ctx->pathes[ptrPath] & PATH_ELT_MASK;
 
-		for (uint32_t i = firstPtIdx; i < firstPtIdx + pathPointCount; i++){
-			vec2 p = ctx->points[i];
-			if (transformed)
-				vkvg_matrix_transform_point (&ctx->pushConsts.mat, &p.x, &p.y);
-			if (p.x < xMin)
-				xMin = p.x;
-			if (p.x > xMax)
-				xMax = p.x;
-			if (p.y < yMin)
-				yMin = p.y;
-			if (p.y > yMax)
-				yMax = p.y;
-		}
+		_matrix_points_bounds (transformed ? &ctx->pushConsts.mat : NULL, &ctx->points[firstPtIdx], pathPointCount, &bounds);
 
 		firstPtIdx += pathPointCount;
 		if (_path_has_curves (ctx, ptrPath)) {
@@ -1936,10 +2844,10 @@ void _vkvg_path_extents (VkvgContext ctx, bool transformed, float *x1, float *y1
 		}else
 			ptrPath++;
 	}
-	*x1 = xMin;
-	*x2 = xMax;
-	*y1 = yMin;
-	*y2 = yMax;
+	*x1 = bounds.xMin;
+	*x2 = bounds.xMax;
+	*y1 = bounds.yMin;
+	*y2 = bounds.yMax;
 }
 
 void _draw_full_screen_quad (VkvgContext ctx, vec4* scissor) {
@@ -27,6 +27,9 @@
 #include "vkvg_buff.h"
 #include "vkh.h"
 #include "vkvg_fonts.h"
+#include "vkvg_tessellator.h"
+#include "vkvg_mesh_cache.h"
+#include "vkvg_matrix.h"
 
 #if VKVG_RECORDING
 	#include "recording/vkvg_record_internal.h"
@@ -40,6 +43,15 @@
 #define VKVG_IBO_SIZE				(VKVG_VBO_SIZE * 6)
 #define VKVG_PATHES_SIZE			16
 #define VKVG_ARRAY_THRESHOLD		8
+#define VKVG_NZ_STENCIL_THRESHOLD	64	//above this point count, concave non-zero fills use stencil then cover
+#define VKVG_TOLERANCE_DEFAULT		0.1f
+#define VKVG_TOLERANCE_MIN			0.001f
+#define VKVG_CURVE_MAX_SEGMENTS		4096//flattening segments limit for one curve
+#define VKVG_ARC_MIN_STEP			0.001f
+#define VKVG_STROKE_BATCH			256	//points per block of the polyline stroker
+#ifndef VKVG_TRIM_FLUSH_PERIOD
+	#define VKVG_TRIM_FLUSH_PERIOD	32	//flush count between two checks for cache shrinking
+#endif
 
 #define VKVG_IBO_16					0
 #define VKVG_IBO_32					1
@@ -66,12 +78,80 @@
 	#define CreateRgbaf(r, g, b, a) (((int)(a * 255.0f) << 24) | ((int)(b * 255.0f) << 16) | ((int)(g * 255.0f) << 8) | (int)(r * 255.0f))
 #endif
 
+//compact vertex of vector geometry, uv shader input is fed by the device default uv buffer.
 typedef struct {
 	vec2		pos;
 	uint32_t	color;
-	vec3		uv;
 } Vertex;
 
+//glyph instance, stored in two vertex slots of the vbo.
+typedef struct {
+	vec2		pos;			//bitmap top left corner
+	uint32_t	color;
+	vec2i16		size;			//bitmap size in pixels
+	vec2i16		texel;			//bitmap top left corner in font cache page
+	float		page;			//font cache array layer
+} GlyphInstance;
+
+//axis aligned rectangle instance, stored in two vertex slots of the vbo.
+typedef struct {
+	vec2		pos;
+	uint32_t	color;
+	vec2		size;
+	uint32_t	unused;
+} RectInstance;
+
+//circle, ellipse or rounded rectangle instance, stored in three vertex slots of the vbo.
+typedef struct {
+	vec2		center;
+	uint32_t	color;
+	vec2		halfSize;
+	float		radius;			//corner radius, negative for ellipses
+	float		strokeHalf;		//half line width, 0 for fills
+	float		margin;			//antialiasing margin in user space units
+	uint32_t	unused;
+} SdfInstance;
+
+#define LINE_NO_SEGMENT		0x1		//no stroke segment starts at this point
+#define LINE_CAP			0x2		//open path end, join type is in bits 2-3, cap type in bits 4-5
+
+//stroke centerline point, stored in two vertex slots of the vbo. Line instances read four consecutive records.
+typedef struct {
+	vec2		pos;
+	uint32_t	color;
+	float		halfWidth;
+	float		arcLength;		//distance from the subpath start, for dashes
+	uint32_t	flags;
+} LineRecord;
+
+//instance type of the undrawn instances run
+typedef enum {
+	vkvg_instance_rect,
+	vkvg_instance_sdf,
+	vkvg_instance_line,
+} vkvg_instance_type_t;
+
+//rounded shape making the whole current path, valid while the path point count is unchanged.
+typedef struct {
+	uint32_t	pointCount;		//path point count once the shape was added, 0 if none
+	vec2		center;
+	vec2		halfSize;
+	float		radius;			//corner radius, negative for ellipses
+} _sdf_shape_t;
+
+//convexity of the current subpath, updated for each added point. Edges have to turn always in the same direction
+//and their x and y directions may change only twice to make a single turn. Direction changes are still counted once
+//the subpath is concave, they bound its winding number (see _path_winding_bound).
+typedef struct {
+	vec2		firstEdge;		//first non null edge of the subpath
+	vec2		lastEdge;
+	uint32_t	edgeCount;		//non null edges
+	int8_t		turn;			//sign of the turns, 0 until a non colinear edge is found
+	int8_t		lastDir[2];		//sign of x and y of the last edge having them non null
+	uint32_t	dirChanges[2];	//x and y direction changes count
+	bool		convex;
+} _convexity_t;
+
 typedef struct {
 	vec4			source;
 	vec2			size;
@@ -81,6 +161,18 @@ typedef struct {
 	vkvg_matrix_t	matInv;
 } push_constants;
 
+#define VKVG_GPU_DASH_MAX	8		//longest dash pattern evaluated by the stroke segments fragment shader
+#define VKVG_HAIRLINE_WIDTH	1.0f	//strokes thinner on the surface are drawn one pixel wide with a reduced coverage
+
+//push constants of the stroke segments pipeline, following the common ones. Line instances
+//are drawn in runs sharing those values.
+typedef struct {
+	float			miterLimit;
+	float			dashOffset;
+	float			dashTotal;		//pattern length, 0 for solid strokes
+	float			dashes[VKVG_GPU_DASH_MAX];
+} line_push_constants;
+
 /* context.curClipState may be one of the following, it's set
  * with check of the previous saved state:
  * - none: no clipping operation since the previous state
@@ -112,6 +204,9 @@ typedef struct _vkvg_context_save_t {
 	vkvg_line_cap_t			lineCap;
 	vkvg_line_join_t		lineJoint;
 	vkvg_fill_rule_t		curFillRule;
+	vkvg_antialias_t		antialias;
+	float					tolerance;
+	vkvg_stroke_mode_t		strokeMode;
 
 	long					selectedCharSize; /* Font size*/
 	char					selectedFontName[FONT_NAME_MAX_SIZE];
@@ -125,6 +220,15 @@ typedef struct _vkvg_context_save_t {
 
 } vkvg_context_save_t;
 
+//contiguous indices of the cache emitted with the same index type, 16bit indices are narrowed
+//from the cache when copied to the ibo.
+typedef struct {
+	uint32_t			cacheStart;		//first index in the index cache
+	uint32_t			count;			//index count
+	uint32_t			iboOffset;		//byte offset in the ibo
+	VkIndexType			type;
+} _index_run_t;
+
 typedef struct _vkvg_context_t {
 	vkvg_status_t		status;
 	uint32_t			references;		//reference count
@@ -139,7 +243,7 @@ typedef struct _vkvg_context_t {
 	VkCommandBuffer		cmd;			//current recording buffer
 	bool				cmdStarted;		//prevent flushing empty renderpass
 	bool				pushCstDirty;	//prevent pushing to gpu if not requested
-	VkDescriptorPool	descriptorPool;	//one pool per thread
+	VkDescriptorPool	descriptorPool;	//device shared pool the descriptor sets are allocated from
 	VkDescriptorSet		dsFont;			//fonts glyphs texture atlas descriptor (local for thread safety)
 	VkDescriptorSet		dsSrc;			//source ds
 	VkDescriptorSet		dsGrad;			//gradient uniform buffer
@@ -170,7 +274,17 @@ typedef struct _vkvg_context_t {
 	uint32_t			indCount;		//current indice count
 
 	uint32_t			curIndStart;	//last index recorded in cmd buff
+	uint32_t			vertexDraws;	//draw commands of undrawn vertices, tells if a geometry was split in several batches
 	VKVG_IBO_INDEX_TYPE	curVertOffset;	//vertex offset in draw indexed command
+	VkIndexType			boundIndexType;	//index type of the ibo binding in the current cmd buff
+	_index_run_t*		indexRuns;		//emitted draws index ranges, written to the ibo on vertices flush
+	uint32_t			sizeIndexRuns;	//reserved size
+	uint32_t			indexRunCount;	//effective run count
+	uint32_t			iboBytes;		//bytes of ibo used by index runs
+	vkvg_instance_type_t instType;		//type of undrawn instances
+	line_push_constants	linePushConsts;	//miter limit and dash pattern of undrawn line instances
+	uint32_t			instStart;		//first vertex slot of undrawn instances
+	uint32_t			instCount;		//undrawn instances, drawn before undrawn indices
 
 	vkvg_buff			vertices;		//vertex buffer with persistent mapped memory
 	uint32_t			sizeVBO;		//size of vk vbo size
@@ -192,7 +306,21 @@ typedef struct _vkvg_context_t {
 
 	uint32_t			segmentPtr;		//current segment count in current path having curves
 	uint32_t			subpathCount;	//store count of subpath, not straight forward to retrieve from segmented path array
+	uint32_t			windingBound;	//sum of the winding bounds of the finished subpathes
 	bool				simpleConvex;	//true if path is single rect or concave closed curve.
+	_convexity_t		convexity;		//convexity detection of the current subpath
+	_sdf_shape_t		sdfShape;		//circle, ellipse or rounded rectangle path drawn with sdf
+	tess_arena_t		tessArena;		//scratch memory of the monotone tessellator, reused between fills
+	tess_arena_t		outlineArena;	//stroke outlines of the antialiasing fringe, merged in tessArena
+
+	//high-water marks of caches usage since last trim check, used to shrink caches after spikes
+	uint32_t			flushCount;		//flush count since last trim check
+	uint32_t			hwmVertices;
+	uint32_t			hwmIndices;
+	uint32_t			hwmPoints;
+	uint32_t			hwmPathes;
+	uint32_t			trimVBO;		//vk buffer sizes to shrink to once the gpu is done with them, 0 if none
+	uint32_t			trimIBO;
 
 	float				lineWidth;
 	float				miterLimit;
@@ -204,6 +332,9 @@ typedef struct _vkvg_context_t {
 	vkvg_line_cap_t		lineCap;
 	vkvg_line_join_t	lineJoin;
 	vkvg_fill_rule_t	curFillRule;
+	vkvg_antialias_t	antialias;			//edges smoothing method, fringe coverage is added to fills and strokes
+	float				tolerance;			//maximum distance in device units between curves and their flattening
+	vkvg_stroke_mode_t	strokeMode;			//strokes tessellated on the cpu or expanded on the gpu
 
 	long				selectedCharSize; /* Font size*/
 	char				selectedFontName[FONT_NAME_MAX_SIZE];
@@ -216,20 +347,14 @@ typedef struct _vkvg_context_t {
 	VkvgPattern			pattern;
 
 	vkvg_context_save_t* pSavedCtxs;		//last ctx saved ptr
-	uint8_t				curSavBit;			//current stencil bit used to save context, 6 bits used by stencil for save/restore
-	VkhImage*			savedStencils;		//additional image for saving contexes once more than 6 save/restore are reached
+	uint8_t				curSavBit;			//current stencil bit used to save context, STENCIL_SAVE_COUNT bits used by stencil for save/restore
+	VkhImage*			savedStencils;		//additional image for saving contexes once more than STENCIL_SAVE_COUNT save/restore are reached
 	vkvg_clip_state_t	curClipState;		//current clipping status relative to the previous saved one or clear state if none.
 
 	VkClearRect			clearRect;
 	VkRenderPassBeginInfo renderPassBeginInfo;
 } vkvg_context;
 
-typedef struct _ear_clip_point {
-	vec2					pos;
-	VKVG_IBO_INDEX_TYPE		idx;
-	struct _ear_clip_point*	next;
-} ear_clip_point;
-
 typedef struct {
 	bool		dashOn;
 	uint32_t	curDash;		//current dash index
@@ -258,6 +383,9 @@ void _ensure_index_cache_size	(VkvgContext ctx, uint32_t addedIndicesCount);
 void _resize_index_cache		(VkvgContext ctx, uint32_t newSize);
 
 bool _check_pathes_array		(VkvgContext ctx);
+bool _ensure_pathes_array		(VkvgContext ctx, uint32_t count);
+void _trim_caches				(VkvgContext ctx, bool force);
+void _trim_vk_buffers			(VkvgContext ctx);
 
 bool _current_path_is_empty		(VkvgContext ctx);
 void _finish_path				(VkvgContext ctx);
@@ -273,34 +401,68 @@ float _get_arc_step				(VkvgContext ctx, float radius);
 
 vec2 _get_current_position		(VkvgContext ctx);
 void _add_point					(VkvgContext ctx, float x, float y);
+void _add_arc_points			(VkvgContext ctx, vec2 c, float rx, float ry, const mat2* m, double a, double step, uint32_t count);
+bool _ensure_point_array		(VkvgContext ctx, uint32_t count);
+bool _path_is_convex			(VkvgContext ctx);
+uint32_t _path_winding_bound	(VkvgContext ctx);
 
 void _resetMinMax				(VkvgContext ctx);
 void _vkvg_path_extents			(VkvgContext ctx, bool transformed, float *x1, float *y1, float *x2, float *y2);
 void _draw_stoke_cap			(VkvgContext ctx, stroke_context_t* str, vec2 p0, vec2 n, bool isStart);
 void _draw_segment				(VkvgContext ctx, stroke_context_t* str, dash_context_t* dc, bool isCurve);
+void _draw_polyline				(VkvgContext ctx, stroke_context_t* str, uint32_t lastIdx);
 float _draw_dashed_segment		(VkvgContext ctx, stroke_context_t *str, dash_context_t* dc, bool isCurve);
 bool _build_vb_step				(VkvgContext ctx, stroke_context_t *str, bool isCurve);
 
 void _poly_fill					(VkvgContext ctx, vec4 *bounds);
+bool _fill_non_zero_with_stencil(VkvgContext ctx);
+void _resolve_non_zero_stencil	(VkvgContext ctx, vec4 *bounds);
+bool _fill_convex				(VkvgContext ctx);
+bool _fill_monotone				(VkvgContext ctx);
+bool _fill_monotone_cached		(VkvgContext ctx);
 void _fill_non_zero				(VkvgContext ctx);
 void _draw_full_screen_quad		(VkvgContext ctx, vec4 *scissor);
 
 void _create_gradient_buff		(VkvgContext ctx);
-void _create_vertices_buff		(VkvgContext ctx);
+void _ensure_vertices_buff		(VkvgContext ctx);
+void _resize_vbo				(VkvgContext ctx, uint32_t new_size);
+void _resize_ibo				(VkvgContext ctx, size_t new_size);
 void _add_vertex				(VkvgContext ctx, Vertex v);
 void _add_vertexf				(VkvgContext ctx, float x, float y);
 void _set_vertex				(VkvgContext ctx, uint32_t idx, Vertex v);
+void _add_glyph_instance		(VkvgContext ctx, GlyphInstance g);
 void _add_triangle_indices		(VkvgContext ctx, VKVG_IBO_INDEX_TYPE i0, VKVG_IBO_INDEX_TYPE i1, VKVG_IBO_INDEX_TYPE i2);
 void _add_tri_indices_for_rect	(VkvgContext ctx, VKVG_IBO_INDEX_TYPE i);
 
 void _vao_add_rectangle			(VkvgContext ctx, float x, float y, float width, float height);
+void _add_instance				(VkvgContext ctx, vkvg_instance_type_t type, const void* instance, uint32_t size);
+void _add_rect_instance			(VkvgContext ctx, float x, float y, float width, float height);
+bool _path_is_axis_aligned_rect	(VkvgContext ctx);
+void _set_sdf_shape				(VkvgContext ctx, uint32_t startPointCount, float cx, float cy, float halfWidth, float halfHeight, float radius);
+bool _sdf_shape_drawable		(VkvgContext ctx);
+void _add_sdf_instance			(VkvgContext ctx, float strokeHalfWidth);
+bool _gpu_stroke_drawable		(VkvgContext ctx);
+float _hairline_width			(VkvgContext ctx);
+uint32_t _scale_color_coverage	(uint32_t color, float coverage);
+void _add_line_records			(VkvgContext ctx, float halfWidth, uint32_t color, vkvg_line_join_t join);
+float _aa_fringe_width			(VkvgContext ctx);
+void _add_aa_fringe				(VkvgContext ctx, const vec2* pts, uint32_t count, float side, float width);
+void _fill_aa_fringe			(VkvgContext ctx);
+void _stroke_aa_fringe			(VkvgContext ctx);
 
 void _bind_draw_pipeline		(VkvgContext ctx);
+void _bind_text_pipeline		(VkvgContext ctx);
+void _bind_rect_pipeline		(VkvgContext ctx);
+void _bind_sdf_pipeline			(VkvgContext ctx);
+void _bind_line_pipeline		(VkvgContext ctx);
 void _create_cmd_buff			(VkvgContext ctx);
 void _check_vao_size			(VkvgContext ctx);
 void _flush_cmd_buff			(VkvgContext ctx);
 void _ensure_renderpass_is_started		(VkvgContext ctx);
 void _emit_draw_cmd_undrawn_vertices	(VkvgContext ctx);
+uint32_t _emit_index_run				(VkvgContext ctx);
+void _emit_draw_cmd_undrawn_glyphs	(VkvgContext ctx);
+void _emit_draw_cmd_undrawn_instances	(VkvgContext ctx);
 void _flush_cmd_until_vx_base	(VkvgContext ctx);
 bool _wait_flush_fence			(VkvgContext ctx);
 bool _wait_and_submit_cmd		(VkvgContext ctx);
@@ -309,23 +471,19 @@ void _update_cur_pattern		(VkvgContext ctx, VkvgPattern pat);
 void _set_mat_inv_and_vkCmdPush (VkvgContext ctx);
 void _start_cmd_for_render_pass (VkvgContext ctx);
 
-void _createDescriptorPool		(VkvgContext ctx);
-void _init_descriptor_sets		(VkvgContext ctx);
+void _ensure_cmd_ressources		(VkvgContext ctx);
+void _ensure_descriptor_sets	(VkvgContext ctx);
+void _ensure_gradient_buff		(VkvgContext ctx);
 void _update_descriptor_set		(VkvgContext ctx, VkhImage img, VkDescriptorSet ds);
 void _update_gradient_desc_set	(VkvgContext ctx);
 void _free_ctx_save				(vkvg_context_save_t* sav);
 void _release_context_ressources(VkvgContext ctx);
+void _release_context			(VkvgContext ctx);
 
 static inline float vec2_zcross (vec2 v1, vec2 v2){
 	return v1.x*v2.y-v1.y*v2.x;
 }
-static inline float ecp_zcross (ear_clip_point* p0, ear_clip_point* p1, ear_clip_point* p2){
-	return vec2_zcross (vec2_sub (p1->pos, p0->pos), vec2_sub (p2->pos, p0->pos));
-}
-void _recursive_bezier(VkvgContext ctx, float distanceTolerance,
-					   float x1, float y1, float x2, float y2,
-					   float x3, float y3, float x4, float y4,
-					   unsigned level);
+void _flatten_cubic (VkvgContext ctx, vec2 p0, vec2 p1, vec2 p2, vec2 p3);
 void _bezier (VkvgContext ctx,
 			  float x1, float y1, float x2, float y2,
 			  float x3, float y3, float x4, float y4);
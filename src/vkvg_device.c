@@ -23,6 +23,7 @@
 #include "vkvg_device_internal.h"
 #include "vkvg_surface_internal.h"
 #include "vkvg_context_internal.h"
+#include "vkvg_pattern.h"
 #include "vkh_queue.h"
 #include "vkh_phyinfo.h"
 #include "vk_mem_alloc.h"
@@ -91,6 +92,24 @@ void _device_init (VkvgDevice dev, VkInstance inst, VkPhysicalDevice phy, VkDevi
 	_device_setupPipelines				(dev);
 
 	_device_create_empty_texture		(dev, format, dev->supportedTiling);
+	vkvg_buffer_create (dev, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU,
+						sizeof(vkvg_gradient_t), &dev->emptyGrad);
+	memset (dev->emptyGrad.allocInfo.pMappedData, 0, sizeof(vkvg_gradient_t));
+	vkvg_buffer_flush (&dev->emptyGrad);
+	const float defaultUV[3] = {0,0,-1};//negative z: not a glyph
+	vkvg_buffer_create (dev, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU,
+						sizeof(defaultUV), &dev->defaultUV);
+	memcpy (dev->defaultUV.allocInfo.pMappedData, defaultUV, sizeof(defaultUV));
+	vkvg_buffer_flush (&dev->defaultUV);
+	const vec2 unitQuad[4] = {{0,0},{1,0},{0,1},{1,1}};
+	vkvg_buffer_create (dev, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU,
+						sizeof(unitQuad), &dev->unitQuad);
+	memcpy (dev->unitQuad.allocInfo.pMappedData, unitQuad, sizeof(unitQuad));
+	vkvg_buffer_flush (&dev->unitQuad);
+
+	dev->ctxSizePoints		= VKVG_PTS_SIZE;
+	dev->ctxSizeVertices	= VKVG_VBO_SIZE;
+	dev->ctxSizeIndices		= VKVG_IBO_SIZE;
 
 #ifdef DEBUG
 	#if defined(__linux__) && defined(__GLIBC__)
@@ -111,11 +130,23 @@ void _device_init (VkvgDevice dev, VkInstance inst, VkPhysicalDevice phy, VkDevi
 
 		#ifndef __APPLE__
 			vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_PIPELINE, (uint64_t)dev->pipelinePolyFill, "PL Poly fill");
+			vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_PIPELINE, (uint64_t)dev->pipelinePolyFillNZ, "PL Poly fill non-zero");
+			vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_PIPELINE, (uint64_t)dev->pipelineResolveNZ, "PL Resolve non-zero");
 		#endif
 		vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_PIPELINE, (uint64_t)dev->pipelineClipping, "PL Clipping");
 		vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_PIPELINE, (uint64_t)dev->pipe_OVER, "PL draw Over");
 		vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_PIPELINE, (uint64_t)dev->pipe_SUB, "PL draw Substract");
 		vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_PIPELINE, (uint64_t)dev->pipe_CLEAR, "PL draw Clear");
+		vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_PIPELINE, (uint64_t)dev->pipeText_OVER, "PL text Over");
+		vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_PIPELINE, (uint64_t)dev->pipeText_SUB, "PL text Substract");
+		vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_PIPELINE, (uint64_t)dev->pipeText_CLEAR, "PL text Clear");
+		vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_PIPELINE, (uint64_t)dev->pipeRect_OVER, "PL rect Over");
+		vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_PIPELINE, (uint64_t)dev->pipeRect_SUB, "PL rect Substract");
+		vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_PIPELINE, (uint64_t)dev->pipeRect_CLEAR, "PL rect Clear");
+		vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_PIPELINE, (uint64_t)dev->pipeSdf_OVER, "PL sdf Over");
+		vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_PIPELINE, (uint64_t)dev->pipeSdf_SUB, "PL sdf Substract");
+		vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_PIPELINE, (uint64_t)dev->pipeLine_OVER, "PL line Over");
+		vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_PIPELINE, (uint64_t)dev->pipeLine_SUB, "PL line Substract");
 
 		vkh_image_set_name(dev->emptyImg, "empty IMG");
 		vkh_device_set_object_name((VkhDevice)dev, VK_OBJECT_TYPE_IMAGE_VIEW, (uint64_t)vkh_image_get_view(dev->emptyImg), "empty IMG VIEW");
@@ -354,24 +385,46 @@ void vkvg_device_destroy (VkvgDevice dev)
 	}
 	UNLOCK_DEVICE
 
+	_device_release_deferred (dev, true);
+	free (dev->deferred);
+
 	while (dev->cachedContextCount > 0)
 		_release_context_ressources (dev->cachedContext[--dev->cachedContextCount]);
 
 	LOG(VKVG_LOG_INFO, "DESTROY Device\n");
 
 	vkh_image_destroy				(dev->emptyImg);
+	vkvg_buffer_destroy				(&dev->emptyGrad);
+	vkvg_buffer_destroy				(&dev->defaultUV);
+	vkvg_buffer_destroy				(&dev->unitQuad);
+
+	for (uint32_t i = 0; i < dev->descriptorPoolsCount; i++)
+		vkDestroyDescriptorPool		(dev->vkDev, dev->descriptorPools[i], NULL);
+	free (dev->descriptorPools);
 
 	vkDestroyDescriptorSetLayout	(dev->vkDev, dev->dslGrad,NULL);
 	vkDestroyDescriptorSetLayout	(dev->vkDev, dev->dslFont,NULL);
 	vkDestroyDescriptorSetLayout	(dev->vkDev, dev->dslSrc, NULL);
 #ifndef __APPLE__
 	vkDestroyPipeline				(dev->vkDev, dev->pipelinePolyFill, NULL);
+	vkDestroyPipeline				(dev->vkDev, dev->pipelinePolyFillNZ, NULL);
+	vkDestroyPipeline				(dev->vkDev, dev->pipelineResolveNZ, NULL);
 #endif
 	vkDestroyPipeline				(dev->vkDev, dev->pipelineClipping, NULL);
 
 	vkDestroyPipeline				(dev->vkDev, dev->pipe_OVER,	NULL);
 	vkDestroyPipeline				(dev->vkDev, dev->pipe_SUB,		NULL);
 	vkDestroyPipeline				(dev->vkDev, dev->pipe_CLEAR,	NULL);
+	vkDestroyPipeline				(dev->vkDev, dev->pipeText_OVER,	NULL);
+	vkDestroyPipeline				(dev->vkDev, dev->pipeText_SUB,		NULL);
+	vkDestroyPipeline				(dev->vkDev, dev->pipeText_CLEAR,	NULL);
+	vkDestroyPipeline				(dev->vkDev, dev->pipeRect_OVER,	NULL);
+	vkDestroyPipeline				(dev->vkDev, dev->pipeRect_SUB,		NULL);
+	vkDestroyPipeline				(dev->vkDev, dev->pipeRect_CLEAR,	NULL);
+	vkDestroyPipeline				(dev->vkDev, dev->pipeSdf_OVER,		NULL);
+	vkDestroyPipeline				(dev->vkDev, dev->pipeSdf_SUB,		NULL);
+	vkDestroyPipeline				(dev->vkDev, dev->pipeLine_OVER,	NULL);
+	vkDestroyPipeline				(dev->vkDev, dev->pipeLine_SUB,		NULL);
 
 #ifdef VKVG_WIRED_DEBUG
 	vkDestroyPipeline				(dev->vkDev, dev->pipelineWired, NULL);
@@ -393,11 +446,14 @@ void vkvg_device_destroy (VkvgDevice dev)
 	vkh_queue_destroy(dev->gQueue);
 
 	_font_cache_destroy(dev);
+	_mesh_cache_trim (&dev->meshCache, 0);
 
 	vmaDestroyAllocator (dev->allocator);
 
-	if (dev->threadAware)
+	if (dev->threadAware) {
 		mtx_destroy (&dev->mutex);
+		mtx_destroy (&dev->meshCache.mutex);
+	}
 
 	if (dev->vkhDev) {
 		VkhApp app = vkh_device_get_app (dev->vkhDev);
@@ -430,16 +486,57 @@ void vkvg_device_get_dpy (VkvgDevice dev, int* hdpy, int* vdpy) {
 	*hdpy = dev->hdpi;
 	*vdpy = dev->vdpi;
 }
+void vkvg_device_set_context_cache_sizes (VkvgDevice dev, uint32_t points, uint32_t vertices, uint32_t indices) {
+	//arrays are considered full when less than VKVG_ARRAY_THRESHOLD elements are free.
+	dev->ctxSizePoints		= MAX(points,	4 * VKVG_ARRAY_THRESHOLD);
+	dev->ctxSizeVertices	= MAX(vertices, 4 * VKVG_ARRAY_THRESHOLD);
+	dev->ctxSizeIndices		= MAX(indices,	4 * VKVG_ARRAY_THRESHOLD);
+}
+void vkvg_device_set_deferred_release (VkvgDevice dev, bool deferred) {
+	dev->deferRelease = deferred;
+	if (!deferred)
+		_device_release_deferred (dev, true);
+}
+void vkvg_device_release_deferred (VkvgDevice dev, bool wait) {
+	_device_release_deferred (dev, wait);
+}
+void vkvg_device_get_memory_stats (VkvgDevice dev, vkvg_memory_stats_t* stats) {
+	LOCK_DEVICE
+	memcpy (stats->usage, dev->memUsage, sizeof(dev->memUsage));
+	stats->total = _device_total_memory (dev);
+	stats->peak = dev->memPeak;
+	stats->budget = dev->memBudget;
+	UNLOCK_DEVICE
+}
+void vkvg_device_set_memory_budget (VkvgDevice dev, uint64_t budget) {
+	LOCK_DEVICE
+	dev->memBudget = budget;
+	UNLOCK_DEVICE
+}
+void vkvg_device_set_memory_evict_callback (VkvgDevice dev, vkvg_memory_evict_func_t evict, void* userData) {
+	LOCK_DEVICE
+	dev->memEvict = evict;
+	dev->memEvictData = userData;
+	UNLOCK_DEVICE
+}
+void vkvg_device_set_tessellation_cache_size (VkvgDevice dev, uint64_t size) {
+	LOCK_MESHCACHE(dev)
+	dev->meshCache.maxSize = (size_t)size;
+	_mesh_cache_trim (&dev->meshCache, dev->meshCache.maxSize);
+	UNLOCK_MESHCACHE(dev)
+}
 void vkvg_device_set_thread_aware (VkvgDevice dev, uint32_t thread_aware) {
 	if (thread_aware) {
 		if (dev->threadAware)
 			return;
 		mtx_init (&dev->mutex, mtx_plain);
 		mtx_init (&dev->fontCache->mutex, mtx_plain);
+		mtx_init (&dev->meshCache.mutex, mtx_plain);
 		dev->threadAware = true;
 	} else if (dev->threadAware) {
 		mtx_destroy (&dev->mutex);
 		mtx_destroy (&dev->fontCache->mutex);
+		mtx_destroy (&dev->meshCache.mutex);
 		dev->threadAware = false;
 	}
 }
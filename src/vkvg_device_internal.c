@@ -26,6 +26,8 @@
 
 #include "vkvg_device_internal.h"
 #include "vkvg_context_internal.h"
+#include "vkvg_surface_internal.h"
+#include "vkvg_pattern.h"
 #include "shaders.h"
 
 uint32_t vkvg_log_level = VKVG_LOG_DEBUG;
@@ -233,8 +235,13 @@ void _device_setupPipelines(VkvgDevice dev)
 
 										/*failOp,passOp,depthFailOp,compareOp, compareMask, writeMask, reference;*/
 	VkStencilOpState polyFillOpState ={VK_STENCIL_OP_KEEP,VK_STENCIL_OP_INVERT,	VK_STENCIL_OP_KEEP,VK_COMPARE_OP_EQUAL,STENCIL_CLIP_BIT,STENCIL_FILL_BIT,0};
+	VkStencilOpState polyFillNZFrontOpState ={VK_STENCIL_OP_KEEP,VK_STENCIL_OP_INCREMENT_AND_WRAP,VK_STENCIL_OP_KEEP,VK_COMPARE_OP_EQUAL,STENCIL_CLIP_BIT,STENCIL_FILL_MASK,0};
+	VkStencilOpState polyFillNZBackOpState ={VK_STENCIL_OP_KEEP,VK_STENCIL_OP_DECREMENT_AND_WRAP,VK_STENCIL_OP_KEEP,VK_COMPARE_OP_EQUAL,STENCIL_CLIP_BIT,STENCIL_FILL_MASK,0};
+	//even windings have upper counter bits set only, add the fill bit tested by the cover pass where they are not null.
+	VkStencilOpState resolveNZOpState ={VK_STENCIL_OP_KEEP,VK_STENCIL_OP_REPLACE,	VK_STENCIL_OP_KEEP,VK_COMPARE_OP_NOT_EQUAL,
+										STENCIL_FILL_MASK & ~STENCIL_FILL_BIT,STENCIL_FILL_BIT,STENCIL_FILL_BIT};
 	VkStencilOpState clipingOpState = {VK_STENCIL_OP_ZERO,VK_STENCIL_OP_REPLACE,VK_STENCIL_OP_KEEP,VK_COMPARE_OP_EQUAL,STENCIL_FILL_BIT,STENCIL_ALL_BIT, 0x2};
-	VkStencilOpState stencilOpState = {VK_STENCIL_OP_KEEP,VK_STENCIL_OP_ZERO,	VK_STENCIL_OP_KEEP,VK_COMPARE_OP_EQUAL,STENCIL_FILL_BIT,STENCIL_FILL_BIT,0x1};
+	VkStencilOpState stencilOpState = {VK_STENCIL_OP_KEEP,VK_STENCIL_OP_ZERO,	VK_STENCIL_OP_KEEP,VK_COMPARE_OP_EQUAL,STENCIL_FILL_BIT,STENCIL_FILL_MASK,0x1};
 
 	VkPipelineDepthStencilStateCreateInfo dsStateCreateInfo = { .sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO,
 				.depthTestEnable = VK_FALSE,
@@ -264,30 +271,139 @@ void _device_setupPipelines(VkvgDevice dev)
 		multisampleState.sampleShadingEnable = VK_TRUE;
 		multisampleState.minSampleShading = 0.5f;
 	}*/
-	VkVertexInputBindingDescription vertexInputBinding = { .binding = 0,
-				.stride = sizeof(Vertex),
-				.inputRate = VK_VERTEX_INPUT_RATE_VERTEX };
+	//uv is read from the device default uv buffer with a null stride for vector geometry
+	VkVertexInputBindingDescription vertexInputBindings[2] = {
+		{0, sizeof(Vertex),	VK_VERTEX_INPUT_RATE_VERTEX},
+		{1, 0,				VK_VERTEX_INPUT_RATE_VERTEX}
+	};
 
 	VkVertexInputAttributeDescription vertexInputAttributs[3] = {
 		{0, 0, VK_FORMAT_R32G32_SFLOAT,		0},
 		{1, 0, VK_FORMAT_R8G8B8A8_UNORM,	8},
-		{2, 0, VK_FORMAT_R32G32B32_SFLOAT, 12}
+		{2, 1, VK_FORMAT_R32G32B32_SFLOAT,	0}
 	};
 
 	VkPipelineVertexInputStateCreateInfo vertexInputState = { .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
-		.vertexBindingDescriptionCount	= 1,
-		.pVertexBindingDescriptions		= &vertexInputBinding,
+		.vertexBindingDescriptionCount	= 2,
+		.pVertexBindingDescriptions		= vertexInputBindings,
 		.vertexAttributeDescriptionCount= 3,
 		.pVertexAttributeDescriptions	= vertexInputAttributs };
+
+	//glyph instances are read from the context vbo, the unit quad corners are bound in slot 2
+	VkVertexInputBindingDescription glyphInputBindings[2] = {
+		{0, sizeof(GlyphInstance),	VK_VERTEX_INPUT_RATE_INSTANCE},
+		{2, sizeof(vec2),			VK_VERTEX_INPUT_RATE_VERTEX}
+	};
+
+	VkVertexInputAttributeDescription glyphInputAttributs[6] = {
+		{0, 2, VK_FORMAT_R32G32_SFLOAT,		0},
+		{1, 0, VK_FORMAT_R8G8B8A8_UNORM,	8},
+		{3, 0, VK_FORMAT_R32G32_SFLOAT,		0},
+		{4, 0, VK_FORMAT_R16G16_SINT,		12},
+		{5, 0, VK_FORMAT_R16G16_SINT,		16},
+		{6, 0, VK_FORMAT_R32_SFLOAT,		20}
+	};
+
+	VkPipelineVertexInputStateCreateInfo glyphInputState = { .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+		.vertexBindingDescriptionCount	= 2,
+		.pVertexBindingDescriptions		= glyphInputBindings,
+		.vertexAttributeDescriptionCount= 6,
+		.pVertexAttributeDescriptions	= glyphInputAttributs };
+
+	//rectangle instances are read from the context vbo, the unit quad corners are bound in slot 2
+	VkVertexInputBindingDescription rectInputBindings[3] = {
+		{0, sizeof(RectInstance),	VK_VERTEX_INPUT_RATE_INSTANCE},
+		{1, 0,						VK_VERTEX_INPUT_RATE_VERTEX},
+		{2, sizeof(vec2),			VK_VERTEX_INPUT_RATE_VERTEX}
+	};
+
+	VkVertexInputAttributeDescription rectInputAttributs[5] = {
+		{0, 2, VK_FORMAT_R32G32_SFLOAT,		0},
+		{1, 0, VK_FORMAT_R8G8B8A8_UNORM,	8},
+		{2, 1, VK_FORMAT_R32G32B32_SFLOAT,	0},
+		{3, 0, VK_FORMAT_R32G32_SFLOAT,		0},
+		{4, 0, VK_FORMAT_R32G32_SFLOAT,		12}
+	};
+
+	VkPipelineVertexInputStateCreateInfo rectInputState = { .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+		.vertexBindingDescriptionCount	= 3,
+		.pVertexBindingDescriptions		= rectInputBindings,
+		.vertexAttributeDescriptionCount= 5,
+		.pVertexAttributeDescriptions	= rectInputAttributs };
+
+	//rounded shapes instances are covered by a bounding quad, coverage is computed from their signed distance
+	VkVertexInputBindingDescription sdfInputBindings[2] = {
+		{0, sizeof(SdfInstance),	VK_VERTEX_INPUT_RATE_INSTANCE},
+		{2, sizeof(vec2),			VK_VERTEX_INPUT_RATE_VERTEX}
+	};
+
+	VkVertexInputAttributeDescription sdfInputAttributs[5] = {
+		{0, 2, VK_FORMAT_R32G32_SFLOAT,		0},
+		{1, 0, VK_FORMAT_R8G8B8A8_UNORM,	8},
+		{3, 0, VK_FORMAT_R32G32_SFLOAT,		0},
+		{4, 0, VK_FORMAT_R32G32_SFLOAT,		12},
+		{5, 0, VK_FORMAT_R32G32B32_SFLOAT,	20}
+	};
+
+	VkPipelineVertexInputStateCreateInfo sdfInputState = { .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+		.vertexBindingDescriptionCount	= 2,
+		.pVertexBindingDescriptions		= sdfInputBindings,
+		.vertexAttributeDescriptionCount= 5,
+		.pVertexAttributeDescriptions	= sdfInputAttributs };
+
+	//stroke segments read four consecutive centerline points, the previous and next ones giving the joins directions
+	VkVertexInputBindingDescription lineInputBindings[2] = {
+		{0, sizeof(LineRecord),		VK_VERTEX_INPUT_RATE_INSTANCE},
+		{2, sizeof(vec2),			VK_VERTEX_INPUT_RATE_VERTEX}
+	};
+
+	VkVertexInputAttributeDescription lineInputAttributs[9] = {
+		{0, 2, VK_FORMAT_R32G32_SFLOAT,		0},
+		{1, 0, VK_FORMAT_R8G8B8A8_UNORM,	sizeof(LineRecord) + 8},
+		{3, 0, VK_FORMAT_R32G32_SFLOAT,		0},
+		{4, 0, VK_FORMAT_R32G32_SFLOAT,		sizeof(LineRecord)},
+		{5, 0, VK_FORMAT_R32G32_SFLOAT,		sizeof(LineRecord) * 2},
+		{6, 0, VK_FORMAT_R32G32_SFLOAT,		sizeof(LineRecord) * 3},
+		{7, 0, VK_FORMAT_R32G32_SFLOAT,		sizeof(LineRecord) + 12},
+		{8, 0, VK_FORMAT_R32_UINT,			sizeof(LineRecord) + 20},
+		{9, 0, VK_FORMAT_R32_UINT,			sizeof(LineRecord) * 2 + 20}
+	};
+
+	VkPipelineVertexInputStateCreateInfo lineInputState = { .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+		.vertexBindingDescriptionCount	= 2,
+		.pVertexBindingDescriptions		= lineInputBindings,
+		.vertexAttributeDescriptionCount= 9,
+		.pVertexAttributeDescriptions	= lineInputAttributs };
+
+	VkPipelineInputAssemblyStateCreateInfo instInputAssemblyState = { .sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
+				.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP };
 #ifdef VKVG_WIRED_DEBUG
-	VkShaderModule modVert, modFrag, modFragWired;
+	VkShaderModule modVert, modVertRect, modVertGlyph, modVertSdf, modVertLine, modFrag, modFragSdf, modFragLine, modFragWired;
 #else
-	VkShaderModule modVert, modFrag;
+	VkShaderModule modVert, modVertRect, modVertGlyph, modVertSdf, modVertLine, modFrag, modFragSdf, modFragLine;
 #endif
 	VkShaderModuleCreateInfo createInfo = { .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
 											.pCode = (uint32_t*)vkvg_main_vert_spv,
 											.codeSize = vkvg_main_vert_spv_len };
 	VK_CHECK_RESULT(vkCreateShaderModule(dev->vkDev, &createInfo, NULL, &modVert));
+	createInfo.pCode = (uint32_t*)vkvg_rect_vert_spv;
+	createInfo.codeSize = vkvg_rect_vert_spv_len;
+	VK_CHECK_RESULT(vkCreateShaderModule(dev->vkDev, &createInfo, NULL, &modVertRect));
+	createInfo.pCode = (uint32_t*)vkvg_glyph_vert_spv;
+	createInfo.codeSize = vkvg_glyph_vert_spv_len;
+	VK_CHECK_RESULT(vkCreateShaderModule(dev->vkDev, &createInfo, NULL, &modVertGlyph));
+	createInfo.pCode = (uint32_t*)vkvg_sdf_vert_spv;
+	createInfo.codeSize = vkvg_sdf_vert_spv_len;
+	VK_CHECK_RESULT(vkCreateShaderModule(dev->vkDev, &createInfo, NULL, &modVertSdf));
+	createInfo.pCode = (uint32_t*)vkvg_sdf_frag_spv;
+	createInfo.codeSize = vkvg_sdf_frag_spv_len;
+	VK_CHECK_RESULT(vkCreateShaderModule(dev->vkDev, &createInfo, NULL, &modFragSdf));
+	createInfo.pCode = (uint32_t*)vkvg_line_vert_spv;
+	createInfo.codeSize = vkvg_line_vert_spv_len;
+	VK_CHECK_RESULT(vkCreateShaderModule(dev->vkDev, &createInfo, NULL, &modVertLine));
+	createInfo.pCode = (uint32_t*)vkvg_line_frag_spv;
+	createInfo.codeSize = vkvg_line_frag_spv_len;
+	VK_CHECK_RESULT(vkCreateShaderModule(dev->vkDev, &createInfo, NULL, &modFragLine));
 #if defined(VKVG_LCD_FONT_FILTER) && defined(FT_CONFIG_OPTION_SUBPIXEL_RENDERING)
 	createInfo.pCode = (uint32_t*)vkvg_main_lcd_frag_spv;
 	createInfo.codeSize = vkvg_main_lcd_frag_spv_len;
@@ -321,6 +437,16 @@ void _device_setupPipelines(VkvgDevice dev)
 		.pData = &specializationData};*/
 
 	VkPipelineShaderStageCreateInfo shaderStages[] = {vertStage,fragStage};
+	VkPipelineShaderStageCreateInfo rectShaderStages[] = {vertStage,fragStage};
+	rectShaderStages[0].module = modVertRect;
+	VkPipelineShaderStageCreateInfo glyphShaderStages[] = {vertStage,fragStage};
+	glyphShaderStages[0].module = modVertGlyph;
+	VkPipelineShaderStageCreateInfo sdfShaderStages[] = {vertStage,fragStage};
+	sdfShaderStages[0].module = modVertSdf;
+	sdfShaderStages[1].module = modFragSdf;
+	VkPipelineShaderStageCreateInfo lineShaderStages[] = {vertStage,fragStage};
+	lineShaderStages[0].module = modVertLine;
+	lineShaderStages[1].module = modFragLine;
 
 	pipelineCreateInfo.stageCount = 1;
 	pipelineCreateInfo.pStages = shaderStages;
@@ -336,6 +462,11 @@ void _device_setupPipelines(VkvgDevice dev)
 
 #ifndef __APPLE__
 	VK_CHECK_RESULT(vkCreateGraphicsPipelines(dev->vkDev, dev->pipelineCache, 1, &pipelineCreateInfo, NULL, &dev->pipelinePolyFill));
+	dsStateCreateInfo.front = polyFillNZFrontOpState;
+	dsStateCreateInfo.back = polyFillNZBackOpState;
+	VK_CHECK_RESULT(vkCreateGraphicsPipelines(dev->vkDev, dev->pipelineCache, 1, &pipelineCreateInfo, NULL, &dev->pipelinePolyFillNZ));
+	dsStateCreateInfo.back = dsStateCreateInfo.front = resolveNZOpState;
+	VK_CHECK_RESULT(vkCreateGraphicsPipelines(dev->vkDev, dev->pipelineCache, 1, &pipelineCreateInfo, NULL, &dev->pipelineResolveNZ));
 #endif
 
 	inputAssemblyState.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
@@ -348,14 +479,56 @@ void _device_setupPipelines(VkvgDevice dev)
 	dynamicState.dynamicStateCount = 3;
 	pipelineCreateInfo.stageCount = 2;
 	VK_CHECK_RESULT(vkCreateGraphicsPipelines(dev->vkDev, dev->pipelineCache, 1, &pipelineCreateInfo, NULL, &dev->pipe_OVER));
+	pipelineCreateInfo.pVertexInputState = &glyphInputState;
+	pipelineCreateInfo.pInputAssemblyState = &instInputAssemblyState;
+	pipelineCreateInfo.pStages = glyphShaderStages;
+	VK_CHECK_RESULT(vkCreateGraphicsPipelines(dev->vkDev, dev->pipelineCache, 1, &pipelineCreateInfo, NULL, &dev->pipeText_OVER));
+	pipelineCreateInfo.pVertexInputState = &rectInputState;
+	pipelineCreateInfo.pStages = rectShaderStages;
+	VK_CHECK_RESULT(vkCreateGraphicsPipelines(dev->vkDev, dev->pipelineCache, 1, &pipelineCreateInfo, NULL, &dev->pipeRect_OVER));
+	pipelineCreateInfo.pVertexInputState = &sdfInputState;
+	pipelineCreateInfo.pStages = sdfShaderStages;
+	VK_CHECK_RESULT(vkCreateGraphicsPipelines(dev->vkDev, dev->pipelineCache, 1, &pipelineCreateInfo, NULL, &dev->pipeSdf_OVER));
+	pipelineCreateInfo.pVertexInputState = &lineInputState;
+	pipelineCreateInfo.pStages = lineShaderStages;
+	VK_CHECK_RESULT(vkCreateGraphicsPipelines(dev->vkDev, dev->pipelineCache, 1, &pipelineCreateInfo, NULL, &dev->pipeLine_OVER));
+	pipelineCreateInfo.pInputAssemblyState = &inputAssemblyState;
+	pipelineCreateInfo.pStages = shaderStages;
+	pipelineCreateInfo.pVertexInputState = &vertexInputState;
 
 	blendAttachmentState.alphaBlendOp = blendAttachmentState.colorBlendOp = VK_BLEND_OP_SUBTRACT;
 	VK_CHECK_RESULT(vkCreateGraphicsPipelines(dev->vkDev, dev->pipelineCache, 1, &pipelineCreateInfo, NULL, &dev->pipe_SUB));
+	pipelineCreateInfo.pVertexInputState = &glyphInputState;
+	pipelineCreateInfo.pInputAssemblyState = &instInputAssemblyState;
+	pipelineCreateInfo.pStages = glyphShaderStages;
+	VK_CHECK_RESULT(vkCreateGraphicsPipelines(dev->vkDev, dev->pipelineCache, 1, &pipelineCreateInfo, NULL, &dev->pipeText_SUB));
+	pipelineCreateInfo.pVertexInputState = &rectInputState;
+	pipelineCreateInfo.pStages = rectShaderStages;
+	VK_CHECK_RESULT(vkCreateGraphicsPipelines(dev->vkDev, dev->pipelineCache, 1, &pipelineCreateInfo, NULL, &dev->pipeRect_SUB));
+	pipelineCreateInfo.pVertexInputState = &sdfInputState;
+	pipelineCreateInfo.pStages = sdfShaderStages;
+	VK_CHECK_RESULT(vkCreateGraphicsPipelines(dev->vkDev, dev->pipelineCache, 1, &pipelineCreateInfo, NULL, &dev->pipeSdf_SUB));
+	pipelineCreateInfo.pVertexInputState = &lineInputState;
+	pipelineCreateInfo.pStages = lineShaderStages;
+	VK_CHECK_RESULT(vkCreateGraphicsPipelines(dev->vkDev, dev->pipelineCache, 1, &pipelineCreateInfo, NULL, &dev->pipeLine_SUB));
+	pipelineCreateInfo.pInputAssemblyState = &inputAssemblyState;
+	pipelineCreateInfo.pStages = shaderStages;
+	pipelineCreateInfo.pVertexInputState = &vertexInputState;
 
 	colorBlendState.logicOpEnable = VK_TRUE;
 	blendAttachmentState.blendEnable = VK_FALSE;
 	colorBlendState.logicOp = VK_LOGIC_OP_CLEAR;
 	VK_CHECK_RESULT(vkCreateGraphicsPipelines(dev->vkDev, dev->pipelineCache, 1, &pipelineCreateInfo, NULL, &dev->pipe_CLEAR));
+	pipelineCreateInfo.pVertexInputState = &glyphInputState;
+	pipelineCreateInfo.pInputAssemblyState = &instInputAssemblyState;
+	pipelineCreateInfo.pStages = glyphShaderStages;
+	VK_CHECK_RESULT(vkCreateGraphicsPipelines(dev->vkDev, dev->pipelineCache, 1, &pipelineCreateInfo, NULL, &dev->pipeText_CLEAR));
+	pipelineCreateInfo.pVertexInputState = &rectInputState;
+	pipelineCreateInfo.pStages = rectShaderStages;
+	VK_CHECK_RESULT(vkCreateGraphicsPipelines(dev->vkDev, dev->pipelineCache, 1, &pipelineCreateInfo, NULL, &dev->pipeRect_CLEAR));
+	pipelineCreateInfo.pInputAssemblyState = &inputAssemblyState;
+	pipelineCreateInfo.pStages = shaderStages;
+	pipelineCreateInfo.pVertexInputState = &vertexInputState;
 
 
 #ifdef VKVG_WIRED_DEBUG
@@ -381,6 +554,12 @@ void _device_setupPipelines(VkvgDevice dev)
 #endif
 
 	vkDestroyShaderModule(dev->vkDev, modVert, NULL);
+	vkDestroyShaderModule(dev->vkDev, modVertRect, NULL);
+	vkDestroyShaderModule(dev->vkDev, modVertGlyph, NULL);
+	vkDestroyShaderModule(dev->vkDev, modVertSdf, NULL);
+	vkDestroyShaderModule(dev->vkDev, modFragSdf, NULL);
+	vkDestroyShaderModule(dev->vkDev, modVertLine, NULL);
+	vkDestroyShaderModule(dev->vkDev, modFragLine, NULL);
 	vkDestroyShaderModule(dev->vkDev, modFrag, NULL);
 }
 
@@ -398,12 +577,13 @@ void _device_createDescriptorSetLayout (VkvgDevice dev) {
 
 	VkPushConstantRange pushConstantRange[] = {
 		{VK_SHADER_STAGE_VERTEX_BIT,0,sizeof(push_constants)},
+		{VK_SHADER_STAGE_VERTEX_BIT|VK_SHADER_STAGE_FRAGMENT_BIT,sizeof(push_constants),sizeof(line_push_constants)}
 		//{VK_SHADER_STAGE_FRAGMENT_BIT,0,sizeof(push_constants)}
 	};
 	VkDescriptorSetLayout dsls[] = {dev->dslFont,dev->dslSrc,dev->dslGrad};
 
 	VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = { .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
-															.pushConstantRangeCount = 1,
+															.pushConstantRangeCount = 2,
 															.pPushConstantRanges = (VkPushConstantRange*)&pushConstantRange,
 															.setLayoutCount = 3,
 															.pSetLayouts = dsls };
@@ -462,6 +642,202 @@ void _device_store_context (VkvgContext ctx) {
 
 	UNLOCK_DEVICE
 }
+void _device_push_deferred (VkvgDevice dev, _deferred_release_t* dr) {
+	LOCK_DEVICE
+
+	if (dev->deferredCount == dev->deferredReserve) {
+		dev->deferredReserve += VKVG_MAX_CACHED_CONTEXT_COUNT;
+		dev->deferred = (_deferred_release_t*)realloc (dev->deferred, dev->deferredReserve * sizeof(_deferred_release_t));
+	}
+	dev->deferred[dev->deferredCount++] = *dr;
+
+	UNLOCK_DEVICE
+}
+//context is released once its last submission is completed. Source surfaces replaced before were waited for,
+//so only the current target and source may still be in use.
+void _device_defer_context (VkvgContext ctx) {
+	_deferred_release_t dr = {ctx->flushFence, ctx, NULL, NULL, {ctx->pSurf, NULL}};
+	if (ctx->pattern && ctx->pattern->type == VKVG_PATTERN_TYPE_SURFACE)
+		dr.ctxSurfs[1] = (VkvgSurface)ctx->pattern->data;
+	_device_push_deferred (ctx->dev, &dr);
+}
+//true if one of the first 'count' deferred objects is a context using surf, device has to be locked.
+static bool _device_deferred_ctx_use (VkvgDevice dev, uint32_t count, VkvgSurface surf) {
+	for (uint32_t i = 0; i < count; i++) {
+		_deferred_release_t* dr = &dev->deferred[i];
+		if (dr->ctx && (dr->ctxSurfs[0] == surf || dr->ctxSurfs[1] == surf))
+			return true;
+	}
+	return false;
+}
+//surface may still be in use by deferred contexts, if any, it is released after them.
+//return false if none of them uses it and surface may be destroyed immediately.
+bool _device_defer_surface (VkvgSurface surf) {
+	VkvgDevice dev = surf->dev;
+
+	LOCK_DEVICE
+	bool pending = _device_deferred_ctx_use (dev, dev->deferredCount, surf);
+	UNLOCK_DEVICE
+
+	if (!pending)
+		return false;
+
+	_deferred_release_t dr = {VK_NULL_HANDLE, NULL, surf, NULL, {NULL, NULL}};
+	_device_push_deferred (dev, &dr);
+	return true;
+}
+void _device_defer_image (VkvgDevice dev, VkhImage img, VkFence fence) {
+	_deferred_release_t dr = {fence, NULL, NULL, img, {NULL, NULL}};
+	_device_push_deferred (dev, &dr);
+}
+//release deferred objects whose gpu work is completed, if wait is true, device is idled first and all are released.
+//objects are released outside of the device lock for their destruction may defer new ones.
+void _device_release_deferred (VkvgDevice dev, bool wait) {
+	if (wait)
+		_device_wait_idle (dev);
+
+	while (true) {
+		_deferred_release_t dr;
+		bool found = false;
+
+		LOCK_DEVICE
+		for (uint32_t i = 0; i < dev->deferredCount; i++) {
+			_deferred_release_t* cur = &dev->deferred[i];
+			if (wait)
+				found = true;
+			else if (cur->fence)
+				found = vkGetFenceStatus (dev->vkDev, cur->fence) == VK_SUCCESS;
+			else
+				found = !_device_deferred_ctx_use (dev, i, cur->surf);
+			if (found) {
+				dr = *cur;
+				dev->deferredCount--;
+				memmove (cur, cur + 1, (dev->deferredCount - i) * sizeof(_deferred_release_t));
+				break;
+			}
+		}
+		UNLOCK_DEVICE
+
+		if (!found)
+			return;
+
+		if (dr.ctx)
+			_release_context (dr.ctx);
+		else if (dr.surf)
+			_surface_free (dr.surf);
+		else
+			vkh_image_destroy (dr.img);
+	}
+}
+//estimated memory footprint of an image, real allocation may be slightly larger due to alignment.
+uint64_t _device_image_size (VkFormat format, VkSampleCountFlags samples, uint32_t width, uint32_t height, uint32_t layers) {
+	uint64_t pixSize;
+	switch (format) {
+	case VK_FORMAT_R8_UNORM:
+	case VK_FORMAT_S8_UINT:
+		pixSize = 1;
+		break;
+	case VK_FORMAT_D32_SFLOAT_S8_UINT:
+		pixSize = 8;
+		break;
+	default:
+		pixSize = 4;
+		break;
+	}
+	return pixSize * (uint64_t)samples * width * height * layers;
+}
+uint64_t _device_total_memory (VkvgDevice dev) {
+	uint64_t total = 0;
+	for (int i = 0; i < VKVG_MEMORY_CATEGORY_COUNT; i++)
+		total += dev->memUsage[i];
+	return total;
+}
+//account for a new allocation, eviction callback is triggered if budget would be exceeded.
+//return false if budget is still exceeded, the size is accounted anyway.
+bool _device_reserve_memory (VkvgDevice dev, vkvg_memory_category_t category, uint64_t size) {
+	LOCK_DEVICE
+
+	if (dev->memBudget && dev->deferredCount && _device_total_memory (dev) + size > dev->memBudget) {
+		//objects whose gpu work is done are still accounted until released
+		UNLOCK_DEVICE
+		_device_release_deferred (dev, false);
+		LOCK_DEVICE
+	}
+	if (dev->memBudget && dev->memEvict && _device_total_memory (dev) + size > dev->memBudget) {
+		vkvg_memory_evict_func_t evict = dev->memEvict;
+		void* evictData = dev->memEvictData;
+		UNLOCK_DEVICE
+		LOG(VKVG_LOG_INFO, "memory budget exceeded, evicting: category=%d size=%llu\n", category, (unsigned long long)size);
+		evict (evictData, dev, category, size);
+		LOCK_DEVICE
+	}
+
+	uint64_t total = _device_total_memory (dev) + size;
+	bool inBudget = dev->memBudget == 0 || total <= dev->memBudget;
+	dev->memUsage[category] += size;
+	if (total > dev->memPeak)
+		dev->memPeak = total;
+
+	UNLOCK_DEVICE
+
+	if (!inBudget)
+		LOG(VKVG_LOG_ERR, "memory budget exceeded: category=%d size=%llu total=%llu\n", category, (unsigned long long)size, (unsigned long long)total);
+	return inBudget;
+}
+void _device_release_memory (VkvgDevice dev, vkvg_memory_category_t category, uint64_t size) {
+	LOCK_DEVICE
+
+	if (dev->memUsage[category] < size)
+		dev->memUsage[category] = 0;
+	else
+		dev->memUsage[category] -= size;
+
+	UNLOCK_DEVICE
+}
+VkDescriptorPool _device_create_descriptor_pool (VkvgDevice dev) {
+	VkDescriptorPool pool;
+	const VkDescriptorPoolSize descriptorPoolSize[] = {
+		{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 2 * VKVG_DESCRIPTOR_POOL_CTX_COUNT },
+		{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VKVG_DESCRIPTOR_POOL_CTX_COUNT }
+	};
+	VkDescriptorPoolCreateInfo descriptorPoolCreateInfo = { .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+															.maxSets = 3 * VKVG_DESCRIPTOR_POOL_CTX_COUNT,
+															.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT,
+															.poolSizeCount = 2,
+															.pPoolSizes = descriptorPoolSize };
+	VK_CHECK_RESULT(vkCreateDescriptorPool (dev->vkDev, &descriptorPoolCreateInfo, NULL, &pool));
+	return pool;
+}
+//allocate font, source and gradient descriptor sets of a context from the shared pools.
+void _device_alloc_context_descriptor_sets (VkvgDevice dev, VkDescriptorPool* pPool, VkDescriptorSet* dss) {
+	VkDescriptorSetLayout dsls[] = {dev->dslFont, dev->dslSrc, dev->dslGrad};
+	VkDescriptorSetAllocateInfo descriptorSetAllocateInfo = { .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+															  .descriptorSetCount = 3,
+															  .pSetLayouts = dsls
+															};
+	LOCK_DEVICE
+
+	for (int32_t i = (int32_t)dev->descriptorPoolsCount - 1; i >= 0; i--) {
+		descriptorSetAllocateInfo.descriptorPool = dev->descriptorPools[i];
+		if (vkAllocateDescriptorSets (dev->vkDev, &descriptorSetAllocateInfo, dss) == VK_SUCCESS) {
+			*pPool = dev->descriptorPools[i];
+			UNLOCK_DEVICE
+			return;
+		}
+	}
+	//all pools are full
+	dev->descriptorPools = (VkDescriptorPool*)realloc (dev->descriptorPools, (dev->descriptorPoolsCount + 1) * sizeof(VkDescriptorPool));
+	dev->descriptorPools[dev->descriptorPoolsCount] = _device_create_descriptor_pool (dev);
+	*pPool = descriptorSetAllocateInfo.descriptorPool = dev->descriptorPools[dev->descriptorPoolsCount++];
+	VK_CHECK_RESULT(vkAllocateDescriptorSets (dev->vkDev, &descriptorSetAllocateInfo, dss));
+
+	UNLOCK_DEVICE
+}
+void _device_free_context_descriptor_sets (VkvgDevice dev, VkDescriptorPool pool, VkDescriptorSet* dss) {
+	LOCK_DEVICE
+	vkFreeDescriptorSets (dev->vkDev, pool, 3, dss);
+	UNLOCK_DEVICE
+}
 void _device_submit_cmd (VkvgDevice dev, VkCommandBuffer* cmd, VkFence fence) {
 	LOCK_DEVICE
 	if (dev->gQLastFence != VK_NULL_HANDLE)
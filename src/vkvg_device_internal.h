@@ -25,12 +25,17 @@
 #include "vkvg_internal.h"
 #include "vkvg.h"
 #include "vkvg_fonts.h"
+#include "vkvg_mesh_cache.h"
 
 #define STENCIL_FILL_BIT	0x1
-#define STENCIL_CLIP_BIT	0x2
-#define STENCIL_ALL_BIT		0x3
+#define STENCIL_FILL_MASK	0x7		//non-zero winding counter wrapping at 8, even-odd fills only toggle the first bit
+#define STENCIL_CLIP_BIT	0x8
+#define STENCIL_ALL_BIT		0xF
+#define STENCIL_SAVE_SHIFT	4		//first stencil bit used for save/restore of clipping
+#define STENCIL_SAVE_COUNT	4		//save/restore bits count, additional images are used above
 
 #define VKVG_MAX_CACHED_CONTEXT_COUNT 2
+#define VKVG_DESCRIPTOR_POOL_CTX_COUNT 16	//contexts descriptor sets count per shared pool
 
 extern PFN_vkCmdBindPipeline			CmdBindPipeline;
 extern PFN_vkCmdBindDescriptorSets		CmdBindDescriptorSets;
@@ -53,6 +58,15 @@ extern PFN_vkWaitForFences				WaitForFences;
 extern PFN_vkResetFences				ResetFences;
 extern PFN_vkResetCommandBuffer			ResetCommandBuffer;
 
+//object whose destruction is postponed until the gpu has finished with it.
+typedef struct {
+	VkFence					fence;					//fence of the last use, null for surfaces released once the deferred contexts using them are.
+	VkvgContext				ctx;					//context to store in cache or release
+	VkvgSurface				surf;					//surface without references left
+	VkhImage				img;					//image reference to drop
+	VkvgSurface				ctxSurfs[2];			//target and source surfaces the last submission of ctx may access
+}_deferred_release_t;
+
 typedef struct _vkvg_device_t{
 	VkDevice				vkDev;					/**< Vulkan Logical Device */
 	VkPhysicalDeviceMemoryProperties phyMemProps;	/**< Vulkan Physical device memory properties */
@@ -82,8 +96,20 @@ typedef struct _vkvg_device_t{
 	VkPipeline				pipe_OVER;				/**< default operator */
 	VkPipeline				pipe_SUB;
 	VkPipeline				pipe_CLEAR;				/**< clear operator */
+	VkPipeline				pipeText_OVER;			/**< instanced glyphs variants of draw pipelines */
+	VkPipeline				pipeText_SUB;
+	VkPipeline				pipeText_CLEAR;
+	VkPipeline				pipeRect_OVER;			/**< instanced rectangles variants of draw pipelines */
+	VkPipeline				pipeRect_SUB;
+	VkPipeline				pipeRect_CLEAR;
+	VkPipeline				pipeSdf_OVER;			/**< instanced rounded shapes, no clear variant, coverage is computed in the fragment shader */
+	VkPipeline				pipeSdf_SUB;
+	VkPipeline				pipeLine_OVER;			/**< instanced stroke segments expanded from centerline points */
+	VkPipeline				pipeLine_SUB;
 
 	VkPipeline				pipelinePolyFill;		/**< even-odd polygon filling first step */
+	VkPipeline				pipelinePolyFillNZ;		/**< non-zero polygon filling first step, winding is counted in the stencil */
+	VkPipeline				pipelineResolveNZ;		/**< non-zero polygon filling second step, set fill bit where winding is not zero */
 	VkPipeline				pipelineClipping;		/**< draw on stencil to update clipping regions */
 
 	VkPipelineCache			pipelineCache;			/**< speed up startup by caching configured pipelines on disk */
@@ -98,17 +124,39 @@ typedef struct _vkvg_device_t{
 	VkhDevice				vkhDev;					/**< old VkhDev created during vulkan context creation by @ref vkvg_device_create. */
 
 	VkhImage				emptyImg;				/**< prevent unbound descriptor to trigger Validation error 61 */
+	vkvg_buff				emptyGrad;				/**< gradient uniform bound to contexts until they use a gradient */
+	vkvg_buff				defaultUV;				/**< single uv vertex {0,0,-1} read with null stride for vector geometry */
+	vkvg_buff				unitQuad;				/**< unit square strip expanded by rectangle and glyph instances */
 	VkSampleCountFlags		samples;				/**< samples count common to all surfaces */
 	bool					deferredResolve;		/**< if true, resolve only on context destruction and set as source */
 	vkvg_status_t			status;					/**< Current status of device, affected by last operation */
 
 	_font_cache_t*			fontCache;				/**< Store everything relative to common font caching system */
+	_mesh_cache_t			meshCache;				/**< tessellated pathes reused by fills and strokes of all contexts, disabled by default */
 
 	VkvgContext				lastCtx;				/**< last element of double linked list of context, used to trigger font caching system update on all contexts*/
 
 	int32_t					cachedContextCount;
 	VkvgContext				cachedContext[VKVG_MAX_CACHED_CONTEXT_COUNT];
 
+	VkDescriptorPool*		descriptorPools;		/**< shared pools for context descriptor sets, a new one is added when all are full */
+	uint32_t				descriptorPoolsCount;
+
+	uint32_t				ctxSizePoints;			/**< initial point array size of new contexts */
+	uint32_t				ctxSizeVertices;		/**< initial vertex cache and vbo size of new contexts */
+	uint32_t				ctxSizeIndices;			/**< initial index cache and ibo size of new contexts */
+
+	uint64_t				memUsage[VKVG_MEMORY_CATEGORY_COUNT];/**< tracked memory usage in bytes per category */
+	uint64_t				memPeak;				/**< highest total of tracked memory usage */
+	uint64_t				memBudget;				/**< memory budget in bytes, 0 if unlimited */
+	vkvg_memory_evict_func_t memEvict;				/**< application callback triggered before exceeding budget */
+	void*					memEvictData;			/**< user data for the eviction callback */
+
+	bool					deferRelease;			/**< if true, contexts still in use by the gpu are released later instead of waiting */
+	_deferred_release_t*	deferred;				/**< objects waiting for their last use fence to be signaled */
+	uint32_t				deferredCount;
+	uint32_t				deferredReserve;
+
 #ifdef VKVG_WIRED_DEBUG
 	VkPipeline				pipelineWired;
 	VkPipeline				pipelineLineList;
@@ -143,4 +191,16 @@ void _device_destroy_fence				(VkvgDevice dev, VkFence fence);
 void _device_reset_fence				(VkvgDevice dev, VkFence fence);
 bool _device_try_get_cached_context		(VkvgDevice dev, VkvgContext* pCtx);
 void _device_store_context				(VkvgContext ctx);
+void _device_alloc_context_descriptor_sets(VkvgDevice dev, VkDescriptorPool* pPool, VkDescriptorSet* dss);
+void _device_free_context_descriptor_sets(VkvgDevice dev, VkDescriptorPool pool, VkDescriptorSet* dss);
+
+void _device_defer_context				(VkvgContext ctx);
+bool _device_defer_surface				(VkvgSurface surf);
+void _device_defer_image				(VkvgDevice dev, VkhImage img, VkFence fence);
+void _device_release_deferred			(VkvgDevice dev, bool wait);
+
+uint64_t _device_image_size				(VkFormat format, VkSampleCountFlags samples, uint32_t width, uint32_t height, uint32_t layers);
+uint64_t _device_total_memory			(VkvgDevice dev);
+bool _device_reserve_memory				(VkvgDevice dev, vkvg_memory_category_t category, uint64_t size);
+void _device_release_memory				(VkvgDevice dev, vkvg_memory_category_t category, uint64_t size);
 #endif
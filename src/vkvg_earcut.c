@@ -0,0 +1,1173 @@
+/*
+ * Copyright (c) 2018-2022 Jean-Philippe Bruyère <jp_bruyere@hotmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+ * Software, and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//Port of the earcut polygon triangulation (ISC license, github.com/mapbox/earcut). Vertices are kept in circular
+//doubly linked lists whose nodes are allocated in the tessellator arena and addressed by index, so that the arena
+//may grow when polygons are split. For large polygons, vertices are also chained in z-order and ears are only
+//tested against the vertices whose z-order hash falls inside their bounding box.
+
+#include "vkvg_tessellator.h"
+
+#define EC_NONE				UINT32_MAX
+#define EC_HASH_THRESHOLD	80	//points count from which the z-order hash is used
+#define EC_EPSILON			1e-5f	//tolerance on edges parameters for intersections close to their ends
+#define EC_ALIGN(s)			(((s) + 7) & ~(size_t)7)
+
+enum {
+	EC_CONTOUR_NONE,
+	EC_CONTOUR_OUTER,
+	EC_CONTOUR_HOLE
+};
+
+typedef struct {
+	float		x, y;
+	uint32_t	i;				//index of the point in the source array
+	uint32_t	prev, next;		//polygon ring
+	uint32_t	prevZ, nextZ;	//z-order chain
+	uint32_t	z;
+	bool		steiner;
+} _ec_node_t;
+
+typedef struct {
+	uint32_t	first;
+	uint32_t	count;
+	float		area;			//twice the signed area, positive if counter clockwise with y up
+	vec2		min, max;
+	uint32_t	role;			//EC_CONTOUR_xxx
+	uint32_t	firstHole;		//holes of outer contours are chained
+	uint32_t	nextHole;
+	uint32_t	touch;			//point shared with another resolved contour, holes are bridged there
+} _ec_contour_t;
+
+typedef struct {
+	float		x;
+	uint32_t	node;
+} _ec_hole_t;
+
+//edge of the source contours, sorted by ymin for the sweep resolving crossing contours
+typedef struct {
+	uint32_t	a, b;
+	float		ymin, ymax;
+} _ec_edge_t;
+
+typedef struct {
+	uint32_t	edge;
+	float		t;				//position on the edge
+	uint32_t	vertex;			//source point, or intersection if greater or equal to the points count
+	vec2		pos;
+} _ec_split_t;
+
+typedef struct {
+	float		x, y;
+	uint32_t	v;
+} _ec_vertex_t;
+
+//piece of edge between two splits, kept if it bounds the filled area. It is then oriented with this area on its left.
+typedef struct {
+	uint32_t	a, b;
+	int			wl, wr;			//winding on both sides
+	bool		keep, used;
+} _ec_sub_edge_t;
+
+typedef struct {
+	float		x, y;
+	uint32_t	side;			//sub edge index * 2, +1 for the right side
+} _ec_sample_t;
+
+typedef struct {
+	tess_arena_t*	arena;
+	const vec2*		pts;		//source points, or points of the resolved contours
+	uint32_t*		vertices;	//vertex index of the resolved contours points, NULL if contours are source ranges
+	uint32_t		resolvedCount;
+	size_t			contoursOffset;	//arena layout: contours, holes queue, resolved points and vertices, then nodes
+	size_t			ptsOffset;
+	size_t			nodesOffset;
+	uint32_t		pointCount;
+	_ec_contour_t*	contours;
+	uint32_t		contourCount;
+	uint32_t		maxContours;
+	_ec_hole_t*		queue;		//leftmost points of the holes of one outer contour
+	_ec_node_t*		nodes;
+	uint32_t		nodeCount;
+	uint32_t		maxNodes;
+	uint32_t*		indices;
+	uint32_t		indCount;
+	uint32_t		maxIndCount;
+	uint32_t		firstIdx;
+	float			minX, minY;
+	float			invSize;	//z-order hash scale, 0 if hash is not used
+	bool			failed;		//arena could not grow
+} _earcut_t;
+
+#define EC_HEADER_SIZE EC_ALIGN(sizeof(_earcut_t))
+#define NODE(idx) e->nodes[idx]
+
+//reserve arena for maxNodes and update arrays addresses. The earcut state is stored at the start of the arena
+//between begin and end calls.
+static bool _ec_reserve (_earcut_t* e, uint32_t maxNodes) {
+	if (!tess_arena_reserve (e->arena, e->nodesOffset + (size_t)maxNodes * sizeof(_ec_node_t)))
+		return false;
+	char* mem = (char*)e->arena->mem;
+	e->contours	= (_ec_contour_t*)(mem + e->contoursOffset);
+	e->queue	= (_ec_hole_t*)(e->contours + e->maxContours);
+	if (e->ptsOffset) {
+		e->pts		= (const vec2*)(mem + e->ptsOffset);
+		e->vertices	= (uint32_t*)(mem + e->ptsOffset + e->resolvedCount * sizeof(vec2));
+	}
+	e->nodes	= (_ec_node_t*)(mem + e->nodesOffset);
+	e->maxNodes	= maxNodes;
+	return true;
+}
+static uint32_t _ec_new_node (_earcut_t* e, uint32_t i) {
+	if (e->nodeCount == e->maxNodes && !_ec_reserve (e, e->maxNodes * 2)) {
+		e->failed = true;
+		return EC_NONE;
+	}
+	uint32_t p = e->nodeCount++;
+	_ec_node_t n = {e->pts[i].x, e->pts[i].y, i, p, p, EC_NONE, EC_NONE, 0, false};
+	NODE(p) = n;
+	return p;
+}
+//create a node and link it after last if any
+static uint32_t _ec_insert (_earcut_t* e, uint32_t i, uint32_t last) {
+	uint32_t p = _ec_new_node (e, i);
+	if (p == EC_NONE || last == EC_NONE)
+		return p;
+	NODE(p).next = NODE(last).next;
+	NODE(p).prev = last;
+	NODE(NODE(last).next).prev = p;
+	NODE(last).next = p;
+	return p;
+}
+static void _ec_remove (_earcut_t* e, uint32_t p) {
+	NODE(NODE(p).next).prev = NODE(p).prev;
+	NODE(NODE(p).prev).next = NODE(p).next;
+	if (NODE(p).prevZ != EC_NONE)
+		NODE(NODE(p).prevZ).nextZ = NODE(p).nextZ;
+	if (NODE(p).nextZ != EC_NONE)
+		NODE(NODE(p).nextZ).prevZ = NODE(p).prevZ;
+}
+static inline bool _ec_equals (_earcut_t* e, uint32_t a, uint32_t b) {
+	return NODE(a).x == NODE(b).x && NODE(a).y == NODE(b).y;
+}
+static inline float _ec_area (_earcut_t* e, uint32_t p, uint32_t q, uint32_t r) {
+	_ec_node_t *P = &NODE(p), *Q = &NODE(q), *R = &NODE(r);
+	return (Q->y - P->y) * (R->x - Q->x) - (Q->x - P->x) * (R->y - Q->y);
+}
+static inline bool _ec_point_in_triangle (float ax, float ay, float bx, float by, float cx, float cy, float px, float py) {
+	return	(cx - px) * (ay - py) >= (ax - px) * (cy - py) &&
+			(ax - px) * (by - py) >= (bx - px) * (ay - py) &&
+			(bx - px) * (cy - py) >= (cx - px) * (by - py);
+}
+static inline int _ec_sign (float v) {
+	return v > 0 ? 1 : v < 0 ? -1 : 0;
+}
+//q lies on segment pr, knowing the three points are colinear
+static inline bool _ec_on_segment (_earcut_t* e, uint32_t p, uint32_t q, uint32_t r) {
+	_ec_node_t *P = &NODE(p), *Q = &NODE(q), *R = &NODE(r);
+	return	Q->x <= fmaxf (P->x, R->x) && Q->x >= fminf (P->x, R->x) &&
+			Q->y <= fmaxf (P->y, R->y) && Q->y >= fminf (P->y, R->y);
+}
+static bool _ec_intersects (_earcut_t* e, uint32_t p1, uint32_t q1, uint32_t p2, uint32_t q2) {
+	int o1 = _ec_sign (_ec_area (e, p1, q1, p2));
+	int o2 = _ec_sign (_ec_area (e, p1, q1, q2));
+	int o3 = _ec_sign (_ec_area (e, p2, q2, p1));
+	int o4 = _ec_sign (_ec_area (e, p2, q2, q1));
+	if (o1 != o2 && o3 != o4)
+		return true;
+	return	(o1 == 0 && _ec_on_segment (e, p1, p2, q1)) || (o2 == 0 && _ec_on_segment (e, p1, q2, q1)) ||
+			(o3 == 0 && _ec_on_segment (e, p2, p1, q2)) || (o4 == 0 && _ec_on_segment (e, p2, q1, q2));
+}
+//diagonal ab intersects an edge of the polygon
+static bool _ec_intersects_polygon (_earcut_t* e, uint32_t a, uint32_t b) {
+	uint32_t p = a;
+	do {
+		uint32_t n = NODE(p).next;
+		if (NODE(p).i != NODE(a).i && NODE(n).i != NODE(a).i && NODE(p).i != NODE(b).i && NODE(n).i != NODE(b).i &&
+				_ec_intersects (e, p, n, a, b))
+			return true;
+		p = n;
+	} while (p != a);
+	return false;
+}
+//diagonal ab starts inside the polygon at a
+static bool _ec_locally_inside (_earcut_t* e, uint32_t a, uint32_t b) {
+	uint32_t prev = NODE(a).prev, next = NODE(a).next;
+	return _ec_area (e, prev, a, next) < 0 ?
+				_ec_area (e, a, b, next) >= 0 && _ec_area (e, a, prev, b) >= 0 :
+				_ec_area (e, a, b, prev) < 0 || _ec_area (e, a, next, b) < 0;
+}
+//middle of diagonal ab is inside the polygon
+static bool _ec_middle_inside (_earcut_t* e, uint32_t a, uint32_t b) {
+	uint32_t p = a;
+	bool inside = false;
+	float px = (NODE(a).x + NODE(b).x) / 2, py = (NODE(a).y + NODE(b).y) / 2;
+	do {
+		_ec_node_t *P = &NODE(p), *N = &NODE(P->next);
+		if ((P->y > py) != (N->y > py) && N->y != P->y && px < (N->x - P->x) * (py - P->y) / (N->y - P->y) + P->x)
+			inside = !inside;
+		p = P->next;
+	} while (p != a);
+	return inside;
+}
+static bool _ec_is_valid_diagonal (_earcut_t* e, uint32_t a, uint32_t b) {
+	if (NODE(NODE(a).next).i == NODE(b).i || NODE(NODE(a).prev).i == NODE(b).i || _ec_intersects_polygon (e, a, b))
+		return false;
+	if (_ec_locally_inside (e, a, b) && _ec_locally_inside (e, b, a) && _ec_middle_inside (e, a, b) &&
+			(_ec_area (e, NODE(a).prev, a, NODE(b).prev) != 0 || _ec_area (e, a, NODE(b).prev, b) != 0))
+		return true;
+	//zero length bridge between two convex vertices
+	return	_ec_equals (e, a, b) && _ec_area (e, NODE(a).prev, a, NODE(a).next) > 0 &&
+			_ec_area (e, NODE(b).prev, b, NODE(b).next) > 0;
+}
+//link a to b with a new diagonal, duplicating both vertices. a and b end in distinct rings, the second one, starting
+//with the copy of b, is returned.
+static uint32_t _ec_split_polygon (_earcut_t* e, uint32_t a, uint32_t b) {
+	uint32_t a2 = _ec_new_node (e, NODE(a).i);
+	uint32_t b2 = _ec_new_node (e, NODE(b).i);
+	if (b2 == EC_NONE)
+		return EC_NONE;
+	uint32_t an = NODE(a).next, bp = NODE(b).prev;
+	NODE(a).next	= b;
+	NODE(b).prev	= a;
+	NODE(a2).next	= an;
+	NODE(an).prev	= a2;
+	NODE(b2).next	= a2;
+	NODE(a2).prev	= b2;
+	NODE(bp).next	= b2;
+	NODE(b2).prev	= bp;
+	return b2;
+}
+//remove duplicated and colinear points
+static uint32_t _ec_filter_points (_earcut_t* e, uint32_t start, uint32_t end) {
+	if (start == EC_NONE)
+		return start;
+	if (end == EC_NONE)
+		end = start;
+	uint32_t p = start;
+	bool again;
+	do {
+		again = false;
+		if (!NODE(p).steiner && (_ec_equals (e, p, NODE(p).next) || _ec_area (e, NODE(p).prev, p, NODE(p).next) == 0)) {
+			_ec_remove (e, p);
+			p = end = NODE(p).prev;
+			if (p == NODE(p).next)
+				break;
+			again = true;
+		} else
+			p = NODE(p).next;
+	} while (again || p != end);
+	return end;
+}
+//create a ring from a contour with the requested winding
+static uint32_t _ec_linked_list (_earcut_t* e, _ec_contour_t* c, bool clockwise) {
+	uint32_t last = EC_NONE;
+	if (clockwise == (c->area > 0)) {
+		for (uint32_t i = c->first; i < c->first + c->count; i++)
+			last = _ec_insert (e, i, last);
+	} else {
+		for (uint32_t i = c->first + c->count; i-- > c->first; )
+			last = _ec_insert (e, i, last);
+	}
+	if (e->failed)
+		return EC_NONE;
+	if (_ec_equals (e, last, NODE(last).next)) {
+		uint32_t next = NODE(last).next;
+		_ec_remove (e, last);
+		last = next;
+	}
+	return last;
+}
+
+//interleave the bits of the 15 bits integer coordinates
+static uint32_t _ec_z_order (_earcut_t* e, float fx, float fy) {
+	uint32_t x = (uint32_t)((fx - e->minX) * e->invSize);
+	uint32_t y = (uint32_t)((fy - e->minY) * e->invSize);
+	x = (x | (x << 8)) & 0x00FF00FF;
+	x = (x | (x << 4)) & 0x0F0F0F0F;
+	x = (x | (x << 2)) & 0x33333333;
+	x = (x | (x << 1)) & 0x55555555;
+	y = (y | (y << 8)) & 0x00FF00FF;
+	y = (y | (y << 4)) & 0x0F0F0F0F;
+	y = (y | (y << 2)) & 0x33333333;
+	y = (y | (y << 1)) & 0x55555555;
+	return x | (y << 1);
+}
+//bottom up merge sort of the z-order chain (Simon Tatham's linked list sort)
+static void _ec_sort_linked (_earcut_t* e, uint32_t list) {
+	uint32_t inSize = 1, numMerges;
+	do {
+		uint32_t p = list, tail = EC_NONE;
+		list = EC_NONE;
+		numMerges = 0;
+		while (p != EC_NONE) {
+			numMerges++;
+			uint32_t q = p, pSize = 0, qSize = inSize;
+			for (uint32_t i = 0; i < inSize; i++) {
+				pSize++;
+				q = NODE(q).nextZ;
+				if (q == EC_NONE)
+					break;
+			}
+			while (pSize > 0 || (qSize > 0 && q != EC_NONE)) {
+				uint32_t n;
+				if (pSize != 0 && (qSize == 0 || q == EC_NONE || NODE(p).z <= NODE(q).z)) {
+					n = p;
+					p = NODE(p).nextZ;
+					pSize--;
+				} else {
+					n = q;
+					q = NODE(q).nextZ;
+					qSize--;
+				}
+				if (tail != EC_NONE)
+					NODE(tail).nextZ = n;
+				else
+					list = n;
+				NODE(n).prevZ = tail;
+				tail = n;
+			}
+			p = q;
+		}
+		NODE(tail).nextZ = EC_NONE;
+		inSize *= 2;
+	} while (numMerges > 1);
+}
+static void _ec_index_curve (_earcut_t* e, uint32_t start) {
+	uint32_t p = start;
+	do {
+		if (NODE(p).z == 0)
+			NODE(p).z = _ec_z_order (e, NODE(p).x, NODE(p).y);
+		NODE(p).prevZ = NODE(p).prev;
+		NODE(p).nextZ = NODE(p).next;
+		p = NODE(p).next;
+	} while (p != start);
+	NODE(NODE(p).prevZ).nextZ = EC_NONE;
+	NODE(p).prevZ = EC_NONE;
+	_ec_sort_linked (e, p);
+}
+
+//p is a reflex vertex inside the triangle abc
+static inline bool _ec_blocks_ear (_earcut_t* e, uint32_t p, uint32_t a, uint32_t b, uint32_t c,
+								   float x0, float y0, float x1, float y1) {
+	_ec_node_t *P = &NODE(p), *A = &NODE(a), *B = &NODE(b), *C = &NODE(c);
+	return	P->x >= x0 && P->x <= x1 && P->y >= y0 && P->y <= y1 && p != a && p != c &&
+			_ec_point_in_triangle (A->x, A->y, B->x, B->y, C->x, C->y, P->x, P->y) &&
+			_ec_area (e, P->prev, p, P->next) >= 0;
+}
+static bool _ec_is_ear (_earcut_t* e, uint32_t ear) {
+	uint32_t a = NODE(ear).prev, b = ear, c = NODE(ear).next;
+	if (_ec_area (e, a, b, c) >= 0)
+		return false;//reflex
+	float	x0 = fminf (NODE(a).x, fminf (NODE(b).x, NODE(c).x)), y0 = fminf (NODE(a).y, fminf (NODE(b).y, NODE(c).y)),
+			x1 = fmaxf (NODE(a).x, fmaxf (NODE(b).x, NODE(c).x)), y1 = fmaxf (NODE(a).y, fmaxf (NODE(b).y, NODE(c).y));
+	for (uint32_t p = NODE(c).next; p != a; p = NODE(p).next) {
+		if (_ec_blocks_ear (e, p, a, b, c, x0, y0, x1, y1))
+			return false;
+	}
+	return true;
+}
+//only test vertices whose z-order is in the range of the ear bounding box, walking in both directions from the ear
+static bool _ec_is_ear_hashed (_earcut_t* e, uint32_t ear) {
+	uint32_t a = NODE(ear).prev, b = ear, c = NODE(ear).next;
+	if (_ec_area (e, a, b, c) >= 0)
+		return false;
+	float	x0 = fminf (NODE(a).x, fminf (NODE(b).x, NODE(c).x)), y0 = fminf (NODE(a).y, fminf (NODE(b).y, NODE(c).y)),
+			x1 = fmaxf (NODE(a).x, fmaxf (NODE(b).x, NODE(c).x)), y1 = fmaxf (NODE(a).y, fmaxf (NODE(b).y, NODE(c).y));
+	uint32_t minZ = _ec_z_order (e, x0, y0), maxZ = _ec_z_order (e, x1, y1);
+	uint32_t p = NODE(ear).prevZ, n = NODE(ear).nextZ;
+
+	while (p != EC_NONE && NODE(p).z >= minZ && n != EC_NONE && NODE(n).z <= maxZ) {
+		if (_ec_blocks_ear (e, p, a, b, c, x0, y0, x1, y1))
+			return false;
+		p = NODE(p).prevZ;
+		if (_ec_blocks_ear (e, n, a, b, c, x0, y0, x1, y1))
+			return false;
+		n = NODE(n).nextZ;
+	}
+	for (; p != EC_NONE && NODE(p).z >= minZ; p = NODE(p).prevZ) {
+		if (_ec_blocks_ear (e, p, a, b, c, x0, y0, x1, y1))
+			return false;
+	}
+	for (; n != EC_NONE && NODE(n).z <= maxZ; n = NODE(n).nextZ) {
+		if (_ec_blocks_ear (e, n, a, b, c, x0, y0, x1, y1))
+			return false;
+	}
+	return true;
+}
+static inline void _ec_emit (_earcut_t* e, uint32_t a, uint32_t b, uint32_t c) {
+	if (e->indCount + 3 > e->maxIndCount)
+		return;
+	uint32_t* v = e->vertices;
+	e->indices[e->indCount++] = e->firstIdx + (v ? v[NODE(a).i] : NODE(a).i);
+	e->indices[e->indCount++] = e->firstIdx + (v ? v[NODE(b).i] : NODE(b).i);
+	e->indices[e->indCount++] = e->firstIdx + (v ? v[NODE(c).i] : NODE(c).i);
+}
+//clip the triangle abcd where ab and cd cross
+static uint32_t _ec_cure_local_intersections (_earcut_t* e, uint32_t start) {
+	uint32_t p = start;
+	do {
+		uint32_t a = NODE(p).prev, b = NODE(NODE(p).next).next;
+		if (!_ec_equals (e, a, b) && _ec_intersects (e, a, p, NODE(p).next, b) &&
+				_ec_locally_inside (e, a, b) && _ec_locally_inside (e, b, a)) {
+			_ec_emit (e, a, p, b);
+			_ec_remove (e, p);
+			_ec_remove (e, NODE(p).next);
+			p = start = b;
+		}
+		p = NODE(p).next;
+	} while (p != start);
+	return _ec_filter_points (e, p, EC_NONE);
+}
+
+static void _ec_earcut_linked (_earcut_t* e, uint32_t ear, int pass);
+
+//split the polygon in two along a valid diagonal and triangulate both parts
+static void _ec_split_earcut (_earcut_t* e, uint32_t start) {
+	uint32_t a = start;
+	do {
+		for (uint32_t b = NODE(NODE(a).next).next; b != NODE(a).prev; b = NODE(b).next) {
+			if (NODE(a).i != NODE(b).i && _ec_is_valid_diagonal (e, a, b)) {
+				uint32_t c = _ec_split_polygon (e, a, b);
+				if (c == EC_NONE)
+					return;
+				a = _ec_filter_points (e, a, NODE(a).next);
+				c = _ec_filter_points (e, c, NODE(c).next);
+				_ec_earcut_linked (e, a, 0);
+				_ec_earcut_linked (e, c, 0);
+				return;
+			}
+		}
+		a = NODE(a).next;
+	} while (a != start);
+}
+//clip ears of the ring, if none is found filter degenerated points, then cure small self intersections and
+//finally split the ring in two.
+static void _ec_earcut_linked (_earcut_t* e, uint32_t ear, int pass) {
+	if (ear == EC_NONE)
+		return;
+	if (!pass && e->invSize != 0)
+		_ec_index_curve (e, ear);
+
+	uint32_t stop = ear;
+	while (NODE(ear).prev != NODE(ear).next) {
+		uint32_t prev = NODE(ear).prev, next = NODE(ear).next;
+		if (e->invSize != 0 ? _ec_is_ear_hashed (e, ear) : _ec_is_ear (e, ear)) {
+			_ec_emit (e, prev, ear, next);
+			_ec_remove (e, ear);
+			ear = stop = NODE(next).next;
+			continue;
+		}
+		ear = next;
+		if (ear == stop) {
+			if (pass == 0)
+				_ec_earcut_linked (e, _ec_filter_points (e, ear, EC_NONE), 1);
+			else if (pass == 1)
+				_ec_earcut_linked (e, _ec_cure_local_intersections (e, _ec_filter_points (e, ear, EC_NONE)), 2);
+			else
+				_ec_split_earcut (e, ear);
+			break;
+		}
+	}
+}
+
+static uint32_t _ec_leftmost (_earcut_t* e, uint32_t start) {
+	uint32_t p = start, leftmost = start;
+	do {
+		if (NODE(p).x < NODE(leftmost).x || (NODE(p).x == NODE(leftmost).x && NODE(p).y < NODE(leftmost).y))
+			leftmost = p;
+		p = NODE(p).next;
+	} while (p != start);
+	return leftmost;
+}
+//sector of m contains sector of p
+static inline bool _ec_sector_contains_sector (_earcut_t* e, uint32_t m, uint32_t p) {
+	return _ec_area (e, NODE(m).prev, m, NODE(p).prev) < 0 && _ec_area (e, NODE(p).next, m, NODE(m).next) < 0;
+}
+//David Eberly's algorithm for finding a bridge between a hole and the outer polygon
+static uint32_t _ec_find_hole_bridge (_earcut_t* e, uint32_t hole, uint32_t outer) {
+	uint32_t p = outer, m = EC_NONE;
+	float hx = NODE(hole).x, hy = NODE(hole).y, qx = -INFINITY;
+
+	//find a segment intersected by a ray from the hole's leftmost point to the left,
+	//its endpoint with lesser x will be a potential connection point
+	do {
+		_ec_node_t *P = &NODE(p), *N = &NODE(P->next);
+		if (hy <= P->y && hy >= N->y && N->y != P->y) {
+			float x = P->x + (hy - P->y) * (N->x - P->x) / (N->y - P->y);
+			if (x <= hx && x > qx) {
+				qx = x;
+				m = P->x < N->x ? p : P->next;
+				if (x == hx)
+					return m;//hole touches outer segment
+			}
+		}
+		p = P->next;
+	} while (p != outer);
+
+	if (m == EC_NONE)
+		return m;
+
+	//look for points inside the triangle of hole point, segment intersection and endpoint,
+	//if there are none, that endpoint is visible, else choose the point of the minimum angle with the ray.
+	uint32_t stop = m;
+	float mx = NODE(m).x, my = NODE(m).y, tanMin = INFINITY;
+	float bridgeTol = EC_EPSILON * ((hx - mx) * (hx - mx) + (hy - my) * (hy - my));
+	p = m;
+	do {
+		//points of resolved contours are often colinear with rounding errors, those close to the bridge are tested
+		//with a tolerance and near ties select the closest.
+		float px = NODE(p).x, py = NODE(p).y;
+		bool onBridge = fabsf ((px - mx) * (hy - my) - (py - my) * (hx - mx)) <= bridgeTol;
+		if (hx >= px && px >= mx && hx != px && (onBridge ||
+				_ec_point_in_triangle (hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, px, py))) {
+			float tan = fabsf (hy - py) / (hx - px);
+			bool tie = tanMin != INFINITY && fabsf (tan - tanMin) <= EC_EPSILON * tanMin;
+			if (_ec_locally_inside (e, p, hole) && ((tan < tanMin && !tie) ||
+					(tie && (px > NODE(m).x || (px == NODE(m).x && _ec_sector_contains_sector (e, m, p)))))) {
+				m = p;
+				tanMin = tan;
+			}
+		}
+		p = NODE(p).next;
+	} while (p != stop);
+	return m;
+}
+static int _ec_compare_x (const void* a, const void* b) {
+	float xa = ((const _ec_hole_t*)a)->x, xb = ((const _ec_hole_t*)b)->x;
+	return xa < xb ? -1 : xa > xb ? 1 : 0;
+}
+//node of the ring at the position of the hole node, whose sector contains the hole
+static uint32_t _ec_find_touching_node (_earcut_t* e, uint32_t hole, uint32_t outer) {
+	uint32_t p = outer;
+	do {
+		if (_ec_equals (e, hole, p) && _ec_locally_inside (e, p, NODE(hole).next))
+			return p;
+		p = NODE(p).next;
+	} while (p != outer);
+	return EC_NONE;
+}
+static bool _ec_link_hole (_earcut_t* e, uint32_t bridge, uint32_t hole, uint32_t* outerNode) {
+	uint32_t bridgeReverse = _ec_split_polygon (e, bridge, hole);
+	if (bridgeReverse == EC_NONE)
+		return false;
+	_ec_filter_points (e, bridgeReverse, NODE(bridgeReverse).next);
+	*outerNode = _ec_filter_points (e, bridge, NODE(bridge).next);
+	return true;
+}
+//link the chained holes of an outer contour into its ring. Holes touching the ring are linked first at the shared
+//point, the others from left to right.
+static uint32_t _ec_eliminate_holes (_earcut_t* e, uint32_t firstHole, uint32_t outerNode) {
+	uint32_t holeCount = 0;
+	for (uint32_t h = firstHole; h != EC_NONE && !e->failed; h = e->contours[h].nextHole) {
+		uint32_t list = _ec_linked_list (e, &e->contours[h], false);
+		if (list == EC_NONE)
+			continue;
+		if (list == NODE(list).next)
+			NODE(list).steiner = true;
+		if (e->contours[h].touch != EC_NONE) {
+			uint32_t p = list;
+			while (NODE(p).i != e->contours[h].touch && NODE(p).next != list)
+				p = NODE(p).next;
+			uint32_t bridge = NODE(p).i == e->contours[h].touch ? _ec_find_touching_node (e, p, outerNode) : EC_NONE;
+			if (bridge != EC_NONE) {
+				if (!_ec_link_hole (e, bridge, p, &outerNode))
+					return outerNode;
+				continue;
+			}
+		}
+		uint32_t leftmost = _ec_leftmost (e, list);
+		_ec_hole_t hole = {NODE(leftmost).x, leftmost};
+		e->queue[holeCount++] = hole;
+	}
+	qsort (e->queue, holeCount, sizeof(_ec_hole_t), _ec_compare_x);
+
+	for (uint32_t i = 0; i < holeCount && !e->failed; i++) {
+		uint32_t hole = e->queue[i].node;
+		uint32_t bridge = _ec_find_hole_bridge (e, hole, outerNode);
+		if (bridge == EC_NONE)
+			continue;
+		if (!_ec_link_hole (e, bridge, hole, &outerNode))
+			break;
+	}
+	return outerNode;
+}
+
+//contribution of edge ab to the winding number around p
+static inline int _ec_edge_winding (vec2 a, vec2 b, vec2 p) {
+	float l = (b.x - a.x) * (p.y - a.y) - (p.x - a.x) * (b.y - a.y);
+	if (a.y <= p.y)
+		return b.y > p.y && l > 0 ? 1 : 0;
+	return b.y <= p.y && l < 0 ? -1 : 0;
+}
+//winding number of the contour around p
+static int _ec_winding (_earcut_t* e, _ec_contour_t* c, vec2 p) {
+	if (p.x < c->min.x || p.x > c->max.x || p.y < c->min.y || p.y > c->max.y)
+		return 0;
+	const vec2* pts = e->pts + c->first;
+	int w = 0;
+	for (uint32_t i = 0, j = c->count - 1; i < c->count; j = i++)
+		w += _ec_edge_winding (pts[j], pts[i], p);
+	return w;
+}
+//middle of the first edge, a vertex is more likely to be shared with a contour touching this one
+static vec2 _ec_contour_sample (_earcut_t* e, _ec_contour_t* c) {
+	vec2 a = e->pts[c->first], b = e->pts[c->first + 1];
+	return (vec2) {(a.x + b.x) / 2, (a.y + b.y) / 2};
+}
+//winding of the other contours around contour c
+static int _ec_surrounding_winding (_earcut_t* e, uint32_t c) {
+	vec2 p = _ec_contour_sample (e, &e->contours[c]);
+	int w = 0;
+	for (uint32_t o = 0; o < e->contourCount; o++) {
+		if (o != c)
+			w += _ec_winding (e, &e->contours[o], p);
+	}
+	return w;
+}
+//with the non-zero rule, a contour that doesn't cross the others is an outer boundary if the winding of the other
+//contours around it is zero, a hole if its own winding brings it back to zero. Other contours are inside the filled
+//area and are dropped. Resolved contours have the filled area on their left, their orientation gives their role.
+//Holes are attached to the smallest outer contour surrounding them.
+static void _ec_classify_contours (_earcut_t* e) {
+	for (uint32_t c = 0; c < e->contourCount; c++) {
+		_ec_contour_t* cnt = &e->contours[c];
+		if (e->vertices) {
+			cnt->role = cnt->area > 0 ? EC_CONTOUR_OUTER : cnt->area < 0 ? EC_CONTOUR_HOLE : EC_CONTOUR_NONE;
+			continue;
+		}
+		int w = _ec_surrounding_winding (e, c);
+		if (w == 0)
+			cnt->role = EC_CONTOUR_OUTER;
+		else if (w + (cnt->area < 0 ? -1 : 1) == 0)
+			cnt->role = EC_CONTOUR_HOLE;
+	}
+	for (uint32_t h = 0; h < e->contourCount; h++) {
+		_ec_contour_t* hole = &e->contours[h];
+		if (hole->role != EC_CONTOUR_HOLE)
+			continue;
+		vec2 p = _ec_contour_sample (e, hole);
+		uint32_t parent = EC_NONE;
+		for (uint32_t o = 0; o < e->contourCount; o++) {
+			_ec_contour_t* outer = &e->contours[o];
+			if (outer->role != EC_CONTOUR_OUTER || (parent != EC_NONE && fabsf (outer->area) >= fabsf (e->contours[parent].area)))
+				continue;
+			if (_ec_winding (e, outer, p) != 0)
+				parent = o;
+		}
+		if (parent == EC_NONE) {
+			hole->role = EC_CONTOUR_NONE;
+			continue;
+		}
+		hole->nextHole = e->contours[parent].firstHole;
+		e->contours[parent].firstHole = h;
+	}
+}
+static void _ec_add_contour (_earcut_t* e, uint32_t first, uint32_t count) {
+	_ec_contour_t c = {first, count, 0, e->pts[first], e->pts[first], EC_CONTOUR_NONE, EC_NONE, EC_NONE, EC_NONE};
+	for (uint32_t i = first, j = first + count - 1; i < first + count; j = i++) {
+		vec2 a = e->pts[j], b = e->pts[i];
+		c.area += a.x * b.y - b.x * a.y;
+		c.min.x = fminf (c.min.x, b.x);
+		c.min.y = fminf (c.min.y, b.y);
+		c.max.x = fmaxf (c.max.x, b.x);
+		c.max.y = fmaxf (c.max.y, b.y);
+	}
+	e->contours[e->contourCount++] = c;
+}
+//contour is copied, arena may grow while splitting polygons
+static void _ec_triangulate_outer (_earcut_t* e, _ec_contour_t outer) {
+	uint32_t outerNode = _ec_linked_list (e, &outer, true);
+	if (outerNode == EC_NONE || NODE(outerNode).next == NODE(outerNode).prev)
+		return;
+	uint32_t pointCount = outer.count;
+	for (uint32_t h = outer.firstHole; h != EC_NONE; h = e->contours[h].nextHole)
+		pointCount += e->contours[h].count;
+	if (outer.firstHole != EC_NONE)
+		outerNode = _ec_eliminate_holes (e, outer.firstHole, outerNode);
+	if (e->failed)
+		return;
+
+	e->invSize = 0;
+	if (pointCount > EC_HASH_THRESHOLD) {
+		e->minX = outer.min.x;
+		e->minY = outer.min.y;
+		float size = fmaxf (outer.max.x - outer.min.x, outer.max.y - outer.min.y);
+		e->invSize = size != 0 ? 32767.f / size : 0;
+	}
+	_ec_earcut_linked (e, outerNode, 0);
+}
+
+//Contours crossing each other or themselves are resolved before triangulation: edges are split where they cross,
+//then the winding of the source contours is sampled on both sides of each piece. Pieces separating a filled area
+//from an empty one are kept and chained in new contours that may touch but don't cross anymore. Scratch arrays are
+//allocated in the arena after the contours and addressed by offset while they may grow.
+typedef struct {
+	size_t		edges, active, splits;
+	uint32_t	edgeCount, splitCount, maxSplits;
+	uint32_t	interCount;
+	uint32_t	touchCount;		//vertices shared by coordinates, contours are rebuilt around them even without split
+} _ec_resolve_t;
+
+#define EC_AT(type, offset) ((type*)((char*)e->arena->mem + (offset)))
+
+static int _ec_compare_edges (const void* a, const void* b) {
+	float ya = ((const _ec_edge_t*)a)->ymin, yb = ((const _ec_edge_t*)b)->ymin;
+	return ya < yb ? -1 : ya > yb ? 1 : 0;
+}
+static int _ec_compare_splits (const void* a, const void* b) {
+	const _ec_split_t *sa = (const _ec_split_t*)a, *sb = (const _ec_split_t*)b;
+	if (sa->edge != sb->edge)
+		return sa->edge < sb->edge ? -1 : 1;
+	return sa->t < sb->t ? -1 : sa->t > sb->t ? 1 : 0;
+}
+static int _ec_compare_vertices (const void* a, const void* b) {
+	const _ec_vertex_t *va = (const _ec_vertex_t*)a, *vb = (const _ec_vertex_t*)b;
+	if (va->x != vb->x)
+		return va->x < vb->x ? -1 : 1;
+	if (va->y != vb->y)
+		return va->y < vb->y ? -1 : 1;
+	return va->v < vb->v ? -1 : va->v > vb->v ? 1 : 0;
+}
+static int _ec_compare_samples (const void* a, const void* b) {
+	float ya = ((const _ec_sample_t*)a)->y, yb = ((const _ec_sample_t*)b)->y;
+	return ya < yb ? -1 : ya > yb ? 1 : 0;
+}
+static bool _ec_push_split (_earcut_t* e, _ec_resolve_t* r, uint32_t edge, float t, uint32_t vertex, vec2 pos) {
+	if (r->splitCount == r->maxSplits) {
+		if (!tess_arena_reserve (e->arena, r->splits + (size_t)r->maxSplits * 2 * sizeof(_ec_split_t)))
+			return false;
+		r->maxSplits *= 2;
+	}
+	_ec_split_t s = {edge, t, vertex, pos};
+	EC_AT(_ec_split_t, r->splits)[r->splitCount++] = s;
+	return true;
+}
+//split edge at vertex v if v lies inside of it, v being on its line
+static bool _ec_split_at_vertex (_earcut_t* e, _ec_resolve_t* r, uint32_t edge, uint32_t v) {
+	_ec_edge_t ed = EC_AT(_ec_edge_t, r->edges)[edge];
+	vec2 a = e->pts[ed.a], b = e->pts[ed.b], p = e->pts[v];
+	vec2 d = {b.x - a.x, b.y - a.y};
+	float t = ((p.x - a.x) * d.x + (p.y - a.y) * d.y) / (d.x * d.x + d.y * d.y);
+	if (t <= EC_EPSILON || t >= 1 - EC_EPSILON)
+		return true;
+	return _ec_push_split (e, r, edge, t, v, p);
+}
+//split edges i and j where they cross, or where an end of one lies on the other
+static bool _ec_split_crossing (_earcut_t* e, _ec_resolve_t* r, uint32_t i, uint32_t j) {
+	_ec_edge_t ei = EC_AT(_ec_edge_t, r->edges)[i], ej = EC_AT(_ec_edge_t, r->edges)[j];
+	vec2 p = e->pts[ei.a], q = e->pts[ei.b], a = e->pts[ej.a], b = e->pts[ej.b];
+	if (fmaxf (p.x, q.x) < fminf (a.x, b.x) || fminf (p.x, q.x) > fmaxf (a.x, b.x))
+		return true;
+	vec2 d1 = {q.x - p.x, q.y - p.y}, d2 = {b.x - a.x, b.y - a.y}, w = {a.x - p.x, a.y - p.y};
+	float d = d1.x * d2.y - d1.y * d2.x;
+	if (d == 0) {
+		if (w.x * d1.y - w.y * d1.x != 0)//parallel
+			return true;
+		//colinear overlaps are split at the ends of each edge lying inside the other, pieces then share their vertices
+		return _ec_split_at_vertex (e, r, i, ej.a) && _ec_split_at_vertex (e, r, i, ej.b) &&
+				_ec_split_at_vertex (e, r, j, ei.a) && _ec_split_at_vertex (e, r, j, ei.b);
+	}
+	if (ei.a == ej.a || ei.a == ej.b || ei.b == ej.a || ei.b == ej.b)
+		return true;
+	float t = (w.x * d2.y - w.y * d2.x) / d;
+	float u = (w.x * d1.y - w.y * d1.x) / d;
+	if (t < -EC_EPSILON || t > 1 + EC_EPSILON || u < -EC_EPSILON || u > 1 + EC_EPSILON)
+		return true;
+	bool tIn = t > EC_EPSILON && t < 1 - EC_EPSILON, uIn = u > EC_EPSILON && u < 1 - EC_EPSILON;
+	if (tIn && uIn) {
+		vec2 pos = {p.x + t * d1.x, p.y + t * d1.y};
+		uint32_t v = e->pointCount + r->interCount++;
+		return _ec_push_split (e, r, i, t, v, pos) && _ec_push_split (e, r, j, u, v, pos);
+	}
+	if (tIn) {
+		uint32_t v = u < 0.5f ? ej.a : ej.b;
+		return _ec_push_split (e, r, i, t, v, e->pts[v]);
+	}
+	if (uIn) {
+		uint32_t v = t < 0.5f ? ei.a : ei.b;
+		return _ec_push_split (e, r, j, u, v, e->pts[v]);
+	}
+	//contours touching at a vertex are joined by its coordinates
+	r->touchCount++;
+	return true;
+}
+//sweep edges sorted by ymin, edges overlapping the current one in y are kept in the active list
+static bool _ec_find_splits (_earcut_t* e, _ec_resolve_t* r) {
+	uint32_t activeCount = 0;
+	for (uint32_t i = 0; i < r->edgeCount; i++) {
+		_ec_edge_t* edges = EC_AT(_ec_edge_t, r->edges);
+		uint32_t* active = EC_AT(uint32_t, r->active);
+		uint32_t k = 0;
+		for (uint32_t a = 0; a < activeCount; a++) {
+			if (edges[active[a]].ymax >= edges[i].ymin)
+				active[k++] = active[a];
+		}
+		activeCount = k;
+		for (uint32_t a = 0; a < activeCount; a++) {
+			if (!_ec_split_crossing (e, r, EC_AT(uint32_t, r->active)[a], i))
+				return false;
+		}
+		EC_AT(uint32_t, r->active)[activeCount++] = i;
+	}
+	return true;
+}
+//winding on both sides of the sub edges, sampled close to their middle. Sub edges are closed as the source contours
+//are, and are used as the winding source: a vertex split on an edge may lie slightly off its line, samples could then
+//fall on the same side of the source edge. Samples are swept along y, sub edges crossing their horizontal being kept
+//in the active list.
+static void _ec_sample_windings (const vec2* pos, _ec_sub_edge_t* subs, uint32_t subCount, _ec_edge_t* edges,
+								 uint32_t* active, _ec_sample_t* samples) {
+	for (uint32_t s = 0; s < subCount; s++) {
+		vec2 a = pos[subs[s].a], b = pos[subs[s].b];
+		vec2 m = {(a.x + b.x) / 2, (a.y + b.y) / 2}, d = {b.x - a.x, b.y - a.y};
+		float len = sqrtf (d.x * d.x + d.y * d.y);
+		float o = (fabsf (m.x) + fabsf (m.y)) * 4 * FLT_EPSILON / len;
+		_ec_sample_t left = {m.x - d.y * o, m.y + d.x * o, s * 2}, right = {m.x + d.y * o, m.y - d.x * o, s * 2 + 1};
+		samples[s * 2] = left;
+		samples[s * 2 + 1] = right;
+		_ec_edge_t edge = {subs[s].a, subs[s].b, fminf (a.y, b.y), fmaxf (a.y, b.y)};
+		edges[s] = edge;
+	}
+	qsort (samples, subCount * 2, sizeof(_ec_sample_t), _ec_compare_samples);
+	qsort (edges, subCount, sizeof(_ec_edge_t), _ec_compare_edges);
+
+	uint32_t activeCount = 0, next = 0;
+	for (uint32_t s = 0; s < subCount * 2; s++) {
+		vec2 p = {samples[s].x, samples[s].y};
+		while (next < subCount && edges[next].ymin <= p.y)
+			active[activeCount++] = next++;
+		int w = 0;
+		uint32_t k = 0;
+		for (uint32_t a = 0; a < activeCount; a++) {
+			_ec_edge_t* edge = &edges[active[a]];
+			if (edge->ymax <= p.y)
+				continue;
+			active[k++] = active[a];
+			w += _ec_edge_winding (pos[edge->a], pos[edge->b], p);
+		}
+		activeCount = k;
+		_ec_sub_edge_t* sub = &subs[samples[s].side / 2];
+		if (samples[s].side & 1)
+			sub->wr = w;
+		else
+			sub->wl = w;
+	}
+}
+//next sub edge of a resolved contour at the end of c: the first one met turning clockwise from c backward, so that
+//the contour keeps following the filled area around vertices shared by several pieces.
+static uint32_t _ec_next_sub_edge (_ec_sub_edge_t* subs, const uint32_t* out, uint32_t count, const vec2* pos,
+								   const _ec_sub_edge_t* c) {
+	vec2 v = pos[c->b], r = {pos[c->a].x - v.x, pos[c->a].y - v.y};
+	uint32_t next = EC_NONE;
+	float best = -1;
+	for (uint32_t i = 0; i < count; i++) {
+		_ec_sub_edge_t* o = &subs[out[i]];
+		if (o->used)
+			continue;
+		vec2 d = {pos[o->b].x - v.x, pos[o->b].y - v.y};
+		float a = atan2f (r.x * d.y - r.y * d.x, r.x * d.x + r.y * d.y);
+		if (a < 0)
+			a += 2 * M_PIF;
+		if (a > best) {
+			best = a;
+			next = out[i];
+		}
+	}
+	return next;
+}
+static void _ec_reverse (vec2* pts, uint32_t* vertices, uint32_t first, uint32_t end) {
+	while (first + 1 < end) {
+		end--;
+		vec2 p = pts[first];
+		pts[first] = pts[end];
+		pts[end] = p;
+		uint32_t v = vertices[first];
+		vertices[first++] = vertices[end];
+		vertices[end] = v;
+	}
+}
+//swap the ranges [first, mid) and [mid, end)
+static void _ec_rotate (vec2* pts, uint32_t* vertices, uint32_t first, uint32_t mid, uint32_t end) {
+	_ec_reverse (pts, vertices, first, mid);
+	_ec_reverse (pts, vertices, mid, end);
+	_ec_reverse (pts, vertices, first, end);
+}
+//replace the source contours with the resolved ones, whose points are in the arena with the index of their vertex:
+//source points are followed by intersections.
+static bool _ec_resolve_contours (_earcut_t* e, _ec_resolve_t* r, const vec2** intersections) {
+	const vec2* src = e->pts;
+	uint32_t vertCount = e->pointCount + r->interCount, maxSubs = r->edgeCount + r->splitCount;
+	size_t verts	= EC_ALIGN(r->splits + r->splitCount * sizeof(_ec_split_t));
+	size_t canon	= EC_ALIGN(verts + vertCount * sizeof(_ec_vertex_t));
+	size_t subs		= EC_ALIGN(canon + vertCount * sizeof(uint32_t));
+	size_t subEdges	= EC_ALIGN(subs + maxSubs * sizeof(_ec_sub_edge_t));
+	size_t active	= EC_ALIGN(subEdges + maxSubs * sizeof(_ec_edge_t));
+	size_t samples	= EC_ALIGN(active + maxSubs * sizeof(uint32_t));
+	size_t outStart	= EC_ALIGN(samples + maxSubs * 2 * sizeof(_ec_sample_t));
+	size_t out		= EC_ALIGN(outStart + (vertCount + 1) * sizeof(uint32_t));
+	size_t pos		= EC_ALIGN(out + maxSubs * sizeof(uint32_t));
+	e->contoursOffset	= EC_ALIGN(pos + vertCount * sizeof(vec2));
+	e->maxContours		= maxSubs;
+	e->ptsOffset		= EC_ALIGN(e->contoursOffset + maxSubs * (sizeof(_ec_contour_t) + sizeof(_ec_hole_t)));
+	e->resolvedCount	= maxSubs;
+	e->nodesOffset		= EC_ALIGN(e->ptsOffset + maxSubs * (sizeof(vec2) + sizeof(uint32_t)));
+	if (!_ec_reserve (e, maxSubs * 3))
+		return false;
+
+	_ec_split_t* splits = EC_AT(_ec_split_t, r->splits);
+	vec2* vpos = EC_AT(vec2, pos);
+	memcpy (vpos, src, e->pointCount * sizeof(vec2));
+	for (uint32_t s = 0; s < r->splitCount; s++) {
+		if (splits[s].vertex >= e->pointCount)
+			vpos[splits[s].vertex] = splits[s].pos;
+	}
+	//vertices closer than the rounding error of intersections are merged, edges crossing at the same point give
+	//intersections a few ulps apart.
+	_ec_vertex_t* v = EC_AT(_ec_vertex_t, verts);
+	uint32_t* c = EC_AT(uint32_t, canon);
+	for (uint32_t i = 0; i < vertCount; i++) {
+		_ec_vertex_t vx = {vpos[i].x, vpos[i].y, i};
+		v[i] = vx;
+	}
+	qsort (v, vertCount, sizeof(_ec_vertex_t), _ec_compare_vertices);
+	for (uint32_t i = 0; i < vertCount; i++) {
+		float tol = (fabsf (v[i].x) + fabsf (v[i].y)) * 16 * FLT_EPSILON;
+		c[v[i].v] = v[i].v;
+		for (uint32_t j = i; j > 0 && v[i].x - v[j - 1].x <= tol; j--) {
+			if (fabsf (v[i].y - v[j - 1].y) <= tol) {
+				c[v[i].v] = c[v[j - 1].v];
+				break;
+			}
+		}
+	}
+
+	qsort (splits, r->splitCount, sizeof(_ec_split_t), _ec_compare_splits);
+	_ec_edge_t* edges = EC_AT(_ec_edge_t, r->edges);
+	_ec_sub_edge_t* sub = EC_AT(_ec_sub_edge_t, subs);
+	uint32_t subCount = 0;
+	for (uint32_t i = 0, s = 0; i < r->edgeCount; i++) {
+		uint32_t prev = c[edges[i].a];
+		for (; s < r->splitCount && splits[s].edge == i; s++) {
+			uint32_t next = c[splits[s].vertex];
+			if (next == prev)
+				continue;
+			_ec_sub_edge_t se = {prev, next, 0, 0, false, false};
+			sub[subCount++] = se;
+			prev = next;
+		}
+		if (c[edges[i].b] != prev) {
+			_ec_sub_edge_t se = {prev, c[edges[i].b], 0, 0, false, false};
+			sub[subCount++] = se;
+		}
+	}
+	_ec_sample_windings (vpos, sub, subCount, EC_AT(_ec_edge_t, subEdges), EC_AT(uint32_t, active),
+						 EC_AT(_ec_sample_t, samples));
+
+	//kept sub edges are oriented with the filled area on their left and indexed by their first vertex
+	uint32_t* start = EC_AT(uint32_t, outStart);
+	uint32_t* o = EC_AT(uint32_t, out);
+	memset (start, 0, (vertCount + 1) * sizeof(uint32_t));
+	for (uint32_t s = 0; s < subCount; s++) {
+		sub[s].keep = (sub[s].wl != 0) != (sub[s].wr != 0);
+		if (!sub[s].keep)
+			continue;
+		if (sub[s].wl == 0) {
+			uint32_t tmp = sub[s].a;
+			sub[s].a = sub[s].b;
+			sub[s].b = tmp;
+		}
+		start[sub[s].a + 1]++;
+	}
+	for (uint32_t i = 0; i < vertCount; i++)
+		start[i + 1] += start[i];
+	for (uint32_t s = 0; s < subCount; s++) {
+		if (sub[s].keep)
+			o[start[sub[s].a]++] = s;
+	}
+	for (uint32_t i = vertCount; i > 0; i--)
+		start[i] = start[i - 1];
+	start[0] = 0;
+	//pieces of colinear overlaps bounding the same area are kept once
+	for (uint32_t i = 0; i < vertCount; i++) {
+		for (uint32_t k = start[i]; k < start[i + 1]; k++) {
+			for (uint32_t l = start[i]; l < k; l++) {
+				if (sub[o[l]].b == sub[o[k]].b) {
+					sub[o[k]].used = true;
+					break;
+				}
+			}
+		}
+	}
+
+	//vertices of the contour being chained are marked with their position
+	vec2* pts = (vec2*)e->pts;
+	uint32_t* mark = c;
+	memset (mark, 0xff, vertCount * sizeof(uint32_t));
+	uint32_t n = 0;
+	e->contourCount = 0;
+	for (uint32_t s = 0; s < subCount; s++) {
+		if (!sub[s].keep || sub[s].used)
+			continue;
+		uint32_t first = n, cur = s;
+		while (cur != EC_NONE) {
+			_ec_sub_edge_t* se = &sub[cur];
+			se->used = true;
+			uint32_t k = mark[se->a];
+			if (k != EC_NONE) {
+				//pinched contour: the loop closed on this vertex is moved first and split from the contour, earcut
+				//expects rings that don't touch themselves.
+				_ec_rotate (pts, e->vertices, first, k, n);
+				uint32_t loopCount = n - k;
+				for (uint32_t i = first; i < n; i++)
+					mark[e->vertices[i]] = i < first + loopCount ? EC_NONE : i;
+				if (loopCount > 2)
+					_ec_add_contour (e, first, loopCount);
+				first += loopCount;
+			}
+			mark[se->a] = n;
+			pts[n] = vpos[se->a];
+			e->vertices[n++] = se->a;
+			if (se->b == sub[s].a)
+				break;
+			cur = _ec_next_sub_edge (sub, o + start[se->b], start[se->b + 1] - start[se->b], vpos, se);
+		}
+		for (uint32_t i = first; i < n; i++)
+			mark[e->vertices[i]] = EC_NONE;
+		if (n - first > 2)
+			_ec_add_contour (e, first, n - first);
+		else
+			n = first;
+	}
+	memset (mark, 0, vertCount * sizeof(uint32_t));
+	for (uint32_t i = 0; i < e->contourCount; i++) {
+		for (uint32_t j = e->contours[i].first; j < e->contours[i].first + e->contours[i].count; j++)
+			mark[e->vertices[j]]++;
+	}
+	for (uint32_t i = 0; i < e->contourCount; i++) {
+		for (uint32_t j = e->contours[i].first; j < e->contours[i].first + e->contours[i].count; j++) {
+			if (mark[e->vertices[j]] > 1) {
+				e->contours[i].touch = j;
+				break;
+			}
+		}
+	}
+	e->maxIndCount = (n + e->contourCount * 2) * 3;
+	*intersections = vpos + e->pointCount;
+	return true;
+}
+
+bool tess_earcut_begin (tess_arena_t* arena, const vec2* pts, uint32_t pointCount, uint32_t contourCount) {
+	_earcut_t e = {0};
+	e.arena			= arena;
+	e.pts			= pts;
+	e.pointCount	= pointCount;
+	e.maxContours	= contourCount;
+	e.contoursOffset= EC_HEADER_SIZE;
+	e.nodesOffset	= EC_ALIGN(EC_HEADER_SIZE + contourCount * (sizeof(_ec_contour_t) + sizeof(_ec_hole_t)));
+	if (!_ec_reserve (&e, pointCount + contourCount * 2))
+		return false;
+	*(_earcut_t*)arena->mem = e;
+	return true;
+}
+void tess_earcut_contour (tess_arena_t* arena, uint32_t first, uint32_t count) {
+	_earcut_t* e = (_earcut_t*)arena->mem;
+	if (count < 3 || e->contourCount == e->maxContours)
+		return;
+	_ec_add_contour (e, first, count);
+}
+bool tess_earcut_resolve (tess_arena_t* arena, const vec2** intersections, uint32_t* intersectionCount, uint32_t* maxIndCount) {
+	_earcut_t state = *(_earcut_t*)arena->mem, *e = &state;
+	_ec_resolve_t r = {0};
+	r.edges		= e->nodesOffset;
+	r.active	= EC_ALIGN(r.edges + e->pointCount * sizeof(_ec_edge_t));
+	r.splits	= EC_ALIGN(r.active + e->pointCount * sizeof(uint32_t));
+	r.maxSplits	= e->pointCount > 8 ? e->pointCount : 8;
+	if (!tess_arena_reserve (arena, r.splits + r.maxSplits * sizeof(_ec_split_t)))
+		return false;
+
+	_ec_edge_t* edges = EC_AT(_ec_edge_t, r.edges);
+	_ec_contour_t* contours = EC_AT(_ec_contour_t, e->contoursOffset);
+	for (uint32_t c = 0; c < e->contourCount; c++) {
+		for (uint32_t i = 0, j = contours[c].count - 1; i < contours[c].count; j = i++) {
+			uint32_t a = contours[c].first + j, b = contours[c].first + i;
+			if (e->pts[a].x == e->pts[b].x && e->pts[a].y == e->pts[b].y)
+				continue;
+			_ec_edge_t edge = {a, b, fminf (e->pts[a].y, e->pts[b].y), fmaxf (e->pts[a].y, e->pts[b].y)};
+			edges[r.edgeCount++] = edge;
+		}
+	}
+	qsort (edges, r.edgeCount, sizeof(_ec_edge_t), _ec_compare_edges);
+	if (!_ec_find_splits (e, &r))
+		return false;
+
+	*intersections = NULL;
+	*intersectionCount = 0;
+	if (r.splitCount == 0 && r.touchCount == 0) {
+		//arena may have moved
+		if (!_ec_reserve (e, e->maxNodes))
+			return false;
+		e->maxIndCount = (e->pointCount + e->maxContours * 2) * 3;
+	} else {
+		if (!_ec_resolve_contours (e, &r, intersections))
+			return false;
+		*intersectionCount = r.interCount;
+	}
+	*(_earcut_t*)arena->mem = state;
+	*maxIndCount = e->maxIndCount;
+	return true;
+}
+bool tess_earcut_boundary (tess_arena_t* arena, uint32_t i, const vec2** pts, uint32_t* count, bool* perpFilled) {
+	_earcut_t* e = (_earcut_t*)arena->mem;
+	if (i >= e->contourCount)
+		return false;
+	_ec_contour_t* c = &e->contours[i];
+	*pts = e->pts + c->first;
+	*count = c->count;
+	if (e->vertices) {//filled area on the left
+		*perpFilled = false;
+		return true;
+	}
+	int w = _ec_surrounding_winding (e, i);
+	bool outFilled = w != 0, inFilled = w + (c->area < 0 ? -1 : 1) != 0;
+	if (outFilled == inFilled || c->area == 0)
+		*count = 0;
+	//inside of counter clockwise contours is on their left
+	*perpFilled = c->area > 0 ? outFilled : inFilled;
+	return true;
+}
+bool tess_earcut_end (tess_arena_t* arena, uint32_t firstIdx, uint32_t* indices, uint32_t* indCount) {
+	//work on a copy of the state, arena may be moved while splitting polygons
+	_earcut_t e = *(_earcut_t*)arena->mem;
+	e.indices		= indices;
+	e.firstIdx		= firstIdx;
+
+	_ec_classify_contours (&e);
+	for (uint32_t c = 0; c < e.contourCount && !e.failed; c++) {
+		if (e.contours[c].role == EC_CONTOUR_OUTER)
+			_ec_triangulate_outer (&e, e.contours[c]);
+	}
+	*indCount = e.indCount;
+	return !e.failed;
+}
+#undef EC_AT
+#undef NODE
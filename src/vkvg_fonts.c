@@ -67,6 +67,8 @@ void _fonts_cache_create (VkvgDevice dev){
 #endif
 
 	cache->texLength = FONT_CACHE_INIT_LAYERS;
+	_device_reserve_memory (dev, VKVG_MEMORY_FONT_ATLAS,
+							_device_image_size (cache->texFormat, VK_SAMPLE_COUNT_1_BIT, FONT_PAGE_SIZE, FONT_PAGE_SIZE, cache->texLength));
 	cache->texture = vkh_tex2d_array_create ((VkhDevice)dev, cache->texFormat, FONT_PAGE_SIZE, FONT_PAGE_SIZE,
 							cache->texLength ,VMA_MEMORY_USAGE_GPU_ONLY,
 							VK_IMAGE_USAGE_SAMPLED_BIT|VK_IMAGE_USAGE_TRANSFER_DST_BIT|VK_IMAGE_USAGE_TRANSFER_SRC_BIT);
@@ -105,11 +107,14 @@ void _increase_font_tex_array (VkvgDevice dev){
 	_font_cache_t* cache = dev->fontCache;
 
 	vkWaitForFences		(dev->vkDev, 1, &cache->uploadFence, VK_TRUE, UINT64_MAX);
+	_device_release_deferred (dev, false);//before upload fence reset
 	_device_reset_fence (dev, cache->uploadFence);
 
 	vkResetCommandBuffer(cache->cmd, 0);
 
 	uint8_t newSize = cache->texLength + FONT_CACHE_INIT_LAYERS;
+	_device_reserve_memory (dev, VKVG_MEMORY_FONT_ATLAS,
+							_device_image_size (cache->texFormat, VK_SAMPLE_COUNT_1_BIT, FONT_PAGE_SIZE, FONT_PAGE_SIZE, newSize));
 	VkhImage newImg = vkh_tex2d_array_create ((VkhDevice)dev, cache->texFormat, FONT_PAGE_SIZE, FONT_PAGE_SIZE,
 											  newSize ,VMA_MEMORY_USAGE_GPU_ONLY,
 											  VK_IMAGE_USAGE_SAMPLED_BIT|VK_IMAGE_USAGE_TRANSFER_DST_BIT|VK_IMAGE_USAGE_TRANSFER_SRC_BIT);
@@ -145,17 +150,17 @@ void _increase_font_tex_array (VkvgDevice dev){
 	VK_CHECK_RESULT(vkEndCommandBuffer(cache->cmd));
 
 	_device_submit_cmd			(dev, &cache->cmd, cache->uploadFence);
-	vkWaitForFences		(dev->vkDev, 1, &cache->uploadFence, VK_TRUE, UINT64_MAX);
 
 	cache->pensY = (int*)realloc(cache->pensY, newSize * sizeof(int));
 	void* tmp = memset (&cache->pensY[cache->texLength],0,FONT_CACHE_INIT_LAYERS*sizeof(int));
 
-	vkh_image_destroy	(cache->texture);
+	//contexts keep their own reference on the old texture until they rebind, cache reference is dropped once the copy is done.
+	_device_defer_image (dev, cache->texture, cache->uploadFence);
+	_device_release_memory (dev, VKVG_MEMORY_FONT_ATLAS,
+							_device_image_size (cache->texFormat, VK_SAMPLE_COUNT_1_BIT, FONT_PAGE_SIZE, FONT_PAGE_SIZE, cache->texLength));
 
 	cache->texLength   = newSize;
 	cache->texture	   = newImg;
-
-	_device_wait_idle(dev);
 }
 //flush font stagging buffer to cache texture array
 //Trigger stagging buffer to be uploaded in font cache. Groupping upload improve performances.
@@ -167,6 +172,7 @@ void _flush_chars_to_tex (VkvgDevice dev, _vkvg_font_t* f) {
 
 	LOG(VKVG_LOG_INFO, "_flush_chars_to_tex pen(%d, %d)\n",f->curLine.penX, f->curLine.penY);
 	vkWaitForFences		(dev->vkDev,1,&cache->uploadFence,VK_TRUE,UINT64_MAX);
+	_device_release_deferred (dev, false);//before upload fence reset
 	_device_reset_fence (dev, cache->uploadFence);
 	vkResetCommandBuffer(cache->cmd,0);
 
@@ -259,6 +265,8 @@ void _font_cache_destroy (VkvgDevice dev){
 
 	vkvg_buffer_destroy (&cache->buff);
 	vkh_image_destroy	(cache->texture);
+	_device_release_memory (dev, VKVG_MEMORY_FONT_ATLAS,
+							_device_image_size (cache->texFormat, VK_SAMPLE_COUNT_1_BIT, FONT_PAGE_SIZE, FONT_PAGE_SIZE, cache->texLength));
 	//vkFreeCommandBuffers(dev->vkDev,dev->cmdPool, 1, &cache->cmd);
 	vkDestroyFence		(dev->vkDev,cache->uploadFence,NULL);
 #ifdef VKVG_USE_FREETYPE
@@ -285,7 +293,8 @@ void _font_cache_update_context_descset (VkvgContext ctx) {
 	ctx->fontCacheImg = ctx->dev->fontCache->texture;
 	vkh_image_reference (ctx->fontCacheImg);
 
-	_update_descriptor_set (ctx, ctx->fontCacheImg, ctx->dsFont);
+	if (ctx->dsFont)//else written on descriptor sets allocation
+		_update_descriptor_set (ctx, ctx->fontCacheImg, ctx->dsFont);
 
 	UNLOCK_FONTCACHE (ctx->dev)
 }
@@ -681,21 +690,13 @@ void _font_cache_destroy_text_run (VkvgText textRun) {
 }
 #ifdef DEBUG
 void _show_texture (vkvg_context* ctx){
-	Vertex vs[] = {
-		{{0,0},							  0,  {0,0,0}},
-		{{0,FONT_PAGE_SIZE},			  0,  {0,1,0}},
-		{{FONT_PAGE_SIZE,0},			  0,  {1,0,0}},
-		{{FONT_PAGE_SIZE,FONT_PAGE_SIZE}, 0,  {1,1,0}}
-	};
-
-	VKVG_IBO_INDEX_TYPE firstIdx = (VKVG_IBO_INDEX_TYPE)(ctx->vertCount - ctx->curVertOffset);
-	Vertex* pVert = &ctx->vertexCache[ctx->vertCount];
-	memcpy (pVert,vs,4*sizeof(Vertex));
-	ctx->vertCount+=4;
+	GlyphInstance g = {{0,0}, 0, {FONT_PAGE_SIZE,FONT_PAGE_SIZE}, {0,0}, 0};
 
-	_check_vertex_cache_size(ctx);
+	_emit_draw_cmd_undrawn_vertices (ctx);
+	ctx->curVertOffset = ctx->vertCount;
 
-	_add_tri_indices_for_rect(ctx, firstIdx);
+	_add_glyph_instance (ctx, g);
+	_emit_draw_cmd_undrawn_glyphs (ctx);
 }
 #endif
 void _font_cache_show_text_run (VkvgContext ctx, VkvgText tr) {
@@ -707,12 +708,16 @@ void _font_cache_show_text_run (VkvgContext ctx, VkvgText tr) {
 	glyph_count = tr->glyph_count;
 #endif
 
-	Vertex v = {{0},ctx->curColor,{0,0,-1}};
+	GlyphInstance g = {{0},ctx->curColor};
 	vec2 pen = {0,0};
 
 	if (!_current_path_is_empty(ctx))
 		pen = _get_current_position(ctx);
 
+	//glyphs are drawn from the first glyph slot, previous geometry has to be drawn first.
+	_emit_draw_cmd_undrawn_vertices (ctx);
+	ctx->curVertOffset = ctx->vertCount;
+
 	LOCK_FONTCACHE (ctx->dev)
 
 	for (uint32_t i=0; i < glyph_count; ++i) {
@@ -723,35 +728,14 @@ void _font_cache_show_text_run (VkvgContext ctx, VkvgText tr) {
 			cr = _prepare_char(tr->dev, tr, glyph_info[i].codepoint);
 #endif
 
-		float uvWidth	= cr->bounds.width  / (float)FONT_PAGE_SIZE;
-		float uvHeight	= cr->bounds.height / (float)FONT_PAGE_SIZE;
-		vec2 p0 = {pen.x + cr->bmpDiff.x + (tr->glyphs[i].x_offset >> 6),
-				   pen.y - cr->bmpDiff.y + (tr->glyphs[i].y_offset >> 6)};
-		v.pos = p0;
-
-		VKVG_IBO_INDEX_TYPE firstIdx = (VKVG_IBO_INDEX_TYPE)(ctx->vertCount - ctx->curVertOffset);
-
-
-		v.uv.x = cr->bounds.x;
-		v.uv.y = cr->bounds.y;
-		v.uv.z = cr->pageIdx;
-		_add_vertex(ctx,v);
-
-		v.pos.y += cr->bounds.height;
-		v.uv.y += uvHeight;
-		_add_vertex(ctx,v);
-
-		v.pos.x += cr->bounds.width;
-		v.pos.y = p0.y;
-		v.uv.x += uvWidth;
-		v.uv.y = cr->bounds.y;
-		_add_vertex(ctx,v);
-
-		v.pos.y += cr->bounds.height;
-		v.uv.y += uvHeight;
-		_add_vertex(ctx,v);
-
-		_add_tri_indices_for_rect (ctx, firstIdx);
+		g.pos.x		= pen.x + cr->bmpDiff.x + (tr->glyphs[i].x_offset >> 6);
+		g.pos.y		= pen.y - cr->bmpDiff.y + (tr->glyphs[i].y_offset >> 6);
+		g.size.x	= (int16_t)cr->bounds.width;
+		g.size.y	= (int16_t)cr->bounds.height;
+		g.texel.x	= (int16_t)(cr->bounds.x * FONT_PAGE_SIZE);
+		g.texel.y	= (int16_t)(cr->bounds.y * FONT_PAGE_SIZE);
+		g.page		= cr->pageIdx;
+		_add_glyph_instance (ctx, g);
 
 		pen.x += (tr->glyphs[i].x_advance >> 6);
 		pen.y -= (tr->glyphs[i].y_advance >> 6);
@@ -764,9 +748,14 @@ void _font_cache_show_text_run (VkvgContext ctx, VkvgText tr) {
 	UNLOCK_FONTCACHE (ctx->dev)
 
 	if (ctx->fontCacheImg != ctx->dev->fontCache->texture) {
-		vkvg_flush (ctx);
+		//submit draws already emitted with the previous texture, glyphs of this run are kept for the new one.
+		if (ctx->cmdStarted)
+			_flush_cmd_until_vx_base (ctx);
+		_wait_flush_fence (ctx);
 		_font_cache_update_context_descset (ctx);
 	}
+
+	_emit_draw_cmd_undrawn_glyphs (ctx);
 }
 
 void _font_cache_show_text (VkvgContext ctx, const char* text){
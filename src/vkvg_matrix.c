@@ -60,6 +60,17 @@
 
 #include "vkvg_matrix.h"
 
+#if defined(__AVX__)
+#include <immintrin.h>
+#define VKVG_SIMD_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VKVG_SIMD_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define VKVG_SIMD_NEON
+#endif
+
 #define ISFINITE(x) ((x) * (x) >= 0.) /* check for NaNs */
 
 //matrix computations mainly taken from http://cairographics.org
@@ -265,3 +276,177 @@ void vkvg_matrix_get_scale (const vkvg_matrix_t *matrix, float *sx, float *sy) {
 	/*if (matrix->yy < 0)
 		*sy = -*sy;*/
 }
+void vkvg_matrix_transform_points (const vkvg_matrix_t *matrix, float *points, uint32_t count) {
+	_matrix_transform_points (matrix, (const vec2*)points, (vec2*)points, count);
+}
+
+//x and y are interleaved in simd registers, matrix columns are repeated to transform several points at once
+//from broadcasted x and y.
+void _matrix_transform_points (const vkvg_matrix_t* m, const vec2* src, vec2* dst, uint32_t count) {
+	uint32_t i = 0;
+#if defined(VKVG_SIMD_AVX)
+	__m256 c0 = _mm256_setr_ps (m->xx, m->yx, m->xx, m->yx, m->xx, m->yx, m->xx, m->yx);
+	__m256 c1 = _mm256_setr_ps (m->xy, m->yy, m->xy, m->yy, m->xy, m->yy, m->xy, m->yy);
+	__m256 t  = _mm256_setr_ps (m->x0, m->y0, m->x0, m->y0, m->x0, m->y0, m->x0, m->y0);
+	for (; i + 4 <= count; i += 4) {
+		__m256 p = _mm256_loadu_ps (&src[i].x);
+		__m256 r = _mm256_add_ps (_mm256_add_ps (_mm256_mul_ps (_mm256_moveldup_ps (p), c0),
+												 _mm256_mul_ps (_mm256_movehdup_ps (p), c1)), t);
+		_mm256_storeu_ps (&dst[i].x, r);
+	}
+#elif defined(VKVG_SIMD_SSE2)
+	__m128 c0 = _mm_setr_ps (m->xx, m->yx, m->xx, m->yx);
+	__m128 c1 = _mm_setr_ps (m->xy, m->yy, m->xy, m->yy);
+	__m128 t  = _mm_setr_ps (m->x0, m->y0, m->x0, m->y0);
+	for (; i + 2 <= count; i += 2) {
+		__m128 p = _mm_loadu_ps (&src[i].x);
+		__m128 r = _mm_add_ps (_mm_add_ps (_mm_mul_ps (_mm_shuffle_ps (p, p, _MM_SHUFFLE(2,2,0,0)), c0),
+										   _mm_mul_ps (_mm_shuffle_ps (p, p, _MM_SHUFFLE(3,3,1,1)), c1)), t);
+		_mm_storeu_ps (&dst[i].x, r);
+	}
+#elif defined(VKVG_SIMD_NEON)
+	for (; i + 4 <= count; i += 4) {
+		float32x4x2_t p = vld2q_f32 (&src[i].x);//deinterleaved x and y
+		float32x4x2_t r;
+		r.val[0] = vmlaq_n_f32 (vmlaq_n_f32 (vdupq_n_f32 (m->x0), p.val[0], m->xx), p.val[1], m->xy);
+		r.val[1] = vmlaq_n_f32 (vmlaq_n_f32 (vdupq_n_f32 (m->y0), p.val[0], m->yx), p.val[1], m->yy);
+		vst2q_f32 (&dst[i].x, r);
+	}
+#endif
+	for (; i < count; i++) {
+		vec2 p = src[i];
+		dst[i].x = m->xx * p.x + m->xy * p.y + m->x0;
+		dst[i].y = m->yx * p.x + m->yy * p.y + m->y0;
+	}
+}
+void _matrix_points_bounds (const vkvg_matrix_t* m, const vec2* pts, uint32_t count, vec4* bounds) {
+	vkvg_matrix_t id = VKVG_IDENTITY_MATRIX;
+	if (!m)
+		m = &id;
+	uint32_t i = 0;
+	float xMin = bounds->xMin, yMin = bounds->yMin, xMax = bounds->xMax, yMax = bounds->yMax;
+#if defined(VKVG_SIMD_AVX)
+	if (count >= 4) {
+		__m256 c0 = _mm256_setr_ps (m->xx, m->yx, m->xx, m->yx, m->xx, m->yx, m->xx, m->yx);
+		__m256 c1 = _mm256_setr_ps (m->xy, m->yy, m->xy, m->yy, m->xy, m->yy, m->xy, m->yy);
+		__m256 t  = _mm256_setr_ps (m->x0, m->y0, m->x0, m->y0, m->x0, m->y0, m->x0, m->y0);
+		__m256 vMin = _mm256_setr_ps (xMin, yMin, xMin, yMin, xMin, yMin, xMin, yMin);
+		__m256 vMax = _mm256_setr_ps (xMax, yMax, xMax, yMax, xMax, yMax, xMax, yMax);
+		for (; i + 4 <= count; i += 4) {
+			__m256 p = _mm256_loadu_ps (&pts[i].x);
+			__m256 r = _mm256_add_ps (_mm256_add_ps (_mm256_mul_ps (_mm256_moveldup_ps (p), c0),
+													 _mm256_mul_ps (_mm256_movehdup_ps (p), c1)), t);
+			vMin = _mm256_min_ps (vMin, r);
+			vMax = _mm256_max_ps (vMax, r);
+		}
+		float mins[8], maxs[8];
+		_mm256_storeu_ps (mins, vMin);
+		_mm256_storeu_ps (maxs, vMax);
+		for (int j = 0; j < 8; j += 2) {
+			xMin = fminf (xMin, mins[j]);
+			yMin = fminf (yMin, mins[j+1]);
+			xMax = fmaxf (xMax, maxs[j]);
+			yMax = fmaxf (yMax, maxs[j+1]);
+		}
+	}
+#elif defined(VKVG_SIMD_SSE2)
+	if (count >= 2) {
+		__m128 c0 = _mm_setr_ps (m->xx, m->yx, m->xx, m->yx);
+		__m128 c1 = _mm_setr_ps (m->xy, m->yy, m->xy, m->yy);
+		__m128 t  = _mm_setr_ps (m->x0, m->y0, m->x0, m->y0);
+		__m128 vMin = _mm_setr_ps (xMin, yMin, xMin, yMin);
+		__m128 vMax = _mm_setr_ps (xMax, yMax, xMax, yMax);
+		for (; i + 2 <= count; i += 2) {
+			__m128 p = _mm_loadu_ps (&pts[i].x);
+			__m128 r = _mm_add_ps (_mm_add_ps (_mm_mul_ps (_mm_shuffle_ps (p, p, _MM_SHUFFLE(2,2,0,0)), c0),
+											   _mm_mul_ps (_mm_shuffle_ps (p, p, _MM_SHUFFLE(3,3,1,1)), c1)), t);
+			vMin = _mm_min_ps (vMin, r);
+			vMax = _mm_max_ps (vMax, r);
+		}
+		float mins[4], maxs[4];
+		_mm_storeu_ps (mins, vMin);
+		_mm_storeu_ps (maxs, vMax);
+		xMin = fminf (mins[0], mins[2]);
+		yMin = fminf (mins[1], mins[3]);
+		xMax = fmaxf (maxs[0], maxs[2]);
+		yMax = fmaxf (maxs[1], maxs[3]);
+	}
+#elif defined(VKVG_SIMD_NEON)
+	if (count >= 4) {
+		float32x4_t xMinV = vdupq_n_f32 (xMin), yMinV = vdupq_n_f32 (yMin);
+		float32x4_t xMaxV = vdupq_n_f32 (xMax), yMaxV = vdupq_n_f32 (yMax);
+		for (; i + 4 <= count; i += 4) {
+			float32x4x2_t p = vld2q_f32 (&pts[i].x);
+			float32x4_t x = vmlaq_n_f32 (vmlaq_n_f32 (vdupq_n_f32 (m->x0), p.val[0], m->xx), p.val[1], m->xy);
+			float32x4_t y = vmlaq_n_f32 (vmlaq_n_f32 (vdupq_n_f32 (m->y0), p.val[0], m->yx), p.val[1], m->yy);
+			xMinV = vminq_f32 (xMinV, x);
+			yMinV = vminq_f32 (yMinV, y);
+			xMaxV = vmaxq_f32 (xMaxV, x);
+			yMaxV = vmaxq_f32 (yMaxV, y);
+		}
+		float r[4][4];
+		vst1q_f32 (r[0], xMinV);
+		vst1q_f32 (r[1], yMinV);
+		vst1q_f32 (r[2], xMaxV);
+		vst1q_f32 (r[3], yMaxV);
+		for (int j = 0; j < 4; j++) {
+			xMin = fminf (xMin, r[0][j]);
+			yMin = fminf (yMin, r[1][j]);
+			xMax = fmaxf (xMax, r[2][j]);
+			yMax = fmaxf (yMax, r[3][j]);
+		}
+	}
+#endif
+	for (; i < count; i++) {
+		vec2 p = pts[i];
+		float x = m->xx * p.x + m->xy * p.y + m->x0;
+		float y = m->yx * p.x + m->yy * p.y + m->y0;
+		xMin = fminf (xMin, x);
+		yMin = fminf (yMin, y);
+		xMax = fmaxf (xMax, x);
+		yMax = fmaxf (yMax, y);
+	}
+	bounds->xMin = xMin;
+	bounds->yMin = yMin;
+	bounds->xMax = xMax;
+	bounds->yMax = yMax;
+}
+//x and y are deinterleaved to compute four edges at once, edges of null length give non finite directions.
+void _points_edges (const vec2* pts, uint32_t count, vec2* dirs, float* lengths) {
+	uint32_t i = 0;
+	if (count < 2)
+		return;
+	count--;//edge count
+#if defined(VKVG_SIMD_AVX) || defined(VKVG_SIMD_SSE2)
+	for (; i + 4 <= count; i += 4) {
+		__m128 a0 = _mm_loadu_ps (&pts[i].x),   a1 = _mm_loadu_ps (&pts[i+2].x);
+		__m128 b0 = _mm_loadu_ps (&pts[i+1].x), b1 = _mm_loadu_ps (&pts[i+3].x);
+		__m128 dx = _mm_sub_ps (_mm_shuffle_ps (b0, b1, _MM_SHUFFLE(2,0,2,0)), _mm_shuffle_ps (a0, a1, _MM_SHUFFLE(2,0,2,0)));
+		__m128 dy = _mm_sub_ps (_mm_shuffle_ps (b0, b1, _MM_SHUFFLE(3,1,3,1)), _mm_shuffle_ps (a0, a1, _MM_SHUFFLE(3,1,3,1)));
+		__m128 l = _mm_sqrt_ps (_mm_add_ps (_mm_mul_ps (dx, dx), _mm_mul_ps (dy, dy)));
+		_mm_storeu_ps (&lengths[i], l);
+		dx = _mm_div_ps (dx, l);
+		dy = _mm_div_ps (dy, l);
+		_mm_storeu_ps (&dirs[i].x,   _mm_unpacklo_ps (dx, dy));
+		_mm_storeu_ps (&dirs[i+2].x, _mm_unpackhi_ps (dx, dy));
+	}
+#elif defined(VKVG_SIMD_NEON) && defined(__aarch64__)
+	for (; i + 4 <= count; i += 4) {
+		float32x4x2_t a = vld2q_f32 (&pts[i].x);
+		float32x4x2_t b = vld2q_f32 (&pts[i+1].x);
+		float32x4_t dx = vsubq_f32 (b.val[0], a.val[0]);
+		float32x4_t dy = vsubq_f32 (b.val[1], a.val[1]);
+		float32x4_t l = vsqrtq_f32 (vmlaq_f32 (vmulq_f32 (dx, dx), dy, dy));
+		vst1q_f32 (&lengths[i], l);
+		float32x4x2_t d = {{vdivq_f32 (dx, l), vdivq_f32 (dy, l)}};
+		vst2q_f32 (&dirs[i].x, d);
+	}
+#endif
+	for (; i < count; i++) {
+		float dx = pts[i+1].x - pts[i].x;
+		float dy = pts[i+1].y - pts[i].y;
+		float l = sqrtf (dx * dx + dy * dy);
+		lengths[i] = l;
+		dirs[i] = (vec2){dx / l, dy / l};
+	}
+}
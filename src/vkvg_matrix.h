@@ -26,8 +26,14 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "vkvg.h"
+#include "vectors.h"
 
-
-
+//batch kernels vectorized with AVX, SSE2 or NEON when available, scalar otherwise.
+//transform count points from src to dst, src and dst may be the same array.
+void _matrix_transform_points	(const vkvg_matrix_t* matrix, const vec2* src, vec2* dst, uint32_t count);
+//extend bounds (xMin, yMin, xMax, yMax) with points transformed by matrix, or untransformed if matrix is NULL.
+void _matrix_points_bounds		(const vkvg_matrix_t* matrix, const vec2* pts, uint32_t count, vec4* bounds);
+//unit directions and lengths of the count - 1 edges joining successive points.
+void _points_edges				(const vec2* pts, uint32_t count, vec2* dirs, float* lengths);
 
 #endif
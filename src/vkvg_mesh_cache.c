@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2018-2022 Jean-Philippe Bruyère <jp_bruyere@hotmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+ * Software, and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "vkvg_context_internal.h"
+#include "vkvg_device_internal.h"
+#include "vkvg_mesh_cache.h"
+
+#define FNV_OFFSET	0xcbf29ce484222325ULL
+#define FNV_PRIME	0x100000001b3ULL
+
+//FNV-1a applied on 32 bits words
+static uint64_t _hash_words (uint64_t h, const void* data, size_t count) {
+	const uint32_t* w = (const uint32_t*)data;
+	for (size_t i = 0; i < count; i++)
+		h = (h ^ w[i]) * FNV_PRIME;
+	return h;
+}
+static void _mesh_key (VkvgContext ctx, vkvg_mesh_kind_t kind, _mesh_key_t* key) {
+	*key = (_mesh_key_t) {kind, ctx->pointCount, ctx->pathPtr};
+	if (kind != vkvg_mesh_stroke)
+		return;
+	key->halfWidth	= ctx->lineWidth * 0.5f;
+	key->miterLimit	= ctx->miterLimit;
+	key->arcStep	= _get_arc_step (ctx, key->halfWidth);
+	key->join		= ctx->lineJoin;
+	key->cap		= ctx->lineCap;
+	key->dashCount	= ctx->dashCount;
+	if (ctx->dashCount > 0)
+		key->dashOffset = ctx->dashOffset;
+}
+static bool _mesh_matches (const _cached_mesh_t* m, VkvgContext ctx, const _mesh_key_t* key, uint64_t hash) {
+	return m->hash == hash &&
+		memcmp (&m->key, key, sizeof(_mesh_key_t)) == 0 &&
+		(key->dashCount == 0 || memcmp (m->dashes, ctx->dashes, key->dashCount * sizeof(float)) == 0) &&
+		memcmp (m->points, ctx->points, key->pointCount * sizeof(vec2)) == 0 &&
+		memcmp (m->pathes, ctx->pathes, key->pathesCount * sizeof(uint32_t)) == 0;
+}
+static _cached_mesh_t* _mesh_cache_find (_mesh_cache_t* cache, VkvgContext ctx, const _mesh_key_t* key, uint64_t hash) {
+	_cached_mesh_t* m = cache->buckets[hash & (VKVG_MESH_CACHE_BUCKETS - 1)];
+	while (m && !_mesh_matches (m, ctx, key, hash))
+		m = m->next;
+	return m;
+}
+static void _mesh_unlink (_mesh_cache_t* cache, _cached_mesh_t* m) {
+	if (m->newer)
+		m->newer->older = m->older;
+	else
+		cache->newest = m->older;
+	if (m->older)
+		m->older->newer = m->newer;
+	else
+		cache->oldest = m->newer;
+}
+static void _mesh_set_newest (_mesh_cache_t* cache, _cached_mesh_t* m) {
+	m->newer = NULL;
+	m->older = cache->newest;
+	if (cache->newest)
+		cache->newest->newer = m;
+	else
+		cache->oldest = m;
+	cache->newest = m;
+}
+static void _mesh_remove (_mesh_cache_t* cache, _cached_mesh_t* m) {
+	_cached_mesh_t** pm = &cache->buckets[m->hash & (VKVG_MESH_CACHE_BUCKETS - 1)];
+	while (*pm != m)
+		pm = &(*pm)->next;
+	*pm = m->next;
+	_mesh_unlink (cache, m);
+	cache->size -= m->size;
+	free (m);
+}
+//evict least recently used meshes until cache size is below maxSize, cache lock has to be held
+void _mesh_cache_trim (_mesh_cache_t* cache, size_t maxSize) {
+	while (cache->oldest && cache->size > maxSize)
+		_mesh_remove (cache, cache->oldest);
+}
+static bool _vertices_are_points (VkvgContext ctx, uint32_t firstVert, uint32_t vertCount) {
+	if (vertCount != ctx->pointCount)
+		return false;
+	for (uint32_t i = 0; i < vertCount; i++) {
+		if (!vec2_equ (ctx->vertexCache[firstVert + i].pos, ctx->points[i]))
+			return false;
+	}
+	return true;
+}
+bool _mesh_cache_draw (VkvgContext ctx, vkvg_mesh_kind_t kind, _mesh_key_t* key, uint64_t* hash) {
+	VkvgDevice dev = ctx->dev;
+	LOCK_MESHCACHE(dev)
+	bool enabled = dev->meshCache.maxSize > 0;
+	UNLOCK_MESHCACHE(dev)
+	if (!enabled) {
+		*key = (_mesh_key_t) {0};//null key is not stored
+		return false;
+	}
+
+	_mesh_key (ctx, kind, key);
+	uint64_t h = _hash_words (FNV_OFFSET, key, sizeof(_mesh_key_t) / sizeof(uint32_t));
+	if (key->dashCount > 0)
+		h = _hash_words (h, ctx->dashes, key->dashCount);
+	h = _hash_words (h, ctx->points, key->pointCount * 2);
+	h = _hash_words (h, ctx->pathes, key->pathesCount);
+	*hash = h;
+
+	LOCK_MESHCACHE(dev)
+	_cached_mesh_t* m = _mesh_cache_find (&dev->meshCache, ctx, key, h);
+	uint32_t vertCount = m && m->vertices ? m->vertCount : key->pointCount;
+	if (m && ctx->vertCount - ctx->curVertOffset + vertCount > VKVG_IBO_MAX) {
+		//buffers may be resized while drawing, which could trigger the memory evict callback that has to be called
+		//without lock held. Mesh could be evicted meanwhile.
+		UNLOCK_MESHCACHE(dev)
+		_emit_draw_cmd_undrawn_vertices (ctx);
+		LOCK_MESHCACHE(dev)
+		m = _mesh_cache_find (&dev->meshCache, ctx, key, h);
+	}
+	if (!m) {
+		UNLOCK_MESHCACHE(dev)
+		return false;
+	}
+	_mesh_unlink (&dev->meshCache, m);
+	_mesh_set_newest (&dev->meshCache, m);
+
+	LOG(VKVG_LOG_INFO, "MESH CACHE: hit ctx = %p; vertices = %d; indices = %d\n", ctx, vertCount, m->indCount);
+
+	_ensure_vertex_cache_size (ctx, vertCount);
+	_ensure_index_cache_size (ctx, m->indCount);
+
+	VKVG_IBO_INDEX_TYPE firstVertIdx = (VKVG_IBO_INDEX_TYPE)(ctx->vertCount - ctx->curVertOffset);
+	const vec2* pos = m->vertices ? m->vertices : ctx->points;
+	Vertex v = {{0}, ctx->curColor};
+	for (uint32_t i = 0; i < vertCount; i++) {
+		v.pos = pos[i];
+		_set_vertex (ctx, ctx->vertCount++, v);
+	}
+	for (uint32_t i = 0; i < m->indCount; i++)
+		ctx->indexCache[ctx->indCount++] = firstVertIdx + (VKVG_IBO_INDEX_TYPE)m->indices[i];
+
+	UNLOCK_MESHCACHE(dev)
+	return true;
+}
+void _mesh_cache_store (VkvgContext ctx, const _mesh_key_t* key, uint64_t hash, uint32_t firstVert, uint32_t firstInd) {
+	VkvgDevice dev = ctx->dev;
+	if (ctx->status || key->pointCount == 0)
+		return;
+
+	//vertices of fills are the path points, unless the tessellator added or skipped some
+	uint32_t vertCount = ctx->vertCount - firstVert;
+	if (key->kind != vkvg_mesh_stroke && _vertices_are_points (ctx, firstVert, vertCount))
+		vertCount = 0;
+	uint32_t indCount = ctx->indCount - firstInd;
+	size_t size = sizeof(_cached_mesh_t) + (key->pointCount + vertCount) * sizeof(vec2) +
+			key->dashCount * sizeof(float) + (key->pathesCount + indCount) * sizeof(uint32_t);
+	LOCK_MESHCACHE(dev)
+	size_t maxSize = dev->meshCache.maxSize;
+	UNLOCK_MESHCACHE(dev)
+	//a single mesh may not take more than a quarter of the cache
+	if (size > maxSize / 4)
+		return;
+
+	_cached_mesh_t* m = (_cached_mesh_t*)malloc (size);
+	if (!m)
+		return;
+	char* data = (char*)(m + 1);
+	m->hash		= hash;
+	m->size		= size;
+	m->key		= *key;
+	m->points	= (vec2*)data;
+	data += key->pointCount * sizeof(vec2);
+	m->vertices	= vertCount > 0 ? (vec2*)data : NULL;
+	data += vertCount * sizeof(vec2);
+	m->dashes	= (float*)data;
+	data += key->dashCount * sizeof(float);
+	m->pathes	= (uint32_t*)data;
+	data += key->pathesCount * sizeof(uint32_t);
+	m->indices	= (uint32_t*)data;
+	m->vertCount= vertCount;
+	m->indCount	= indCount;
+
+	memcpy (m->points, ctx->points, key->pointCount * sizeof(vec2));
+	if (key->dashCount > 0)
+		memcpy (m->dashes, ctx->dashes, key->dashCount * sizeof(float));
+	memcpy (m->pathes, ctx->pathes, key->pathesCount * sizeof(uint32_t));
+	for (uint32_t i = 0; i < vertCount; i++)
+		m->vertices[i] = ctx->vertexCache[firstVert + i].pos;
+	uint32_t firstVertIdx = firstVert - ctx->curVertOffset;
+	for (uint32_t i = 0; i < indCount; i++)
+		m->indices[i] = (uint32_t)ctx->indexCache[firstInd + i] - firstVertIdx;
+
+	LOCK_MESHCACHE(dev)
+	_mesh_cache_t* cache = &dev->meshCache;
+	if (_mesh_cache_find (cache, ctx, key, hash)) {
+		//stored meanwhile by a context of another thread
+		UNLOCK_MESHCACHE(dev)
+		free (m);
+		return;
+	}
+	_cached_mesh_t** bucket = &cache->buckets[hash & (VKVG_MESH_CACHE_BUCKETS - 1)];
+	m->next = *bucket;
+	*bucket = m;
+	_mesh_set_newest (cache, m);
+	cache->size += size;
+	_mesh_cache_trim (cache, cache->maxSize);
+	UNLOCK_MESHCACHE(dev)
+}
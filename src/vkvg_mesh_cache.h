@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2018-2022 Jean-Philippe Bruyère <jp_bruyere@hotmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+ * Software, and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef VKVG_MESH_CACHE_H
+#define VKVG_MESH_CACHE_H
+
+#include "vkvg_internal.h"
+#include "vectors.h"
+
+#define VKVG_MESH_CACHE_BUCKETS		256	//hash table size, power of two
+
+typedef enum {
+	vkvg_mesh_fill_even_odd,
+	vkvg_mesh_fill_non_zero,
+	vkvg_mesh_stroke,
+} vkvg_mesh_kind_t;
+
+//tessellation parameters, the cache key is made of them followed by the dashes, the points and the path elements.
+//Only 32 bits fields, so that the key is hashed by words without padding.
+typedef struct {
+	uint32_t			kind;
+	uint32_t			pointCount;
+	uint32_t			pathesCount;
+	uint32_t			dashCount;
+	float				halfWidth;
+	float				miterLimit;
+	float				arcStep;		//step of round joins, caps and curves, depends on matrix scale and tolerance
+	float				dashOffset;
+	uint32_t			join;
+	uint32_t			cap;
+} _mesh_key_t;
+
+//triangles of a filled or stroked path, allocated in a single block with its key arrays.
+typedef struct _cached_mesh_t {
+	struct _cached_mesh_t*	next;			//next mesh of the hash bucket
+	struct _cached_mesh_t*	newer;			//more recently used mesh
+	struct _cached_mesh_t*	older;			//less recently used mesh
+	uint64_t			hash;
+	size_t				size;			//allocated bytes
+	_mesh_key_t			key;
+	float*				dashes;
+	vec2*				points;
+	uint32_t*			pathes;
+	vec2*				vertices;		//NULL if vertices are the key points
+	uint32_t			vertCount;
+	uint32_t*			indices;		//triangle indices relative to the first vertex
+	uint32_t			indCount;
+} _cached_mesh_t;
+
+//device cache of tessellated pathes, shared by all its contexts. Vertices are transformed by the push constants
+//matrix, so a mesh is reused under any matrix as long as its tessellation parameters are the same.
+typedef struct {
+	_cached_mesh_t*		buckets[VKVG_MESH_CACHE_BUCKETS];
+	_cached_mesh_t*		newest;
+	_cached_mesh_t*		oldest;			//evicted first when cache is full
+	size_t				size;			//bytes used by cached meshes
+	size_t				maxSize;		//0 if cache is disabled
+	mtx_t				mutex;			//used only if device is in thread aware mode (see: vkvg_device_set_thread_aware)
+} _mesh_cache_t;
+
+#define LOCK_MESHCACHE(dev) \
+	if (dev->threadAware)\
+		mtx_lock (&dev->meshCache.mutex);
+#define UNLOCK_MESHCACHE(dev) \
+	if (dev->threadAware)\
+		mtx_unlock (&dev->meshCache.mutex);
+
+void _mesh_cache_trim	(_mesh_cache_t* cache, size_t maxSize);
+//search the device cache for the mesh of the current path and add its triangles to the context caches.
+//On cache miss, false is returned with key and hash set for _mesh_cache_store, the key is null if cache is disabled.
+bool _mesh_cache_draw	(VkvgContext ctx, vkvg_mesh_kind_t kind, _mesh_key_t* key, uint64_t* hash);
+//store the triangles added to the context caches since firstVert and firstInd, they have to be in the undrawn batch.
+void _mesh_cache_store	(VkvgContext ctx, const _mesh_key_t* key, uint64_t hash, uint32_t firstVert, uint32_t firstInd);
+
+#endif
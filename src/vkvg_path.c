@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2018-2022 Jean-Philippe Bruyère <jp_bruyere@hotmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+ * Software, and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "vkvg_device_internal.h"
+#include "vkvg_context_internal.h"
+#include "vkvg_path.h"
+
+VkvgPath vkvg_copy_path (VkvgContext ctx) {
+	VkvgPath path = (vkvg_path_t*)calloc(1, sizeof(vkvg_path_t));
+	if (!path)
+		return (VkvgPath)&_no_mem_status;
+	path->references = 1;
+	if (ctx->status) {
+		path->status = ctx->status;
+		return path;
+	}
+	path->threadAware = ctx->dev->threadAware;
+	if (path->threadAware)
+		mtx_init (&path->mutex, mtx_plain);
+
+	LOG(VKVG_LOG_INFO_CMD, "\tCMD: copy_path:\n");
+
+	//the current subpath is finished in the copy only, so that it may still be extended in the context.
+	uint32_t curPath = ctx->pathes[ctx->pathPtr];
+	uint32_t curPathes = 0;//path elements of the current subpath kept in the copy
+	path->pointCount = ctx->pointCount;
+	path->subpathCount = ctx->subpathCount;
+	path->windingBound = ctx->windingBound;
+	if ((curPath & PATH_ELT_MASK) < 2)
+		path->pointCount -= curPath & PATH_ELT_MASK;
+	else {
+		if ((ctx->pathPtr == 0 && ctx->simpleConvex) || _path_is_convex (ctx))
+			curPath |= PATH_IS_CONVEX_BIT;
+		path->windingBound += _path_winding_bound (ctx);
+		if (ctx->segmentPtr > 0) {
+			curPath |= PATH_HAS_CURVES_BIT;
+			curPathes = ctx->segmentPtr;
+			uint32_t lastSegment = ctx->pathes[ctx->pathPtr + ctx->segmentPtr];
+			//if last segment is not a curve and point count > 0
+			if ((lastSegment & PATH_HAS_CURVES_BIT) == 0 && (lastSegment & PATH_ELT_MASK) > 0)
+				curPathes++;
+		} else
+			curPathes = 1;
+		path->subpathCount++;
+	}
+	path->pathesCount = ctx->pathPtr + curPathes;
+
+	if (path->pointCount > 0) {
+		path->points = (vec2*)malloc (path->pointCount * sizeof(vec2));
+		path->pathes = (uint32_t*)malloc (path->pathesCount * sizeof(uint32_t));
+		if (!path->points || !path->pathes) {
+			path->status = VKVG_STATUS_NO_MEMORY;
+			return path;
+		}
+		memcpy (path->points, ctx->points, path->pointCount * sizeof(vec2));
+		memcpy (path->pathes, ctx->pathes, path->pathesCount * sizeof(uint32_t));
+		if (curPathes > 0)
+			path->pathes[ctx->pathPtr] = curPath;
+	}
+
+	if (ctx->sdfShape.pointCount == path->pointCount && path->subpathCount == 1)
+		path->sdfShape = ctx->sdfShape;
+
+	return path;
+}
+void vkvg_append_path (VkvgContext ctx, VkvgPath path) {
+	if (ctx->status || path->status)
+		return;
+
+	RECORD(ctx, VKVG_CMD_APPEND_PATH, path);
+	LOG(VKVG_LOG_INFO_CMD, "\tCMD: append_path: points count=%d\n", path->pointCount);
+
+	_finish_path (ctx);
+	if (ctx->status || path->pointCount == 0)
+		return;
+	if (_ensure_point_array (ctx, path->pointCount) || _ensure_pathes_array (ctx, path->pathesCount))
+		return;
+
+	bool wasEmpty = ctx->pointCount == 0;
+
+	memcpy (&ctx->points[ctx->pointCount], path->points, path->pointCount * sizeof(vec2));
+	memcpy (&ctx->pathes[ctx->pathPtr], path->pathes, path->pathesCount * sizeof(uint32_t));
+	ctx->pointCount += path->pointCount;
+	ctx->pathPtr += path->pathesCount;
+	ctx->pathes[ctx->pathPtr] = 0;
+	ctx->subpathCount += path->subpathCount;
+	ctx->windingBound += path->windingBound;
+	ctx->simpleConvex = false;
+	//a shape alone in the path stays drawable with sdf, otherwise the shape point count no longer matches
+	if (wasEmpty)
+		ctx->sdfShape = path->sdfShape;
+}
+vkvg_status_t vkvg_path_status (VkvgPath path) {
+	return path->status;
+}
+VkvgPath vkvg_path_reference (VkvgPath path) {
+	if (!path->status) {
+		LOCK_PATH(path)
+		path->references++;
+		UNLOCK_PATH(path)
+	}
+	return path;
+}
+uint32_t vkvg_path_get_reference_count (VkvgPath path) {
+	if (path->status)
+		return 0;
+	return path->references;
+}
+void vkvg_path_destroy (VkvgPath path) {
+	if (path == (VkvgPath)&_no_mem_status)
+		return;
+	if (!path->status) {
+		LOCK_PATH(path)
+		path->references--;
+		if (path->references > 0) {
+			UNLOCK_PATH(path)
+			return;
+		}
+		UNLOCK_PATH(path)
+	}
+	if (path->threadAware)
+		mtx_destroy (&path->mutex);
+	free (path->points);
+	free (path->pathes);
+	free (path);
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2018-2022 Jean-Philippe Bruyère <jp_bruyere@hotmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+ * Software, and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef VKVG_PATH_H
+#define VKVG_PATH_H
+
+#include "vkvg_context_internal.h"
+
+//flattened path captured from a context, never modified once created.
+typedef struct _vkvg_path_t {
+	vkvg_status_t		status;
+	uint32_t			references;
+	vec2*				points;			//points of all subpathes
+	uint32_t			pointCount;
+	uint32_t*			pathes;			//finished subpathes and their segments, as in the context pathes array
+	uint32_t			pathesCount;
+	uint32_t			subpathCount;
+	uint32_t			windingBound;	//sum of the subpathes winding bounds, see _path_winding_bound
+	_sdf_shape_t		sdfShape;		//rounded shape making the whole path, pointCount is 0 if none
+	bool				threadAware;	//device of the source context was thread aware, references are locked
+	mtx_t				mutex;
+}vkvg_path_t;
+
+#define LOCK_PATH(path) \
+	if (path->threadAware)\
+		mtx_lock (&path->mutex);
+#define UNLOCK_PATH(path) \
+	if (path->threadAware)\
+		mtx_unlock (&path->mutex);
+
+#endif
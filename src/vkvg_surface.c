@@ -44,6 +44,8 @@ VkvgSurface vkvg_surface_create (VkvgDevice dev, uint32_t width, uint32_t height
 	surf->height = MAX(1, height);
 	surf->new = true;//used to clear all attacments on first render pass
 
+	if (!_surface_reserve_memory (surf, true))
+		return _surface_no_memory (surf);
 	_create_surface_images (surf);
 
 	surf->status = VKVG_STATUS_SUCCESS;
@@ -64,6 +66,9 @@ VkvgSurface vkvg_surface_create_for_VkhImage (VkvgDevice dev, void* vkhImg) {
 	surf->width = img->infos.extent.width;
 	surf->height= img->infos.extent.height;
 
+	if (!_surface_reserve_memory (surf, false))
+		return _surface_no_memory (surf);
+
 	surf->img = img;
 
 	vkh_image_create_sampler(img, VK_FILTER_NEAREST, VK_FILTER_NEAREST,
@@ -90,9 +95,13 @@ VkvgSurface vkvg_surface_create_from_bitmap (VkvgDevice dev, unsigned char* img,
 	surf->width = MAX(1, width);
 	surf->height = MAX(1, height);
 
+	if (!_surface_reserve_memory (surf, true))
+		return _surface_no_memory (surf);
 	_create_surface_images (surf);
 
 	uint32_t imgSize = width * height * 4;
+	//staging and blit images
+	_device_reserve_memory (dev, VKVG_MEMORY_STAGING, 2 * (uint64_t)imgSize);
 	VkImageSubresourceLayers imgSubResLayers = {VK_IMAGE_ASPECT_COLOR_BIT,0,0,1};
 	//original format image
 	VkhImage stagImg= vkh_image_create ((VkhDevice)surf->dev,VK_FORMAT_R8G8B8A8_UNORM,surf->width,surf->height,VK_IMAGE_TILING_LINEAR,
@@ -155,6 +164,7 @@ VkvgSurface vkvg_surface_create_from_bitmap (VkvgDevice dev, unsigned char* img,
 
 	vkvg_buffer_destroy (&buff);
 	vkh_image_destroy	(stagImg);
+	_device_release_memory (dev, VKVG_MEMORY_STAGING, (uint64_t)imgSize);
 
 	surf->new = false;
 
@@ -170,6 +180,7 @@ VkvgSurface vkvg_surface_create_from_bitmap (VkvgDevice dev, unsigned char* img,
 	ctx->pushConsts.fsq_patternType = (ctx->pushConsts.fsq_patternType & FULLSCREEN_BIT) + VKVG_PATTERN_TYPE_SURFACE;
 
 	//_update_push_constants (ctx);
+	_ensure_descriptor_sets (ctx);
 	_update_descriptor_set (ctx, tmpImg, ctx->dsSrc);
 	_ensure_renderpass_is_started  (ctx);
 
@@ -177,6 +188,7 @@ VkvgSurface vkvg_surface_create_from_bitmap (VkvgDevice dev, unsigned char* img,
 	vkvg_destroy		(ctx);
 
 	vkh_image_destroy	(tmpImg);
+	_device_release_memory (dev, VKVG_MEMORY_STAGING, (uint64_t)imgSize);
 
 	surf->status = VKVG_STATUS_SUCCESS;
 	vkvg_device_reference (surf->dev);
@@ -212,19 +224,12 @@ void vkvg_surface_destroy(VkvgSurface surf)
 	}
 	UNLOCK_SURFACE(surf)
 
-	vkDestroyFramebuffer(surf->dev->vkDev, surf->fb, NULL);
-
-	if (!surf->img->imported)
-		vkh_image_destroy(surf->img);
-
-	vkh_image_destroy(surf->imgMS);
-	vkh_image_destroy(surf->stencil);
+	VkvgDevice dev = surf->dev;
 
-	if (surf->dev->threadAware)
-		mtx_destroy (&surf->mutex);
+	if (!_device_defer_surface (surf))
+		_surface_free (surf);
 
-	vkvg_device_destroy (surf->dev);
-	free(surf);
+	vkvg_device_destroy (dev);
 }
 
 VkvgSurface vkvg_surface_reference (VkvgSurface surf) {
@@ -292,6 +297,9 @@ vkvg_status_t vkvg_surface_write_to_png (VkvgSurface surf, const char* path){
 	VkImageSubresourceLayers imgSubResLayers = {VK_IMAGE_ASPECT_COLOR_BIT,0,0,1};
 	VkvgDevice dev = surf->dev;
 
+	uint64_t stagSize = _device_image_size (dev->pngStagFormat, VK_SAMPLE_COUNT_1_BIT, surf->width, surf->height, 1);
+	_device_reserve_memory (dev, VKVG_MEMORY_STAGING, stagSize);
+
 	//RGBA to blit to, surf img is bgra
 	VkhImage stagImg;
 
@@ -370,6 +378,7 @@ vkvg_status_t vkvg_surface_write_to_png (VkvgSurface surf, const char* path){
 
 	vkh_image_unmap (stagImgLinear);
 	vkh_image_destroy (stagImgLinear);
+	_device_release_memory (dev, VKVG_MEMORY_STAGING, stagSize);
 
 	UNLOCK_SURFACE(surf)
 	return VKVG_STATUS_SUCCESS;
@@ -390,6 +399,9 @@ vkvg_status_t vkvg_surface_write_to_memory (VkvgSurface surf, unsigned char* con
 	VkImageSubresourceLayers imgSubResLayers = {VK_IMAGE_ASPECT_COLOR_BIT,0,0,1};
 	VkvgDevice dev = surf->dev;
 
+	uint64_t stagSize = _device_image_size (VK_FORMAT_B8G8R8A8_UNORM, VK_SAMPLE_COUNT_1_BIT, surf->width, surf->height, 1);
+	_device_reserve_memory (dev, VKVG_MEMORY_STAGING, stagSize);
+
 	//RGBA to blit to, surf img is bgra
 	VkhImage stagImg= vkh_image_create ((VkhDevice)surf->dev,VK_FORMAT_B8G8R8A8_UNORM ,surf->width,surf->height,VK_IMAGE_TILING_LINEAR,
 										 VMA_MEMORY_USAGE_GPU_TO_CPU,
@@ -433,6 +445,7 @@ vkvg_status_t vkvg_surface_write_to_memory (VkvgSurface surf, unsigned char* con
 
 	vkh_image_unmap (stagImg);
 	vkh_image_destroy (stagImg);
+	_device_release_memory (dev, VKVG_MEMORY_STAGING, stagSize);
 
 	UNLOCK_SURFACE(surf)
 
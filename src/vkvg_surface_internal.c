@@ -188,3 +188,56 @@ VkvgSurface _create_surface (VkvgDevice dev, VkFormat format) {
 		mtx_init (&surf->mutex, mtx_plain);
 	return surf;
 }
+//free a surface that could not get its images and return the shared out of memory surface, that is
+//not destroyed by vkvg_surface_destroy.
+VkvgSurface _surface_no_memory (VkvgSurface surf) {
+	if (surf->dev->threadAware)
+		mtx_destroy (&surf->mutex);
+	free (surf);
+	return (VkvgSurface)&_no_mem_status;
+}
+//multisampled color image if any and the stencil
+uint64_t _surface_attachments_size (VkvgSurface surf) {
+	VkvgDevice dev = surf->dev;
+	uint64_t size = _device_image_size (dev->stencilFormat, dev->samples, surf->width, surf->height, 1);
+	if (dev->samples > VK_SAMPLE_COUNT_1_BIT)
+		size += _device_image_size (surf->format, dev->samples, surf->width, surf->height, 1);
+	return size;
+}
+//account surface images in device memory usage, mainImage is false for imported images.
+//If budget is exceeded, nothing is accounted and false is returned.
+bool _surface_reserve_memory (VkvgSurface surf, bool mainImage) {
+	VkvgDevice dev = surf->dev;
+	uint64_t mainSize = mainImage ? _device_image_size (surf->format, VK_SAMPLE_COUNT_1_BIT, surf->width, surf->height, 1) : 0;
+	bool inBudget = _device_reserve_memory (dev, VKVG_MEMORY_SURFACES, mainSize);
+	inBudget &= _device_reserve_memory (dev, VKVG_MEMORY_ATTACHMENTS, _surface_attachments_size (surf));
+	if (!inBudget) {
+		_device_release_memory (dev, VKVG_MEMORY_SURFACES, mainSize);
+		_device_release_memory (dev, VKVG_MEMORY_ATTACHMENTS, _surface_attachments_size (surf));
+	}
+	return inBudget;
+}
+void _surface_release_memory (VkvgSurface surf) {
+	VkvgDevice dev = surf->dev;
+	if (!surf->img->imported)
+		_device_release_memory (dev, VKVG_MEMORY_SURFACES,
+								_device_image_size (surf->format, VK_SAMPLE_COUNT_1_BIT, surf->width, surf->height, 1));
+	_device_release_memory (dev, VKVG_MEMORY_ATTACHMENTS, _surface_attachments_size (surf));
+}
+//destroy surface ressources once no more referenced nor used by the gpu, device reference is handled by caller.
+void _surface_free (VkvgSurface surf) {
+	_surface_release_memory (surf);
+
+	vkDestroyFramebuffer(surf->dev->vkDev, surf->fb, NULL);
+
+	if (!surf->img->imported)
+		vkh_image_destroy(surf->img);
+
+	vkh_image_destroy(surf->imgMS);
+	vkh_image_destroy(surf->stencil);
+
+	if (surf->dev->threadAware)
+		mtx_destroy (&surf->mutex);
+
+	free(surf);
+}
@@ -55,4 +55,9 @@ void _create_surface_secondary_images (VkvgSurface surf);
 void _create_framebuffer (VkvgSurface surf);
 void _create_surface_images (VkvgSurface surf);
 VkvgSurface _create_surface (VkvgDevice dev, VkFormat format);
+VkvgSurface _surface_no_memory (VkvgSurface surf);
+uint64_t _surface_attachments_size (VkvgSurface surf);
+bool _surface_reserve_memory (VkvgSurface surf, bool mainImage);
+void _surface_release_memory (VkvgSurface surf);
+void _surface_free (VkvgSurface surf);
 #endif
@@ -0,0 +1,494 @@
+/*
+ * Copyright (c) 2018-2022 Jean-Philippe Bruyère <jp_bruyere@hotmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+ * Software, and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//Polygon triangulation in two steps, as described in "Computational Geometry: Algorithms and Applications"
+//(de Berg et al., chapter 3): a sweep line from top to bottom adds the diagonals splitting the polygon in y-monotone
+//pieces, then each piece is triangulated in linear time with a stack of the vertices not yet triangulated.
+//Coordinates are flipped vertically so that polygons are processed counter clockwise with the y axis going up.
+
+#include "vkvg_tessellator.h"
+
+#define TESS_NONE	UINT32_MAX
+
+enum {
+	TESS_VX_START,
+	TESS_VX_END,
+	TESS_VX_SPLIT,
+	TESS_VX_MERGE,
+	TESS_VX_REGULAR
+};
+
+typedef struct {
+	uint32_t	n;			//distinct points count
+	vec2*		pts;		//distinct points, y flipped and counter clockwise
+	uint32_t*	src;		//index of each point in the source array
+	uint32_t*	order;		//points sorted from top to bottom
+	uint32_t*	tmp;		//merge sort buffer, then neighbours insertion cursor
+	uint32_t*	types;		//vertex types, TESS_VX_xxx
+	uint32_t*	active;		//edges crossing the sweep line, edge i goes from point i to point i+1
+	uint32_t	activeCount;
+	uint32_t*	helpers;	//for each edge, lowest vertex above sweep line seeing the edge on its left
+	uint32_t*	diags;		//diagonals splitting the polygon in monotone pieces, pairs of points
+	uint32_t	diagCount;
+	uint32_t*	adjStart;	//first neighbour entry of each point
+	uint32_t*	adj;		//neighbour and outgoing half edge pairs, TESS_NONE half edge for the polygon exterior
+	uint8_t*	used;		//walked half edges, polygon edges first then diagonals in both directions
+	uint32_t*	face;		//monotone piece being triangulated, counter clockwise
+	uint32_t*	sorted;		//vertices of the monotone piece from top to bottom
+	uint8_t*	side;		//chain of sorted vertices, 0 for left, 1 for right
+	uint32_t*	stack;
+	uint32_t*	indices;
+	uint32_t	indCount;
+	uint32_t	maxIndCount;
+	uint32_t	firstIdx;
+} _tess_t;
+
+static inline bool _above (const vec2* p, uint32_t a, uint32_t b) {
+	return p[a].y > p[b].y || (p[a].y == p[b].y && p[a].x < p[b].x);
+}
+static inline float _orient (vec2 a, vec2 b, vec2 c) {
+	return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+//p is colinear with a and b
+static inline bool _on_segment (vec2 a, vec2 b, vec2 p) {
+	return fminf (a.x, b.x) <= p.x && p.x <= fmaxf (a.x, b.x) && fminf (a.y, b.y) <= p.y && p.y <= fmaxf (a.y, b.y);
+}
+//true if segments ab and cd cross or touch
+static bool _segments_intersect (vec2 a, vec2 b, vec2 c, vec2 d) {
+	float o1 = _orient (a, b, c), o2 = _orient (a, b, d), o3 = _orient (c, d, a), o4 = _orient (c, d, b);
+	if (((o1 > 0 && o2 < 0) || (o1 < 0 && o2 > 0)) && ((o3 > 0 && o4 < 0) || (o3 < 0 && o4 > 0)))
+		return true;
+	return (o1 == 0 && _on_segment (a, b, c)) || (o2 == 0 && _on_segment (a, b, d)) ||
+		   (o3 == 0 && _on_segment (c, d, a)) || (o4 == 0 && _on_segment (c, d, b));
+}
+//quadratic check, callers only submit contours up to the stencil fill threshold (VKVG_NZ_STENCIL_THRESHOLD).
+static bool _is_simple (_tess_t* t) {
+	uint32_t n = t->n;
+	vec2* p = t->pts;
+	for (uint32_t i = 0; i < n; i++) {
+		vec2 a = p[i], b = p[(i + 1) % n], c = p[(i + 2) % n];
+		//edge folding back on the previous one
+		if (_orient (a, b, c) == 0 && (b.x - a.x) * (c.x - b.x) + (b.y - a.y) * (c.y - b.y) < 0)
+			return false;
+		for (uint32_t j = i + 2; j < n; j++) {
+			if (i == 0 && j == n - 1)
+				continue;
+			if (_segments_intersect (a, b, p[j], p[(j + 1) % n]))
+				return false;
+		}
+	}
+	return true;
+}
+static void _sort_vertices (_tess_t* t) {
+	uint32_t n = t->n;
+	uint32_t *a = t->order, *b = t->tmp;
+	for (uint32_t i = 0; i < n; i++)
+		a[i] = i;
+	for (uint32_t w = 1; w < n; w *= 2) {
+		for (uint32_t lo = 0; lo < n; lo += 2 * w) {
+			uint32_t mid = MIN(lo + w, n), hi = MIN(lo + 2 * w, n);
+			uint32_t i = lo, j = mid, k = lo;
+			while (i < mid && j < hi)
+				b[k++] = _above (t->pts, a[j], a[i]) ? a[j++] : a[i++];
+			while (i < mid)
+				b[k++] = a[i++];
+			while (j < hi)
+				b[k++] = a[j++];
+		}
+		uint32_t* tmp = a;
+		a = b;
+		b = tmp;
+	}
+	if (a != t->order)
+		memcpy (t->order, a, n * sizeof(uint32_t));
+}
+static void _classify_vertices (_tess_t* t) {
+	uint32_t n = t->n;
+	for (uint32_t i = 0; i < n; i++) {
+		uint32_t prev = (i + n - 1) % n, next = (i + 1) % n;
+		bool prevBelow = _above (t->pts, i, prev), nextBelow = _above (t->pts, i, next);
+		bool convex = _orient (t->pts[prev], t->pts[i], t->pts[next]) > 0;
+		if (prevBelow && nextBelow)
+			t->types[i] = convex ? TESS_VX_START : TESS_VX_SPLIT;
+		else if (!prevBelow && !nextBelow)
+			t->types[i] = convex ? TESS_VX_END : TESS_VX_MERGE;
+		else
+			t->types[i] = TESS_VX_REGULAR;
+	}
+}
+static void _insert_edge (_tess_t* t, uint32_t e, uint32_t helper) {
+	t->active[t->activeCount++] = e;
+	t->helpers[e] = helper;
+}
+static void _remove_edge (_tess_t* t, uint32_t e) {
+	for (uint32_t i = 0; i < t->activeCount; i++) {
+		if (t->active[i] == e) {
+			t->active[i] = t->active[--t->activeCount];
+			return;
+		}
+	}
+}
+//active edge directly on the left of v
+static uint32_t _left_edge (_tess_t* t, uint32_t v) {
+	vec2 pv = t->pts[v];
+	uint32_t best = TESS_NONE;
+	float bestX = -FLT_MAX;
+	for (uint32_t i = 0; i < t->activeCount; i++) {
+		uint32_t e = t->active[i];
+		vec2 a = t->pts[e], b = t->pts[(e + 1) % t->n];
+		float x = a.y == b.y ? a.x : a.x + (pv.y - a.y) * (b.x - a.x) / (b.y - a.y);
+		if (x < pv.x && x >= bestX) {
+			best = e;
+			bestX = x;
+		}
+	}
+	return best;
+}
+//connect v to the helper of edge e if it is a merge vertex
+static bool _fix_up (_tess_t* t, uint32_t v, uint32_t e) {
+	if (e == TESS_NONE)
+		return false;
+	uint32_t h = t->helpers[e];
+	if (h == TESS_NONE || t->types[h] != TESS_VX_MERGE)
+		return true;
+	if (t->diagCount == t->n)
+		return false;
+	t->diags[t->diagCount * 2] = v;
+	t->diags[t->diagCount * 2 + 1] = h;
+	t->diagCount++;
+	return true;
+}
+static bool _add_diagonal (_tess_t* t, uint32_t u, uint32_t v) {
+	if (v == TESS_NONE || t->diagCount == t->n)
+		return false;
+	t->diags[t->diagCount * 2] = u;
+	t->diags[t->diagCount * 2 + 1] = v;
+	t->diagCount++;
+	return true;
+}
+static bool _make_monotone (_tess_t* t) {
+	uint32_t n = t->n;
+	for (uint32_t i = 0; i < n; i++)
+		t->helpers[i] = TESS_NONE;
+
+	for (uint32_t k = 0; k < n; k++) {
+		uint32_t v = t->order[k], prev = (v + n - 1) % n, e;
+		switch (t->types[v]) {
+		case TESS_VX_START:
+			_insert_edge (t, v, v);
+			break;
+		case TESS_VX_END:
+			if (!_fix_up (t, v, prev))
+				return false;
+			_remove_edge (t, prev);
+			break;
+		case TESS_VX_SPLIT:
+			e = _left_edge (t, v);
+			if (e == TESS_NONE || !_add_diagonal (t, v, t->helpers[e]))
+				return false;
+			t->helpers[e] = v;
+			_insert_edge (t, v, v);
+			break;
+		case TESS_VX_MERGE:
+			if (!_fix_up (t, v, prev))
+				return false;
+			_remove_edge (t, prev);
+			e = _left_edge (t, v);
+			if (!_fix_up (t, v, e))
+				return false;
+			t->helpers[e] = v;
+			break;
+		default:
+			if (_above (t->pts, prev, v)) {//descending left chain, polygon interior on the right
+				if (!_fix_up (t, v, prev))
+					return false;
+				_remove_edge (t, prev);
+				_insert_edge (t, v, v);
+			} else {
+				e = _left_edge (t, v);
+				if (!_fix_up (t, v, e))
+					return false;
+				t->helpers[e] = v;
+			}
+			break;
+		}
+	}
+	return true;
+}
+//neighbours of each point with the outgoing half edge index
+static void _build_adjacency (_tess_t* t) {
+	uint32_t n = t->n;
+	uint32_t* cursor = t->tmp;
+	for (uint32_t i = 0; i < n; i++)
+		cursor[i] = 2;
+	for (uint32_t d = 0; d < t->diagCount * 2; d++)
+		cursor[t->diags[d]]++;
+	t->adjStart[0] = 0;
+	for (uint32_t i = 0; i < n; i++) {
+		t->adjStart[i + 1] = t->adjStart[i] + cursor[i];
+		cursor[i] = t->adjStart[i];
+	}
+	for (uint32_t i = 0; i < n; i++) {
+		uint32_t next = (i + 1) % n;
+		t->adj[cursor[i] * 2] = next;
+		t->adj[cursor[i]++ * 2 + 1] = i;
+		t->adj[cursor[next] * 2] = i;
+		t->adj[cursor[next]++ * 2 + 1] = TESS_NONE;
+	}
+	for (uint32_t d = 0; d < t->diagCount; d++) {
+		uint32_t u = t->diags[d * 2], v = t->diags[d * 2 + 1];
+		t->adj[cursor[u] * 2] = v;
+		t->adj[cursor[u]++ * 2 + 1] = n + d * 2;
+		t->adj[cursor[v] * 2] = u;
+		t->adj[cursor[v]++ * 2 + 1] = n + d * 2 + 1;
+	}
+	memset (t->used, 0, n + t->diagCount * 2);
+}
+//the half edge following u->v in the face on its left leaves v toward the first neighbour clockwise from u.
+static uint32_t _next_half_edge (_tess_t* t, uint32_t u, uint32_t v, uint32_t* w) {
+	vec2 pv = t->pts[v];
+	float a0 = atan2f (t->pts[u].y - pv.y, t->pts[u].x - pv.x);
+	float best = FLT_MAX;
+	uint32_t he = TESS_NONE;
+	for (uint32_t k = t->adjStart[v]; k < t->adjStart[v + 1]; k++) {
+		uint32_t nb = t->adj[k * 2];
+		if (nb == u)
+			continue;
+		float d = a0 - atan2f (t->pts[nb].y - pv.y, t->pts[nb].x - pv.x);
+		if (d <= 0)
+			d += 2.f * M_PIF;
+		if (d < best) {
+			best = d;
+			he = t->adj[k * 2 + 1];
+			*w = nb;
+		}
+	}
+	return he;
+}
+static inline bool _emit_triangle (_tess_t* t, uint32_t a, uint32_t b, uint32_t c) {
+	if (t->indCount + 3 > t->maxIndCount)
+		return false;
+	t->indices[t->indCount++] = t->firstIdx + t->src[a];
+	t->indices[t->indCount++] = t->firstIdx + t->src[b];
+	t->indices[t->indCount++] = t->firstIdx + t->src[c];
+	return true;
+}
+//diagonal from v to s lies inside the piece if the chain is convex in 'last'
+static inline bool _diagonal_inside (_tess_t* t, uint8_t side, uint32_t v, uint32_t last, uint32_t s) {
+	if (side == 0)
+		return _orient (t->pts[s], t->pts[last], t->pts[v]) > 0;
+	return _orient (t->pts[v], t->pts[last], t->pts[s]) > 0;
+}
+static bool _triangulate_monotone (_tess_t* t, uint32_t m) {
+	uint32_t* f = t->face;
+	if (m < 3)
+		return true;
+	if (m == 3)
+		return _emit_triangle (t, f[0], f[1], f[2]);
+
+	uint32_t top = 0, bot = 0;
+	for (uint32_t i = 1; i < m; i++) {
+		if (_above (t->pts, f[i], f[top]))
+			top = i;
+		if (_above (t->pts, f[bot], f[i]))
+			bot = i;
+	}
+	//merge left chain, counter clockwise from top, with right chain
+	uint32_t l = (top + 1) % m, r = (top + m - 1) % m, k = 0;
+	t->sorted[k] = f[top];
+	t->side[k++] = 0;
+	while (l != bot || r != bot) {
+		if (k == m - 1)
+			return false;
+		if (r == bot || (l != bot && _above (t->pts, f[l], f[r]))) {
+			t->sorted[k] = f[l];
+			t->side[k++] = 0;
+			l = (l + 1) % m;
+		} else {
+			t->sorted[k] = f[r];
+			t->side[k++] = 1;
+			r = (r + m - 1) % m;
+		}
+	}
+	t->sorted[k] = f[bot];
+	t->side[k++] = 0;
+	if (k != m)
+		return false;
+
+	uint32_t* stack = t->stack;
+	uint32_t* u = t->sorted;
+	uint32_t sp = 0;
+	stack[sp++] = 0;
+	stack[sp++] = 1;
+	for (uint32_t j = 2; j < m - 1; j++) {
+		if (t->side[j] != t->side[stack[sp - 1]]) {
+			for (uint32_t s = 0; s + 1 < sp; s++) {
+				if (!_emit_triangle (t, u[j], u[stack[s]], u[stack[s + 1]]))
+					return false;
+			}
+			sp = 0;
+			stack[sp++] = j - 1;
+			stack[sp++] = j;
+		} else {
+			uint32_t last = stack[--sp];
+			while (sp > 0 && _diagonal_inside (t, t->side[j], u[j], u[last], u[stack[sp - 1]])) {
+				if (!_emit_triangle (t, u[j], u[last], u[stack[sp - 1]]))
+					return false;
+				last = stack[--sp];
+			}
+			stack[sp++] = last;
+			stack[sp++] = j;
+		}
+	}
+	for (uint32_t s = 0; s + 1 < sp; s++) {
+		if (!_emit_triangle (t, u[m - 1], u[stack[s]], u[stack[s + 1]]))
+			return false;
+	}
+	return true;
+}
+//walk the faces on the left of polygon edges and diagonals, each one is a monotone piece
+static bool _triangulate_pieces (_tess_t* t) {
+	uint32_t n = t->n;
+	uint32_t halfEdgeCount = n + t->diagCount * 2;
+	for (uint32_t h = 0; h < halfEdgeCount; h++) {
+		if (t->used[h])
+			continue;
+		uint32_t u, v;
+		if (h < n) {
+			u = h;
+			v = (h + 1) % n;
+		} else {
+			uint32_t d = (h - n) / 2, dir = (h - n) % 2;
+			u = t->diags[d * 2 + dir];
+			v = t->diags[d * 2 + 1 - dir];
+		}
+		uint32_t m = 0, he = h;
+		do {
+			if (m == n || he == TESS_NONE || t->used[he])
+				return false;
+			t->used[he] = 1;
+			t->face[m++] = u;
+			uint32_t w = TESS_NONE;
+			he = _next_half_edge (t, u, v, &w);
+			u = v;
+			v = w;
+		} while (he != h);
+		if (!_triangulate_monotone (t, m))
+			return false;
+	}
+	return true;
+}
+//carve the tessellator arrays from the arena, growing it if needed
+static bool _tess_init (_tess_t* t, tess_arena_t* arena, uint32_t count) {
+	size_t n = count;
+	size_t size = n * sizeof(vec2) + (n * 20 + 1) * sizeof(uint32_t) + n * 4;
+	if (!tess_arena_reserve (arena, size))
+		return false;
+	t->pts		= (vec2*)arena->mem;
+	t->src		= (uint32_t*)(t->pts + n);
+	t->order	= t->src + n;
+	t->tmp		= t->order + n;
+	t->types	= t->tmp + n;
+	t->active	= t->types + n;
+	t->helpers	= t->active + n;
+	t->diags	= t->helpers + n;
+	t->adjStart	= t->diags + n * 2;
+	t->adj		= t->adjStart + n + 1;
+	t->face		= t->adj + n * 8;
+	t->sorted	= t->face + n;
+	t->stack	= t->sorted + n;
+	t->used		= (uint8_t*)(t->stack + n);
+	t->side		= t->used + n * 3;
+	return true;
+}
+
+bool tess_monotone (tess_arena_t* arena, const vec2* pts, uint32_t count, uint32_t firstIdx, uint32_t* indices, uint32_t* indCount) {
+	*indCount = 0;
+	if (count < 3)
+		return true;
+
+	_tess_t t = {0};
+	if (!_tess_init (&t, arena, count))
+		return false;
+
+	//copy distinct points with the y axis going up
+	for (uint32_t i = 0; i < count; i++) {
+		vec2 p = {pts[i].x, -pts[i].y};
+		if (t.n > 0 && vec2_equ (p, t.pts[t.n - 1]))
+			continue;
+		t.pts[t.n] = p;
+		t.src[t.n++] = i;
+	}
+	while (t.n > 1 && vec2_equ (t.pts[0], t.pts[t.n - 1]))
+		t.n--;
+	if (t.n < 3)
+		return true;
+
+	float area = 0;
+	for (uint32_t i = 0, j = t.n - 1; i < t.n; j = i++)
+		area += t.pts[j].x * t.pts[i].y - t.pts[i].x * t.pts[j].y;
+	if (area == 0)
+		return true;
+	if (area < 0) {//make counter clockwise
+		for (uint32_t i = 0, j = t.n - 1; i < j; i++, j--) {
+			vec2 p = t.pts[i];
+			t.pts[i] = t.pts[j];
+			t.pts[j] = p;
+			uint32_t s = t.src[i];
+			t.src[i] = t.src[j];
+			t.src[j] = s;
+		}
+	}
+
+	if (!_is_simple (&t))
+		return false;
+
+	t.indices		= indices;
+	t.maxIndCount	= (count - 2) * 3;
+	t.firstIdx		= firstIdx;
+
+	_classify_vertices (&t);
+	_sort_vertices (&t);
+	if (!_make_monotone (&t))
+		return false;
+	_build_adjacency (&t);
+	if (!_triangulate_pieces (&t))
+		return false;
+
+	*indCount = t.indCount;
+	return true;
+}
+bool tess_arena_reserve (tess_arena_t* arena, size_t size) {
+	if (arena->size >= size)
+		return true;
+	void* mem = realloc (arena->mem, size);
+	if (!mem)
+		return false;
+	arena->mem = mem;
+	arena->size = size;
+	return true;
+}
+void tess_arena_free (tess_arena_t* arena) {
+	free (arena->mem);
+	arena->mem = NULL;
+	arena->size = 0;
+}
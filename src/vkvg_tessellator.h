@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2018-2022 Jean-Philippe Bruyère <jp_bruyere@hotmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+ * Software, and to permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef VKVG_TESSELLATOR_H
+#define VKVG_TESSELLATOR_H
+
+#include <stdlib.h>
+#include "vectors.h"
+
+//scratch memory of the tessellator, kept by contexts so that successive fills don't allocate.
+typedef struct {
+	void*		mem;
+	size_t		size;
+} tess_arena_t;
+
+//Triangulate a simple polygon by splitting it in y-monotone pieces with a sweep line, then triangulating each piece.
+//Repeated consecutive points are skipped. Indices of the triangles, offset by firstIdx, are written to 'indices' that
+//has to hold (count - 2) * 3 values, the count written is returned in indCount.
+//Returns false if the polygon is self intersecting, content of 'indices' is then undefined. The simplicity check is
+//quadratic and the active edges are searched linearly, this is meant for small contours.
+bool tess_monotone		(tess_arena_t* arena, const vec2* pts, uint32_t count, uint32_t firstIdx, uint32_t* indices, uint32_t* indCount);
+
+//Triangulate pathes made of several contours with the ear clipping of the earcut library (github.com/mapbox/earcut).
+//Contours are given between begin and end as ranges of the 'pts' array. Resolve splits contours crossing each other
+//or themselves at their intersections and keeps the edges bounding the area filled with the non-zero rule. Vertices
+//of the triangulation are then the source points followed by the 'intersections', valid until end. Contours are
+//classified as outer boundaries or holes, holes are bridged to their outer contour, then ears are clipped with a
+//z-order hash of the vertices for large polygons. 'indices' has to hold the 'maxIndCount' values given by resolve.
+bool tess_earcut_begin	(tess_arena_t* arena, const vec2* pts, uint32_t pointCount, uint32_t contourCount);
+void tess_earcut_contour(tess_arena_t* arena, uint32_t first, uint32_t count);
+bool tess_earcut_resolve(tess_arena_t* arena, const vec2** intersections, uint32_t* intersectionCount, uint32_t* maxIndCount);
+bool tess_earcut_end	(tess_arena_t* arena, uint32_t firstIdx, uint32_t* indices, uint32_t* indCount);
+//After resolve, contour 'i' as a ring of the boundary of the area filled with the non-zero rule: 'count' is zero if
+//the contour doesn't bound this area, 'perpFilled' is true if the area lies on the vec2_perp side of the ring.
+//Returns false past the last contour.
+bool tess_earcut_boundary(tess_arena_t* arena, uint32_t i, const vec2** pts, uint32_t* count, bool* perpFilled);
+
+//grow arena memory to at least 'size' bytes, previous content is kept.
+bool tess_arena_reserve	(tess_arena_t* arena, size_t size);
+void tess_arena_free	(tess_arena_t* arena);
+
+#endif
@@ -0,0 +1,96 @@
+#include "test.h"
+
+static vkvg_antialias_t antialias = VKVG_ANTIALIAS_FRINGE;
+
+void fills(){
+	VkvgContext ctx = vkvg_create(surf);
+	vkvg_set_antialias(ctx, antialias);
+	vkvg_set_source_rgba(ctx,0.9f,0.9f,0.9f,1);
+	vkvg_paint(ctx);
+
+	vkvg_set_source_rgba(ctx,0,0,0.8f,1);
+	vkvg_move_to(ctx,20,20);
+	vkvg_line_to(ctx,180,40);
+	vkvg_line_to(ctx,60,170);
+	vkvg_close_path(ctx);
+	vkvg_fill(ctx);
+
+	vkvg_set_fill_rule(ctx,VKVG_FILL_RULE_EVEN_ODD);
+	vkvg_set_source_rgba(ctx,0.8f,0,0,0.7f);
+	vkvg_rectangle(ctx,220,20,160,160);
+	vkvg_arc(ctx,300,100,50,0,M_PIF*2);
+	vkvg_fill(ctx);
+
+	vkvg_set_fill_rule(ctx,VKVG_FILL_RULE_NON_ZERO);
+	vkvg_rotate(ctx,0.3f);
+	vkvg_set_source_rgba(ctx,0,0.6f,0,1);
+	vkvg_fill_rectangle(ctx,450,20,100,60);
+
+	vkvg_destroy(ctx);
+}
+void strokes(){
+	VkvgContext ctx = vkvg_create(surf);
+	vkvg_set_antialias(ctx, antialias);
+	vkvg_set_source_rgba(ctx,0.9f,0.9f,0.9f,1);
+	vkvg_paint(ctx);
+
+	vkvg_set_source_rgba(ctx,0,0,0,1);
+	vkvg_set_line_width(ctx,12);
+
+	vkvg_line_join_t joins[] = {VKVG_LINE_JOIN_MITER, VKVG_LINE_JOIN_BEVEL, VKVG_LINE_JOIN_ROUND};
+	vkvg_line_cap_t caps[] = {VKVG_LINE_CAP_BUTT, VKVG_LINE_CAP_SQUARE, VKVG_LINE_CAP_ROUND};
+	for (int i=0; i<3; i++) {
+		vkvg_set_line_join(ctx,joins[i]);
+		vkvg_set_line_cap(ctx,caps[i]);
+		vkvg_move_to(ctx,30+i*150,150);
+		vkvg_rel_line_to(ctx,50,-110);
+		vkvg_rel_line_to(ctx,50,110);
+		vkvg_stroke(ctx);
+	}
+
+	vkvg_set_line_width(ctx,1);
+	vkvg_move_to(ctx,20,200);
+	vkvg_curve_to(ctx,150,120,300,320,450,200);
+	vkvg_stroke(ctx);
+
+	vkvg_destroy(ctx);
+}
+//fringes follow the outside of translucent strokes, not the outlines crossing the stroke body at self overlaps and
+//inner joins.
+void translucent_strokes(){
+	VkvgContext ctx = vkvg_create(surf);
+	vkvg_set_antialias(ctx, antialias);
+	vkvg_set_source_rgba(ctx,0.9f,0.9f,0.9f,1);
+	vkvg_paint(ctx);
+
+	vkvg_set_source_rgba(ctx,0,0,0.8f,0.5f);
+	vkvg_set_line_width(ctx,20);
+	vkvg_set_line_join(ctx,VKVG_LINE_JOIN_ROUND);
+	vkvg_move_to(ctx,100,30);
+	for (int i=1; i<5; i++)
+		vkvg_line_to(ctx,100+70*sinf(i*4*M_PIF/5),100-70*cosf(i*4*M_PIF/5));
+	vkvg_close_path(ctx);
+	vkvg_stroke(ctx);
+
+	vkvg_set_line_join(ctx,VKVG_LINE_JOIN_MITER);
+	vkvg_move_to(ctx,220,170);
+	for (int i=0; i<4; i++) {
+		vkvg_rel_line_to(ctx,20,-140);
+		vkvg_rel_line_to(ctx,20,140);
+	}
+	vkvg_stroke(ctx);
+
+	vkvg_destroy(ctx);
+}
+
+int main(int argc, char *argv[]) {
+	no_test_size = true;
+	PERFORM_TEST (fills, argc, argv);
+	PERFORM_TEST (strokes, argc, argv);
+	PERFORM_TEST (translucent_strokes, argc, argv);
+	antialias = VKVG_ANTIALIAS_DEFAULT;
+	PERFORM_TEST (fills, argc, argv);
+	PERFORM_TEST (strokes, argc, argv);
+	PERFORM_TEST (translucent_strokes, argc, argv);
+	return 0;
+}
@@ -14,8 +14,42 @@ void create_destroy_single(){
 	vkvg_destroy(ctx);
 }
 
+void retarget_multi(){
+	VkvgSurface* surfs = (VkvgSurface*)malloc(sizeof(VkvgSurface)*test_size);
+	for (uint32_t i = 0; i < test_size; i++)
+		surfs[i] = vkvg_surface_create (device, 512, 512);
+	VkvgContext ctx = vkvg_create(surfs[0]);
+	for (uint32_t i = 0; i < test_size; i++) {
+		vkvg_set_target (ctx, surfs[i]);
+		vkvg_set_source_rgb (ctx, 0, 0, 1);
+		vkvg_rectangle (ctx, 10, 10, 100, 100);
+		vkvg_fill (ctx);
+	}
+	vkvg_set_target (ctx, surf);
+	vkvg_destroy(ctx);
+	for (uint32_t i = 0; i < test_size; i++)
+		vkvg_surface_destroy(surfs[i]);
+	free(surfs);
+}
+
+void deferred_release_multi(){
+	vkvg_device_set_deferred_release (device, true);
+	for (uint32_t i = 0; i < test_size; i++) {
+		VkvgSurface s = vkvg_surface_create (device, 512, 512);
+		VkvgContext ctx = vkvg_create(s);
+		vkvg_surface_destroy (s);
+		vkvg_set_source_rgb (ctx, 0, 1, 0);
+		vkvg_paint (ctx);
+		vkvg_destroy(ctx);
+	}
+	vkvg_device_release_deferred (device, true);
+	vkvg_device_set_deferred_release (device, false);
+}
+
 int main(int argc, char *argv[]) {
 	PERFORM_TEST (create_destroy_multi, argc, argv);
+	PERFORM_TEST (retarget_multi, argc, argv);
+	PERFORM_TEST (deferred_release_multi, argc, argv);
 	no_test_size = true;
 	PERFORM_TEST (create_destroy_single, argc, argv);
 	return 0;
@@ -173,6 +173,25 @@ void long_curv_fill_stroke_eo () {
 	fill_rule = VKVG_FILL_RULE_EVEN_ODD;
 	_long_curv ();
 }
+void tolerances () {
+	VkvgContext ctx = vkvg_create(surf);
+	vkvg_set_line_width(ctx, 2);
+	vkvg_set_source_rgb (ctx, 0.1f,0.3f,0.7f);
+
+	float tols[] = {0.01f, 0.1f, 1.0f, 5.0f};
+	for (int i=0; i<4; i++) {
+		vkvg_save (ctx);
+		vkvg_set_tolerance (ctx, tols[i]);
+		vkvg_translate (ctx, 20 + i * 120, 20);
+		vkvg_scale (ctx, 0.5f + i * 0.5f, 0.5f + i * 0.5f);
+		vkvg_move_to (ctx, 0, 100);
+		vkvg_curve_to (ctx, 0, 0, 100, 200, 100, 100);
+		vkvg_arc (ctx, 50, 150, 40, 0, M_PIF);
+		vkvg_stroke (ctx);
+		vkvg_restore (ctx);
+	}
+	vkvg_destroy(ctx);
+}
 int main(int argc, char *argv[]) {
 	no_test_size = true;
 	PERFORM_TEST(test, argc, argv);
@@ -184,5 +203,6 @@ int main(int argc, char *argv[]) {
 	//PERFORM_TEST(long_curv_fill_stroke_nz, argc, argv);
 	PERFORM_TEST(long_curv_fill_stroke_eo, argc, argv);
 	PERFORM_TEST(random_curves_stroke, argc, argv);
+	PERFORM_TEST(tolerances, argc, argv);
 	return 0;
 }
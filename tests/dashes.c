@@ -1,10 +1,13 @@
 #include "test.h"
 
+static vkvg_stroke_mode_t strokeMode = VKVG_STROKE_MODE_TESSELLATED;
+
 void test(){
 	dash_offset += 0.2f;
 
 	VkvgContext ctx = vkvg_create(surf);
 	vkvg_clear(ctx);
+	vkvg_set_stroke_mode(ctx, strokeMode);
 	vkvg_set_source_rgb(ctx, 1, 1, 1);
 	vkvg_paint(ctx);
 	//const float dashes[] = {160.0f, 80};
@@ -112,5 +115,7 @@ int main(int argc, char *argv[]) {
 	PERFORM_TEST(test, argc, argv);
 	PERFORM_TEST(path, argc, argv);
 	PERFORM_TEST(curve, argc, argv);
+	strokeMode = VKVG_STROKE_MODE_GPU;
+	PERFORM_TEST(test, argc, argv);
 	return 0;
 }
@@ -18,8 +18,140 @@ void test(){
 	vkvg_destroy(ctx);
 }
 
+void copy_path(){
+	VkvgContext ctx = _initCtx(surf);
+
+	vkvg_move_to(ctx,20,20);
+	vkvg_curve_to(ctx,80,0,120,60,60,100);
+	vkvg_line_to(ctx,10,70);
+	vkvg_close_path(ctx);
+	vkvg_new_sub_path(ctx);
+	vkvg_arc(ctx,60,50,15,0,M_PIF*2);
+	VkvgPath path = vkvg_copy_path(ctx);
+	vkvg_new_path(ctx);
+
+	vkvg_set_fill_rule(ctx,VKVG_FILL_RULE_EVEN_ODD);
+	for (int i=0; i<5; i++) {
+		for (int j=0; j<5; j++) {
+			vkvg_save(ctx);
+			vkvg_translate(ctx,i*120,j*110);
+			vkvg_set_source_rgba(ctx,0.2f*i,0.2f*j,0.8f,1.0f);
+			vkvg_append_path(ctx,path);
+			vkvg_fill_preserve(ctx);
+			vkvg_set_source_rgba(ctx,0,0,0,1);
+			vkvg_stroke(ctx);
+			vkvg_restore(ctx);
+		}
+	}
+
+	vkvg_path_destroy(path);
+	vkvg_destroy(ctx);
+}
+
+//concave star filled and stroked at several places, triangles are computed once per fill rule and stroke scale.
+void tessellation_cache(){
+	vkvg_device_set_tessellation_cache_size(device, 1 << 20);
+	VkvgContext ctx = _initCtx(surf);
+
+	vkvg_set_line_width(ctx,4);
+	vkvg_set_line_join(ctx,VKVG_LINE_JOIN_ROUND);
+	for (int i=0; i<6; i++) {
+		for (int j=0; j<4; j++) {
+			vkvg_save(ctx);
+			vkvg_translate(ctx,20+i*100,20+j*100);
+			if (j == 3)
+				vkvg_scale(ctx,0.5f,0.5f);
+			vkvg_move_to(ctx,40,0);
+			for (int k=1; k<10; k++) {
+				float a = k * M_PIF / 5.f, r = k % 2 ? 15 : 40;
+				vkvg_line_to(ctx,40+r*sinf(a),40-r*cosf(a));
+			}
+			vkvg_close_path(ctx);
+			vkvg_set_fill_rule(ctx,j%2 ? VKVG_FILL_RULE_NON_ZERO : VKVG_FILL_RULE_EVEN_ODD);
+			vkvg_set_source_rgba(ctx,0.15f*i,0.3f*j,0.8f,1.0f);
+			vkvg_fill_preserve(ctx);
+			vkvg_set_source_rgba(ctx,0,0,0,1);
+			vkvg_stroke(ctx);
+			vkvg_restore(ctx);
+		}
+	}
+
+	vkvg_destroy(ctx);
+}
+
+//single contours up to 64 points are split in monotone pieces: combs have split vertices on one side and merge vertices
+//on the other, colinear points lie on horizontal and vertical edges.
+void monotone(){
+	VkvgContext ctx = _initCtx(surf);
+	vkvg_set_source_rgba(ctx,0.1f,0.3f,0.9f,0.5f);
+
+	//merge vertices at the bottom of the teeth
+	vkvg_move_to(ctx,20,20);
+	for (int i=0; i<5; i++) {
+		vkvg_line_to(ctx,40+i*40,80);
+		vkvg_line_to(ctx,60+i*40,20);
+	}
+	vkvg_line_to(ctx,220,120);
+	vkvg_line_to(ctx,20,120);
+	vkvg_close_path(ctx);
+	vkvg_fill(ctx);
+	//split vertices at the top of the teeth
+	vkvg_move_to(ctx,260,20);
+	vkvg_line_to(ctx,460,20);
+	for (int i=5; i>0; i--) {
+		vkvg_line_to(ctx,240+i*40,60);
+		vkvg_line_to(ctx,220+i*40,120);
+	}
+	vkvg_close_path(ctx);
+	vkvg_fill(ctx);
+	//concave U and star
+	vkvg_move_to(ctx,20,160);
+	vkvg_line_to(ctx,120,160);
+	vkvg_line_to(ctx,120,260);
+	vkvg_line_to(ctx,80,260);
+	vkvg_line_to(ctx,80,200);
+	vkvg_line_to(ctx,60,200);
+	vkvg_line_to(ctx,60,260);
+	vkvg_line_to(ctx,20,260);
+	vkvg_close_path(ctx);
+	vkvg_fill(ctx);
+	vkvg_move_to(ctx,300,160);
+	for (int i=1; i<10; i++) {
+		float r = i % 2 ? 20 : 50;
+		vkvg_line_to(ctx,300+r*sinf(i*M_PIF/5),210-r*cosf(i*M_PIF/5));
+	}
+	vkvg_close_path(ctx);
+	vkvg_fill(ctx);
+	//colinear points on a square and on a concave contour
+	vkvg_move_to(ctx,20,300);
+	vkvg_line_to(ctx,70,300);
+	vkvg_line_to(ctx,120,300);
+	vkvg_line_to(ctx,120,350);
+	vkvg_line_to(ctx,120,400);
+	vkvg_line_to(ctx,70,400);
+	vkvg_line_to(ctx,20,400);
+	vkvg_line_to(ctx,20,350);
+	vkvg_close_path(ctx);
+	vkvg_fill(ctx);
+	vkvg_move_to(ctx,160,300);
+	vkvg_line_to(ctx,260,300);
+	vkvg_line_to(ctx,260,400);
+	vkvg_line_to(ctx,210,400);
+	vkvg_line_to(ctx,210,350);
+	vkvg_line_to(ctx,210,320);
+	vkvg_line_to(ctx,185,320);
+	vkvg_line_to(ctx,160,320);
+	vkvg_close_path(ctx);
+	vkvg_fill(ctx);
+
+	vkvg_destroy(ctx);
+}
+
 int main(int argc, char *argv[]) {
 	no_test_size = true;
 	PERFORM_TEST (test, argc, argv);
+	PERFORM_TEST (copy_path, argc, argv);
+	PERFORM_TEST (tessellation_cache, argc, argv);
+	PERFORM_TEST (monotone, argc, argv);
 	return 0;
 }
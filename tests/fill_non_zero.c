@@ -24,8 +24,160 @@ void test(){
 	vkvg_destroy(ctx);
 }
 
+//n squares drawn in the same direction, the center is covered n times
+static void overlapping_squares (VkvgContext ctx, float x, float y, int n) {
+	for (int i=0; i<n; i++) {
+		vkvg_rectangle(ctx,x+i*4,y+i*4,60,60);
+	}
+}
+//closed spiral making 'turns' turns from radius r0 to r1, its center is wound 'turns' times
+static void spiral (VkvgContext ctx, float x, float y, float r0, float r1, int turns) {
+	int n = turns * 50;
+	vkvg_move_to(ctx, x + r0, y);
+	for (int i=1; i<n; i++) {
+		float t = (float)i / (n - 1);
+		float a = 2.f * M_PIF * turns * t;
+		float r = r0 + (r1 - r0) * t;
+		vkvg_line_to(ctx, x + r * cosf(a), y + r * sinf(a));
+	}
+	vkvg_close_path(ctx);
+}
+//windings up to 9 of same direction contours, stencil counter must not wrap to an unfilled value.
+void windings(){
+	VkvgContext ctx = vkvg_create(surf);
+	vkvg_clear(ctx);
+	vkvg_set_fill_rule(ctx, VKVG_FILL_RULE_NON_ZERO);
+	vkvg_set_source_rgba(ctx,0.1f,0.9f,0.1f,1.0f);
+
+	for (int n=1; n<10; n++) {
+		overlapping_squares (ctx, 20 + (n-1) * 100, 20, n);
+		vkvg_fill(ctx);
+	}
+	//a single contour winding 8 times, then 4 contours winding twice
+	spiral (ctx, 400, 250, 100, 60, 8);
+	vkvg_fill(ctx);
+	for (int i=0; i<4; i++)
+		spiral (ctx, 620 + i * 20, 250, 90, 60, 2);
+	vkvg_fill(ctx);
+	//opposite directions cancel
+	vkvg_set_source_rgba(ctx,0.9f,0.1f,0.1f,1.0f);
+	vkvg_rectangle(ctx,20,150,200,200);
+	vkvg_move_to(ctx,70,200);
+	vkvg_rel_line_to(ctx,0,100);
+	vkvg_rel_line_to(ctx,100,0);
+	vkvg_rel_line_to(ctx,0,-100);
+	vkvg_close_path(ctx);
+	vkvg_fill(ctx);
+
+	vkvg_destroy(ctx);
+}
+void clip_windings(){
+	VkvgContext ctx = vkvg_create(surf);
+	vkvg_clear(ctx);
+	vkvg_set_fill_rule(ctx, VKVG_FILL_RULE_NON_ZERO);
+
+	for (int n=1; n<10; n++) {
+		vkvg_save(ctx);
+		overlapping_squares (ctx, 20 + (n-1) * 100, 20, n);
+		vkvg_clip(ctx);
+		vkvg_set_source_rgba(ctx,0.1f,0.1f,0.9f,1.0f);
+		vkvg_paint(ctx);
+		vkvg_restore(ctx);
+	}
+
+	vkvg_destroy(ctx);
+}
+//8 contours may wind 8 times, such paths are triangulated instead of stenciled: contours crossing each other are split at their
+//intersections. Translucent fills show areas drawn twice.
+static void circle (VkvgContext ctx, float x, float y, float r, bool negative) {
+	vkvg_new_sub_path(ctx);
+	if (negative)
+		vkvg_arc_negative(ctx, x, y, r, 0, -M_PIF*2);
+	else
+		vkvg_arc(ctx, x, y, r, 0, M_PIF*2);
+}
+void crossing_contours(){
+	VkvgContext ctx = vkvg_create(surf);
+	vkvg_clear(ctx);
+	vkvg_set_fill_rule(ctx, VKVG_FILL_RULE_NON_ZERO);
+	vkvg_set_source_rgba(ctx,0.1f,0.3f,0.9f,0.5f);
+
+	//nested, same direction then alternated
+	for (int i=0; i<8; i++)
+		circle (ctx, 120, 120, 100 - i * 10, false);
+	vkvg_fill(ctx);
+	for (int i=0; i<8; i++)
+		circle (ctx, 340, 120, 100 - i * 10, i % 2);
+	vkvg_fill(ctx);
+	//overlapping, same direction then alternated
+	for (int i=0; i<8; i++)
+		circle (ctx, 120 + 50 * cosf(i * M_PIF / 4), 360 + 50 * sinf(i * M_PIF / 4), 60, false);
+	vkvg_fill(ctx);
+	for (int i=0; i<8; i++)
+		circle (ctx, 340 + 50 * cosf(i * M_PIF / 4), 360 + 50 * sinf(i * M_PIF / 4), 60, i % 2);
+	vkvg_fill(ctx);
+
+	//single self intersecting contour
+	vkvg_move_to(ctx,560,40);
+	for (int i=1; i<5; i++)
+		vkvg_line_to(ctx, 560 + 100 * sinf(i * 4 * M_PIF / 5), 140 - 100 * cosf(i * 4 * M_PIF / 5));
+	vkvg_close_path(ctx);
+	vkvg_fill(ctx);
+
+	vkvg_destroy(ctx);
+}
+
+//vertices lying exactly on another edge split it without adding intersections, fills must not lose any part.
+void vertices_on_edges(){
+	VkvgContext ctx = vkvg_create(surf);
+	vkvg_clear(ctx);
+	vkvg_set_fill_rule(ctx, VKVG_FILL_RULE_NON_ZERO);
+	vkvg_set_source_rgba(ctx,0.1f,0.3f,0.9f,0.5f);
+
+	//(48,77) lies on the closing edge (41,84)-(82,43)
+	vkvg_scale(ctx,2,2);
+	vkvg_move_to(ctx,82,43);
+	vkvg_line_to(ctx,94,38);
+	vkvg_line_to(ctx,76,99);
+	vkvg_line_to(ctx,5,59);
+	vkvg_line_to(ctx,48,77);
+	vkvg_line_to(ctx,41,84);
+	vkvg_close_path(ctx);
+	vkvg_fill(ctx);
+	vkvg_identity_matrix(ctx);
+
+	//T junctions: a triangle with its base on a side of a square, outside then inside
+	vkvg_rectangle(ctx,250,20,100,100);
+	vkvg_move_to(ctx,350,50);
+	vkvg_line_to(ctx,410,70);
+	vkvg_line_to(ctx,350,90);
+	vkvg_close_path(ctx);
+	vkvg_fill(ctx);
+	vkvg_rectangle(ctx,250,150,100,100);
+	vkvg_move_to(ctx,350,180);
+	vkvg_line_to(ctx,290,200);
+	vkvg_line_to(ctx,350,220);
+	vkvg_close_path(ctx);
+	vkvg_fill(ctx);
+
+	//single contour whose vertex touches one of its edges
+	vkvg_move_to(ctx,450,20);
+	vkvg_line_to(ctx,600,20);
+	vkvg_line_to(ctx,600,120);
+	vkvg_line_to(ctx,525,20);
+	vkvg_line_to(ctx,450,120);
+	vkvg_close_path(ctx);
+	vkvg_fill(ctx);
+
+	vkvg_destroy(ctx);
+}
+
 int main(int argc, char *argv[]) {
 	no_test_size = true;
 	PERFORM_TEST (test, argc, argv);
+	PERFORM_TEST (windings, argc, argv);
+	PERFORM_TEST (clip_windings, argc, argv);
+	PERFORM_TEST (crossing_contours, argc, argv);
+	PERFORM_TEST (vertices_on_edges, argc, argv);
 	return 0;
 }
@@ -1,5 +1,7 @@
 #include "test.h"
 
+static vkvg_stroke_mode_t strokeMode = VKVG_STROKE_MODE_TESSELLATED;
+
 void test(){
 	VkvgContext ctx = vkvg_create(surf);
 
@@ -124,6 +126,7 @@ void test2() {
 
 void test3() {
 	VkvgContext ctx = vkvg_create(surf);
+	vkvg_set_stroke_mode(ctx, strokeMode);
 
 	vkvg_set_fill_rule(ctx, VKVG_FILL_RULE_EVEN_ODD);
 	vkvg_set_line_width(ctx, 30);
@@ -178,5 +181,7 @@ int main(int argc, char *argv[]) {
 	PERFORM_TEST(test, argc, argv);
 	PERFORM_TEST(test2, argc, argv);
 	PERFORM_TEST(test3, argc, argv);
+	strokeMode = VKVG_STROKE_MODE_GPU;
+	PERFORM_TEST(test3, argc, argv);
 	return 0;
 }
@@ -96,6 +96,42 @@ void multi_segments() {
     vkvg_destroy(ctx);
 }
 
+void hairlines() {
+	VkvgContext ctx = vkvg_create(surf);
+	vkvg_set_source_rgb(ctx, 1, 1, 1);
+	vkvg_paint(ctx);
+	vkvg_set_source_rgb(ctx, 0, 0, 0);
+
+	float widths[] = {0.1f, 0.25f, 0.5f, 1.0f};
+	for (uint32_t i=0; i<4; i++) {
+		vkvg_set_line_width (ctx, widths[i]);
+		for (float x = 10.5f; x < 200; x += 10) {
+			vkvg_move_to (ctx, x + i * 200, 10);
+			vkvg_line_to (ctx, x + i * 200, 200);
+		}
+		for (float y = 10.5f; y < 200; y += 10) {
+			vkvg_move_to (ctx, 10 + i * 200, y);
+			vkvg_line_to (ctx, 200 + i * 200, y);
+		}
+		vkvg_stroke (ctx);
+	}
+
+	vkvg_scale (ctx, 0.5f, 0.5f);
+	vkvg_set_line_width (ctx, 1);
+	vkvg_arc (ctx, 400, 800, 300, 0, M_PIF * 2);
+	vkvg_stroke (ctx);
+
+	//translucent hairline, and a thin stroke under a non uniform scale that is tessellated
+	vkvg_set_source_rgba (ctx, 0, 0, 1, 0.5f);
+	vkvg_arc (ctx, 1200, 800, 300, 0, M_PIF * 2);
+	vkvg_stroke (ctx);
+	vkvg_scale (ctx, 4, 1);
+	vkvg_arc (ctx, 250, 800, 50, 0, M_PIF * 2);
+	vkvg_stroke (ctx);
+
+	vkvg_destroy(ctx);
+}
+
 int main(int argc, char *argv[]) {
 	struct timeval currentTime;
 	gettimeofday(&currentTime, NULL);
@@ -107,5 +143,6 @@ int main(int argc, char *argv[]) {
 	PERFORM_TEST(horzAndVert, argc, argv);
     PERFORM_TEST(multilines, argc, argv);
     PERFORM_TEST(multi_segments, argc, argv);
+	PERFORM_TEST(hairlines, argc, argv);
     return 0;
 }
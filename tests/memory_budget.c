@@ -0,0 +1,52 @@
+#include "test.h"
+
+static VkvgSurface* evictables;
+static uint32_t evictablesCount;
+
+void evict (void* userData, VkvgDevice dev, vkvg_memory_category_t category, uint64_t requested) {
+	if (evictablesCount > 0)
+		vkvg_surface_destroy (evictables[--evictablesCount]);
+}
+
+void surfaces_under_budget(){
+	vkvg_memory_stats_t stats;
+	vkvg_device_get_memory_stats (device, &stats);
+
+	evictables = (VkvgSurface*)malloc(sizeof(VkvgSurface)*test_size);
+	evictablesCount = 0;
+
+	vkvg_device_set_memory_budget (device, stats.total + 4 * 512 * 512 * 4 * 4);
+	vkvg_device_set_memory_evict_callback (device, evict, NULL);
+
+	for (uint32_t i = 0; i < test_size; i++) {
+		VkvgSurface s = vkvg_surface_create (device, 512, 512);
+		if (vkvg_surface_status (s) == VKVG_STATUS_SUCCESS)
+			evictables[evictablesCount++] = s;
+	}
+
+	vkvg_device_get_memory_stats (device, &stats);
+	if (stats.total > stats.budget) {
+		fprintf (stderr, "memory budget exceeded: %llu > %llu\n", (unsigned long long)stats.total, (unsigned long long)stats.budget);
+		exit (EXIT_FAILURE);
+	}
+
+	//without eviction, a surface over budget is not created
+	vkvg_device_set_memory_evict_callback (device, NULL, NULL);
+	VkvgSurface s = vkvg_surface_create (device, 2048, 2048);
+	if (vkvg_surface_status (s) != VKVG_STATUS_NO_MEMORY) {
+		fprintf (stderr, "surface over memory budget created\n");
+		exit (EXIT_FAILURE);
+	}
+	vkvg_surface_destroy (s);
+
+	while (evictablesCount > 0)
+		vkvg_surface_destroy (evictables[--evictablesCount]);
+	free (evictables);
+
+	vkvg_device_set_memory_budget (device, 0);
+}
+
+int main(int argc, char *argv[]) {
+	PERFORM_TEST (surfaces_under_budget, argc, argv);
+	return 0;
+}
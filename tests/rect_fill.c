@@ -31,9 +31,57 @@ void test_evenodd(){
 
 	vkvg_destroy(ctx);
 }
+//rectangles are instanced, circles drawn with distance fields and other fills indexed. Each shape overlaps
+//the previous one, and has to stay over it whatever the batch it is drawn with.
+void instancing_order(){
+
+	VkvgContext ctx = vkvg_create(surf);
+	vkvg_clear(ctx);
+
+	for (int i=0; i<12; i++) {
+		float x = 40 + i * 45;
+		switch (i % 3) {
+		case 0:
+			vkvg_rectangle(ctx,x,100,80,80);
+			vkvg_set_source_rgba(ctx,0.9f,0.1f,0.1f,0.8f);
+			break;
+		case 1:
+			vkvg_arc(ctx,x+40,140,40,0,M_PIF*2);
+			vkvg_set_source_rgba(ctx,0.1f,0.9f,0.1f,0.8f);
+			break;
+		default:
+			vkvg_move_to(ctx,x,100);
+			vkvg_line_to(ctx,x+80,100);
+			vkvg_line_to(ctx,x+40,140);
+			vkvg_line_to(ctx,x+80,180);
+			vkvg_line_to(ctx,x,180);
+			vkvg_close_path(ctx);
+			vkvg_set_source_rgba(ctx,0.1f,0.1f,0.9f,0.8f);
+			break;
+		}
+		vkvg_fill(ctx);
+	}
+
+	//consecutive rectangles share a single instanced draw, interleaved with other batches
+	for (int i=0; i<12; i++) {
+		vkvg_set_source_rgba(ctx,0.1f*i,0.5f,1.0f-0.08f*i,0.7f);
+		vkvg_rectangle(ctx,40+i*45,250,80,80);
+		vkvg_fill(ctx);
+		vkvg_rectangle(ctx,60+i*45,270,40,40);
+		vkvg_fill(ctx);
+		if (i % 4 == 3) {
+			vkvg_set_source_rgba(ctx,1,1,1,0.5f);
+			vkvg_arc(ctx,40+i*45,290,30,0,M_PIF*2);
+			vkvg_fill(ctx);
+		}
+	}
+
+	vkvg_destroy(ctx);
+}
 int main(int argc, char *argv[]) {
 	no_test_size = true;
 	PERFORM_TEST (test, argc, argv);
 	PERFORM_TEST (test_evenodd, argc, argv);
+	PERFORM_TEST (instancing_order, argc, argv);
 	return 0;
 }
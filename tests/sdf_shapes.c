@@ -0,0 +1,65 @@
+#include "test.h"
+
+//circles, ellipses and rounded rectangles alone in their path are drawn with distance fields.
+void shapes (VkvgContext ctx, float lineWidth) {
+	vkvg_set_line_width (ctx, lineWidth);
+
+	vkvg_arc (ctx, 80, 80, 50, 0, M_PIF*2);
+	vkvg_set_source_rgba (ctx, 0.1f, 0.3f, 0.8f, 0.5f);
+	vkvg_fill_preserve (ctx);
+	vkvg_set_source_rgba (ctx, 0.9f, 0.9f, 0.9f, 0.7f);
+	vkvg_stroke (ctx);
+
+	//ellipse strokes are tessellated, the distance of the shader being only exact on the outline
+	vkvg_ellipse (ctx, 80, 30, 250, 80, 0);
+	vkvg_set_source_rgba (ctx, 0.1f, 0.8f, 0.3f, 0.5f);
+	vkvg_fill_preserve (ctx);
+	vkvg_set_source_rgba (ctx, 0.9f, 0.9f, 0.9f, 0.7f);
+	vkvg_stroke (ctx);
+
+	vkvg_rounded_rectangle (ctx, 360, 30, 160, 100, 20);
+	vkvg_set_source_rgba (ctx, 0.8f, 0.3f, 0.1f, 0.5f);
+	vkvg_fill_preserve (ctx);
+	vkvg_set_source_rgba (ctx, 0.9f, 0.9f, 0.9f, 0.7f);
+	vkvg_stroke (ctx);
+
+	vkvg_set_line_join (ctx, VKVG_LINE_JOIN_ROUND);
+	vkvg_rounded_rectangle (ctx, 560, 30, 100, 100, 0);
+	vkvg_set_source_rgba (ctx, 0.8f, 0.8f, 0.1f, 0.5f);
+	vkvg_fill_preserve (ctx);
+	vkvg_set_source_rgba (ctx, 0.9f, 0.9f, 0.9f, 0.7f);
+	vkvg_stroke (ctx);
+	vkvg_set_line_join (ctx, VKVG_LINE_JOIN_MITER);
+}
+void fill_and_stroke () {
+	VkvgContext ctx = vkvg_create (surf);
+	vkvg_clear (ctx);
+
+	shapes (ctx, 2);
+	vkvg_translate (ctx, 0, 150);
+	shapes (ctx, 10);
+	//thick strokes, close to the ellipse minor radius
+	vkvg_translate (ctx, 0, 150);
+	shapes (ctx, 40);
+
+	vkvg_destroy (ctx);
+}
+void transformed () {
+	VkvgContext ctx = vkvg_create (surf);
+	vkvg_clear (ctx);
+
+	vkvg_scale (ctx, 1.5f, 0.75f);
+	shapes (ctx, 6);
+	vkvg_translate (ctx, 0, 200);
+	vkvg_scale (ctx, 0.5f, 2.f);
+	shapes (ctx, 6);
+
+	vkvg_destroy (ctx);
+}
+
+int main(int argc, char *argv[]) {
+	no_test_size = true;
+	PERFORM_TEST (fill_and_stroke, argc, argv);
+	PERFORM_TEST (transformed, argc, argv);
+	return 0;
+}